@@ -0,0 +1,36 @@
+import QtQuick 2.15
+import QtQuick.Layouts 1.15
+import RomGauges 1.0
+
+// all six ros2_control gauges in one scene ( one QQuickWidget, one render pass )
+Item {
+    id: root
+    anchors.fill: parent
+
+    component Meter: RomGauge {
+        Layout.fillWidth: true
+        Layout.fillHeight: true
+
+        Text {
+            anchors.horizontalCenter: parent.horizontalCenter
+            y: parent.height / 2 + 40 - height / 2
+            color: "#ffffff"
+            font.pixelSize: Math.round(Math.min(parent.width, parent.height) * 0.45 * 0.30)
+            text: parent.valueText
+        }
+    }
+
+    GridLayout {
+        anchors.fill: parent
+        columns: 3
+        rowSpacing: 8
+        columnSpacing: 16
+
+        Meter { objectName: "cmdSpeedGauge";       maxSpeed: 100; labelScale: 100; valueDecimals: 3; caption: "Desired  Linear Velocity m/s" }
+        Meter { objectName: "cmdLeftRpmGauge";     maxSpeed: 70;  caption: "Left Wheel RPM" }
+        Meter { objectName: "cmdRightRpmGauge";    maxSpeed: 70;  caption: "Right Wheel RPM" }
+        Meter { objectName: "actualSpeedGauge";    maxSpeed: 100; labelScale: 100; valueDecimals: 3; caption: "Actual  Linear Velocity m/s" }
+        Meter { objectName: "actualLeftRpmGauge";  maxSpeed: 70;  caption: "Actual Left Wheel RPM" }
+        Meter { objectName: "actualRightRpmGauge"; maxSpeed: 70;  caption: "Actual Right Wheel RPM" }
+    }
+}
@@ -0,0 +1,14 @@
+import QtQuick 2.15
+import RomMaps 1.0
+
+// one map canvas per tab, layers are fed from MainWindow
+// drag to pan, wheel to zoom, double click to fit the map again
+Item {
+    id: root
+    anchors.fill: parent
+
+    RomMapView {
+        objectName: "mapView"
+        anchors.fill: parent
+    }
+}
@@ -0,0 +1,155 @@
+#include "ekf_session_state.hpp"
+
+#include <QtMath>
+#include <cmath>
+
+//================================================================================
+// 1. samples
+//================================================================================
+
+void rom_dynamics::communication::EkfSessionState::addEkf(double t_sec, const QPointF &position, double heading_deg,
+                                                          double xx_cov, double xy_cov, double yx_cov, double yy_cov, double yaw_cov)
+{
+    Sample sample;
+    sample.t = t_sec;
+    sample.x = position.x();
+    sample.y = position.y();
+    sample.heading = heading_deg;
+    sample.cov[0] = xx_cov;
+    sample.cov[1] = xy_cov;
+    sample.cov[2] = yx_cov;
+    sample.cov[3] = yy_cov;
+    sample.cov[4] = yaw_cov;
+    push(m_ekf, sample);
+}
+
+void rom_dynamics::communication::EkfSessionState::addOdom(double t_sec, const QPointF &position, double heading_deg)
+{
+    Sample sample;
+    sample.t = t_sec;
+    sample.x = position.x();
+    sample.y = position.y();
+    sample.heading = heading_deg;
+    push(m_odom, sample);
+}
+
+void rom_dynamics::communication::EkfSessionState::addImu(double t_sec, double heading_deg)
+{
+    Sample sample;
+    sample.t = t_sec;
+    sample.heading = heading_deg;
+    push(m_imu, sample);
+}
+
+void rom_dynamics::communication::EkfSessionState::push(Stream &stream, const Sample &sample)
+{
+    // stamps went back ( robot restart, replay seek ) : this stream starts over
+    if (!stream.isEmpty() && sample.t < stream.last().t)
+    {
+        stream.clear();
+        m_lastTick = -1.0;
+    }
+    stream.append(sample);
+
+    // keep two samples at least so there is always something to interpolate between
+    while (stream.size() > 2 && stream.first().t < sample.t - m_historySec) stream.removeFirst();
+}
+
+void rom_dynamics::communication::EkfSessionState::clear()
+{
+    m_ekf.clear();
+    m_odom.clear();
+    m_imu.clear();
+    m_lastTick = -1.0;
+}
+
+//================================================================================
+// 2. per frame snapshot
+//================================================================================
+
+bool rom_dynamics::communication::EkfSessionState::snapshot(EkfSnapshot &out)
+{
+    if (m_ekf.isEmpty()) return false;
+
+    const double newest = qMax(m_ekf.last().t,
+                               qMax(m_odom.isEmpty() ? m_ekf.last().t : m_odom.last().t,
+                                    m_imu.isEmpty() ? m_ekf.last().t : m_imu.last().t));
+
+    // common tick : the oldest "latest stamp" among the streams that are still live
+    double tick = m_ekf.last().t;
+    const bool odom_live = !m_odom.isEmpty() && m_odom.last().t >= newest - m_staleSec;
+    const bool imu_live = !m_imu.isEmpty() && m_imu.last().t >= newest - m_staleSec;
+    if (odom_live) tick = qMin(tick, m_odom.last().t);
+    if (imu_live) tick = qMin(tick, m_imu.last().t);
+
+    if (tick <= m_lastTick) return false;
+    m_lastTick = tick;
+
+    out.t_sec = tick;
+
+    const Sample &ekf = atOrBefore(m_ekf, tick);
+    const Sample ekf_at = interpolate(m_ekf, tick);
+    out.ekf_position = QPointF(ekf_at.x, ekf_at.y);
+    out.ekf_heading = ekf_at.heading;
+    out.xx_cov = ekf.cov[0];
+    out.xy_cov = ekf.cov[1];
+    out.yx_cov = ekf.cov[2];
+    out.yy_cov = ekf.cov[3];
+    out.yaw_cov = ekf.cov[4];
+
+    out.has_odom = !m_odom.isEmpty();
+    if (out.has_odom)
+    {
+        const Sample odom = interpolate(m_odom, tick);
+        out.odom_position = QPointF(odom.x, odom.y);
+        out.odom_heading = odom.heading;
+    }
+
+    out.has_imu = !m_imu.isEmpty();
+    if (out.has_imu) out.imu_heading = interpolate(m_imu, tick).heading;
+
+    return true;
+}
+
+const rom_dynamics::communication::EkfSessionState::Sample &
+rom_dynamics::communication::EkfSessionState::atOrBefore(const Stream &stream, double t)
+{
+    for (int i = stream.size() - 1; i > 0; --i)
+    {
+        if (stream[i].t <= t) return stream[i];
+    }
+    return stream.first();
+}
+
+rom_dynamics::communication::EkfSessionState::Sample
+rom_dynamics::communication::EkfSessionState::interpolate(const Stream &stream, double t)
+{
+    // outside the buffered range : hold the nearest sample, never extrapolate
+    if (t <= stream.first().t) return stream.first();
+    if (t >= stream.last().t) return stream.last();
+
+    // the tick is close to the newest samples, search from the back
+    int i = stream.size() - 1;
+    while (i > 0 && stream[i - 1].t > t) --i;
+
+    const Sample &a = stream[i - 1];
+    const Sample &b = stream[i];
+    const double span = b.t - a.t;
+    const double f = span > 0.0 ? (t - a.t) / span : 1.0;
+
+    Sample s = b;
+    s.t = t;
+    s.x = a.x + (b.x - a.x) * f;
+    s.y = a.y + (b.y - a.y) * f;
+    s.heading = lerpDegrees(a.heading, b.heading, f);
+    return s;
+}
+
+double rom_dynamics::communication::EkfSessionState::lerpDegrees(double a, double b, double f)
+{
+    // shortest way round, result in ( -180, 180 ]
+    const double diff = std::remainder(b - a, 360.0);
+    double h = a + diff * f;
+    h = std::remainder(h, 360.0);
+    return h <= -180.0 ? h + 360.0 : h;
+}
@@ -0,0 +1,73 @@
+#ifndef ROM_EKF_SESSION_STATE_HPP
+#define ROM_EKF_SESSION_STATE_HPP
+
+#pragma once
+#include <QList>
+#include <QPointF>
+
+namespace rom_dynamics::communication {
+
+// One consistent view of the three ekf tab streams at a single time.
+struct EkfSnapshot {
+    double t_sec = 0.0;
+
+    QPointF ekf_position;
+    double ekf_heading = 0.0;       // degrees
+    double xx_cov = 0.0, xy_cov = 0.0, yx_cov = 0.0, yy_cov = 0.0;
+    double yaw_cov = 0.0;
+
+    bool has_odom = false;
+    QPointF odom_position;
+    double odom_heading = 0.0;
+
+    bool has_imu = false;
+    double imu_heading = 0.0;
+};
+
+// Fused ekf / diff odom / imu state of one robot session.
+// Decode handlers only add timestamped samples; once per display frame snapshot()
+// picks a common tick ( the newest time every live stream has reached ), interpolates
+// odom and imu to it and returns the ekf sample at or before it. A stream that fell more
+// than staleAfter() behind the others is held at its last value instead of stalling the tick.
+class EkfSessionState {
+public:
+    // add* : t_sec from header.stamp, samples per stream must not go back in time
+    void addEkf(double t_sec, const QPointF &position, double heading_deg,
+                double xx_cov, double xy_cov, double yx_cov, double yy_cov, double yaw_cov);
+    void addOdom(double t_sec, const QPointF &position, double heading_deg);
+    void addImu(double t_sec, double heading_deg);
+
+    // false while there is no ekf sample or the tick did not move since the last call
+    bool snapshot(EkfSnapshot &out);
+
+    void clear();
+
+    void setHistoryLength(double seconds) { m_historySec = seconds; }
+    void setStaleAfter(double seconds) { m_staleSec = seconds; }
+    double staleAfter() const { return m_staleSec; }
+
+private:
+    struct Sample {
+        double t = 0.0;
+        double x = 0.0, y = 0.0;
+        double heading = 0.0;
+        double cov[5] = {};     // ekf only : xx xy yx yy yaw
+    };
+    using Stream = QList<Sample>;
+
+    void push(Stream &stream, const Sample &sample);
+    static Sample interpolate(const Stream &stream, double t);
+    static const Sample &atOrBefore(const Stream &stream, double t);
+    static double lerpDegrees(double a, double b, double f);
+
+    Stream m_ekf;
+    Stream m_odom;
+    Stream m_imu;
+
+    double m_lastTick = -1.0;
+    double m_historySec = 2.0;
+    double m_staleSec = 0.5;
+};
+}
+
+#endif
@@ -0,0 +1,389 @@
+#include "latency_tracer.hpp"
+#include "ros_bridge_client.hpp"
+#include "../design/rom_structures.h" // for ROM_COLOR_* macros
+
+#include <QDateTime>
+#include <QDebug>
+#include <QSet>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+using namespace rom_dynamics::data_types;
+
+//================================================================================
+// 1. LatencyHistogram
+//================================================================================
+
+int rom_dynamics::communication::LatencyHistogram::bucketFor(qint64 us)
+{
+    if (us < kLinearBuckets) return static_cast<int>(qMax<qint64>(0, us));
+
+    // most significant bit -> octave, next two bits -> sub bucket
+    int msb = 63 - __builtin_clzll(static_cast<quint64>(us));
+    int octave = msb - 4;
+    if (octave >= kOctaves) return kBuckets - 1;
+
+    int sub = static_cast<int>((us >> (msb - 2)) & (kSubBuckets - 1));
+    return kLinearBuckets + octave * kSubBuckets + sub;
+}
+
+qint64 rom_dynamics::communication::LatencyHistogram::bucketUpper(int index)
+{
+    if (index < kLinearBuckets) return index;
+
+    int octave = (index - kLinearBuckets) / kSubBuckets + 4;
+    int sub = (index - kLinearBuckets) % kSubBuckets;
+    qint64 width = qint64(1) << (octave - 2);
+    return (qint64(1) << octave) + (sub + 1) * width - 1;
+}
+
+void rom_dynamics::communication::LatencyHistogram::add(qint64 us)
+{
+    ++m_counts[bucketFor(us)];
+    ++m_total;
+}
+
+qint64 rom_dynamics::communication::LatencyHistogram::percentile(double p) const
+{
+    if (m_total == 0) return -1;
+
+    const quint64 rank = qMax<quint64>(1, static_cast<quint64>(p * m_total + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < kBuckets; ++i)
+    {
+        seen += m_counts[i];
+        if (seen >= rank) return bucketUpper(i);
+    }
+    return bucketUpper(kBuckets - 1);
+}
+
+void rom_dynamics::communication::LatencyHistogram::reset()
+{
+    m_counts.fill(0);
+    m_total = 0;
+}
+
+//================================================================================
+// 2. LatencyTracer
+//================================================================================
+
+rom_dynamics::communication::LatencyTracer::LatencyTracer(RosBridgeClient *client, QObject *parent)
+    : QObject(parent), m_client(client)
+{
+    m_wallEpochNs = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+    m_clock.start();
+
+    m_trace.resize(kTraceCapacity);
+
+    connect(&m_pingTimer, &QTimer::timeout, this, &LatencyTracer::sendClockPing);
+    if (m_client)
+    {
+        connect(m_client, &RosBridgeClient::serviceResponse, this, &LatencyTracer::onServiceResponse);
+    }
+}
+
+void rom_dynamics::communication::LatencyTracer::markReceived()
+{
+    m_current = Record{};
+    m_current.received_ns = wallNowNs();
+    m_inFlight = true;
+}
+
+void rom_dynamics::communication::LatencyTracer::markDecoded(const QString &topic, const QJsonObject &msg)
+{
+    if (!m_inFlight) return;
+
+    m_current.decoded_ns = wallNowNs();
+    m_current.topic_index = topicIndex(topic);
+
+    // header.stamp is ROS time, bring it onto the local wall clock
+    const qint64 stamp = headerStampNs(msg);
+    if (stamp > 0 && m_offsetValid)
+    {
+        m_current.stamp_ns = stamp - m_clockOffsetNs;
+    }
+}
+
+void rom_dynamics::communication::LatencyTracer::markDispatched()
+{
+    if (!m_inFlight || m_current.topic_index < 0) return;
+    m_inFlight = false;
+
+    m_current.dispatched_ns = wallNowNs();
+
+    TopicLatency &t = m_topics[m_current.topic_index];
+    ++t.messages;
+    if (m_current.stamp_ns > 0)
+    {
+        t.stages[Network].add(usBetween(m_current.stamp_ns, m_current.received_ns));
+    }
+    t.stages[Decode].add(usBetween(m_current.received_ns, m_current.decoded_ns));
+    t.stages[Dispatch].add(usBetween(m_current.decoded_ns, m_current.dispatched_ns));
+
+    // only topics a watched view shows get a render time
+    auto pending = m_pendingRender.find(m_current.topic_index);
+    if (pending == m_pendingRender.end()) return;
+
+    // nobody painted for a while ( hidden tab ) -> forget the oldest, render is not measured for them
+    std::vector<Record> &records = pending.value();
+    if (static_cast<int>(records.size()) >= kMaxPendingRender)
+    {
+        records.erase(records.begin(), records.begin() + kMaxPendingRender / 2);
+    }
+    records.push_back(m_current);
+}
+
+void rom_dynamics::communication::LatencyTracer::watchView(QObject *view, const QStringList &topics)
+{
+    if (!view) return;
+
+    QList<int> indexes;
+    for (const QString &topic : topics)
+    {
+        const int index = topicIndex(topic);
+        indexes.append(index);
+        if (!m_pendingRender.contains(index)) m_pendingRender.insert(index, std::vector<Record>());
+    }
+
+    if (!m_viewTopics.contains(view))
+    {
+        view->installEventFilter(this);
+        connect(view, &QObject::destroyed, this, [this, view]() { unwatchView(view); });
+    }
+    m_viewTopics.insert(view, indexes);
+}
+
+void rom_dynamics::communication::LatencyTracer::unwatchView(QObject *view)
+{
+    m_viewTopics.remove(view);
+
+    // topics no remaining view shows stop collecting pending records
+    QSet<int> shown;
+    for (const QList<int> &indexes : std::as_const(m_viewTopics))
+        for (const int index : indexes) shown.insert(index);
+    for (auto it = m_pendingRender.begin(); it != m_pendingRender.end();)
+    {
+        if (shown.contains(it.key())) ++it;
+        else it = m_pendingRender.erase(it);
+    }
+}
+
+void rom_dynamics::communication::LatencyTracer::markRendered(QObject *view)
+{
+    auto watched = m_viewTopics.constFind(view);
+    if (watched == m_viewTopics.constEnd()) return;
+
+    const qint64 now = wallNowNs();
+    for (const int index : watched.value())
+    {
+        auto pending = m_pendingRender.find(index);
+        if (pending == m_pendingRender.end() || pending.value().empty()) continue;
+
+        TopicLatency &t = m_topics[index];
+        for (Record &record : pending.value())
+        {
+            record.rendered_ns = now;
+            t.stages[Render].add(usBetween(record.dispatched_ns, now));
+            if (record.stamp_ns > 0)
+            {
+                t.stages[Total].add(usBetween(record.stamp_ns, now));
+            }
+            storeTrace(record);
+        }
+        pending.value().clear();
+    }
+}
+
+bool rom_dynamics::communication::LatencyTracer::eventFilter(QObject *watched, QEvent *event)
+{
+    // the first paint after a dispatch is the frame that shows the message
+    if (event->type() == QEvent::Paint)
+    {
+        markRendered(watched);
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+int rom_dynamics::communication::LatencyTracer::topicIndex(const QString &topic)
+{
+    auto it = m_topicIndex.constFind(topic);
+    if (it != m_topicIndex.constEnd()) return it.value();
+
+    const int index = m_topics.size();
+    TopicLatency t;
+    t.topic = topic;
+    m_topics.append(t);
+    m_topicIndex.insert(topic, index);
+    return index;
+}
+
+qint64 rom_dynamics::communication::LatencyTracer::headerStampNs(const QJsonObject &msg)
+{
+    const QJsonObject header = msg.value("header").toObject();
+    if (header.isEmpty()) return -1;
+
+    const QJsonObject stamp = header.value("stamp").toObject();
+    if (stamp.isEmpty()) return -1;
+
+    // ROS 2 : sec / nanosec, ROS 1 bridge : secs / nsecs
+    const qint64 sec = stamp.contains("sec") ? stamp.value("sec").toInteger() : stamp.value("secs").toInteger();
+    const qint64 nsec = stamp.contains("nanosec") ? stamp.value("nanosec").toInteger() : stamp.value("nsecs").toInteger();
+    if (sec <= 0) return -1;
+
+    return sec * 1000000000LL + nsec;
+}
+
+void rom_dynamics::communication::LatencyTracer::storeTrace(const Record &record)
+{
+    m_trace[m_traceHead] = record;
+    m_traceHead = (m_traceHead + 1) % kTraceCapacity;
+    if (m_traceHead == 0) m_traceWrapped = true;
+}
+
+void rom_dynamics::communication::LatencyTracer::reset()
+{
+    for (TopicLatency &t : m_topics)
+    {
+        t.messages = 0;
+        for (LatencyHistogram &h : t.stages) h.reset();
+    }
+    for (std::vector<Record> &records : m_pendingRender) records.clear();
+    m_traceHead = 0;
+    m_traceWrapped = false;
+}
+
+QString rom_dynamics::communication::LatencyTracer::stageName(int stage)
+{
+    switch (stage)
+    {
+        case Network:  return "network";
+        case Decode:   return "decode";
+        case Dispatch: return "dispatch";
+        case Render:   return "render";
+        case Total:    return "total";
+        default:       return "unknown";
+    }
+}
+
+// --------------------------------- CLOCK SYNC
+
+void rom_dynamics::communication::LatencyTracer::startClockSync(int interval_ms)
+{
+    m_pingTimer.start(interval_ms);
+    sendClockPing();
+}
+
+void rom_dynamics::communication::LatencyTracer::stopClockSync()
+{
+    m_pingTimer.stop();
+    m_pingSentNs.clear();
+}
+
+void rom_dynamics::communication::LatencyTracer::sendClockPing()
+{
+    if (!m_client || !m_client->isConnected()) return;
+
+    const QString id = QStringLiteral("rom_clock_sync_%1").arg(++m_pingSeq);
+
+    // unanswered pings ( rosapi not running ) must not pile up
+    if (m_pingSentNs.size() > kClockSamples) m_pingSentNs.clear();
+
+    m_pingSentNs.insert(id, wallNowNs());
+    m_client->callService("/rosapi/get_time", QJsonObject(), id);
+}
+
+void rom_dynamics::communication::LatencyTracer::onServiceResponse(const QString &id, const QString &service, bool result, const QJsonObject &values)
+{
+    Q_UNUSED(service);
+
+    auto it = m_pingSentNs.find(id);
+    if (it == m_pingSentNs.end()) return;
+
+    const qint64 sent_ns = it.value();
+    const qint64 received_ns = wallNowNs();
+    m_pingSentNs.erase(it);
+
+    if (!result) return;
+
+    const QJsonObject time = values.value("time").toObject();
+    const qint64 server_ns = time.value("sec").toInteger() * 1000000000LL + time.value("nanosec").toInteger();
+    if (server_ns <= 0) return;
+
+    // NTP style : server clock read halfway through the round trip
+    const qint64 rtt = received_ns - sent_ns;
+    const qint64 offset = server_ns - (sent_ns + rtt / 2);
+
+    m_sampleOffsetNs[m_sampleHead] = offset;
+    m_sampleRttNs[m_sampleHead] = rtt;
+    m_sampleHead = (m_sampleHead + 1) % kClockSamples;
+    m_sampleCount = qMin(m_sampleCount + 1, kClockSamples);
+
+    // the sample with the smallest round trip has the smallest error bound
+    int best = 0;
+    for (int i = 1; i < m_sampleCount; ++i)
+    {
+        if (m_sampleRttNs[i] < m_sampleRttNs[best]) best = i;
+    }
+    m_clockOffsetNs = m_sampleOffsetNs[best];
+    m_bestRttNs = m_sampleRttNs[best];
+    m_offsetValid = true;
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[    LatencyTracer::onServiceResponse    ] : offset %2 ms rtt %3 ms %4")
+                              .arg(ROM_COLOR_CYAN).arg(m_clockOffsetNs / 1e6).arg(m_bestRttNs / 1e6).arg(ROM_COLOR_RESET);
+    #endif
+}
+
+// --------------------------------- CHROME TRACE
+
+bool rom_dynamics::communication::LatencyTracer::exportChromeTrace(const QString &file_path) const
+{
+    QFile file(file_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+    QJsonArray events;
+
+    // one "thread" per topic so chrome://tracing / Perfetto shows a lane per topic
+    for (int i = 0; i < m_topics.size(); ++i)
+    {
+        QJsonObject meta;
+        meta["name"] = "thread_name";
+        meta["ph"] = "M";
+        meta["pid"] = 1;
+        meta["tid"] = i;
+        meta["args"] = QJsonObject{{"name", m_topics[i].topic}};
+        events.append(meta);
+    }
+
+    auto appendSpan = [&events](const QString &name, int tid, qint64 from_ns, qint64 to_ns) {
+        if (from_ns <= 0 || to_ns < from_ns) return;
+        QJsonObject e;
+        e["name"] = name;
+        e["cat"] = "rosbridge";
+        e["ph"] = "X";
+        e["pid"] = 1;
+        e["tid"] = tid;
+        e["ts"] = static_cast<double>(from_ns) / 1000.0;
+        e["dur"] = static_cast<double>(to_ns - from_ns) / 1000.0;
+        events.append(e);
+    };
+
+    const int count = m_traceWrapped ? kTraceCapacity : m_traceHead;
+    const int start = m_traceWrapped ? m_traceHead : 0;
+    for (int n = 0; n < count; ++n)
+    {
+        const Record &r = m_trace[(start + n) % kTraceCapacity];
+        appendSpan(stageName(Network), r.topic_index, r.stamp_ns, r.received_ns);
+        appendSpan(stageName(Decode), r.topic_index, r.received_ns, r.decoded_ns);
+        appendSpan(stageName(Dispatch), r.topic_index, r.decoded_ns, r.dispatched_ns);
+        appendSpan(stageName(Render), r.topic_index, r.dispatched_ns, r.rendered_ns);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
@@ -0,0 +1,138 @@
+#ifndef ROM_LATENCY_TRACER_HPP
+#define ROM_LATENCY_TRACER_HPP
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QStringList>
+#include <QList>
+#include <array>
+#include <vector>
+
+namespace rom_dynamics::communication {
+
+class RosBridgeClient;
+
+// Constant memory latency histogram ( HDR style : 4 sub buckets per power of two, in microseconds ).
+class LatencyHistogram {
+public:
+    static constexpr int kLinearBuckets = 16;
+    static constexpr int kSubBuckets    = 4;
+    static constexpr int kOctaves       = 28;     // up to ~2^31 us
+    static constexpr int kBuckets       = kLinearBuckets + kSubBuckets * kOctaves;
+
+    void add(qint64 us);
+    qint64 percentile(double p) const;            // p in [0, 1], returns microseconds
+    quint64 count() const { return m_total; }
+    void reset();
+
+private:
+    static int bucketFor(qint64 us);
+    static qint64 bucketUpper(int index);
+
+    std::array<quint32, kBuckets> m_counts{};
+    quint64 m_total{0};
+};
+
+// Stamps every received message at receive, decode, dispatch and render and compares
+// against header.stamp ( corrected by the clock offset from /rosapi/get_time pings ).
+class LatencyTracer : public QObject {
+    Q_OBJECT
+public:
+    enum Stage { Network = 0, Decode, Dispatch, Render, Total, StageCount };
+
+    struct TopicLatency {
+        QString topic;
+        quint64 messages = 0;
+        std::array<LatencyHistogram, StageCount> stages;
+    };
+
+    explicit LatencyTracer(RosBridgeClient *client, QObject *parent = nullptr);
+
+    // --------------------------------- HOOKS ( called by RosBridgeClient / MainWindow )
+    void markReceived();
+    void markDecoded(const QString &topic, const QJsonObject &msg);
+    void markDispatched();
+
+    // a paint of view marks the pending messages of these topics ( as received ) rendered;
+    // messages of topics no view shows get no render / total time
+    void watchView(QObject *view, const QStringList &topics);
+
+    // --------------------------------- CLOCK SYNC
+    void startClockSync(int interval_ms = 2000);
+    void stopClockSync();
+    bool hasClockOffset() const { return m_offsetValid; }
+    qint64 clockOffsetNs() const { return m_clockOffsetNs; }
+    qint64 clockSyncRttNs() const { return m_bestRttNs; }
+
+    // --------------------------------- RESULTS
+    const QList<TopicLatency> &topics() const { return m_topics; }
+    void reset();
+    bool exportChromeTrace(const QString &file_path) const;
+
+    static QString stageName(int stage);
+
+    // eventFilter : QEvent::Paint on a watched view marks its topics' pending messages as rendered
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void sendClockPing();
+    void onServiceResponse(const QString &id, const QString &service, bool result, const QJsonObject &values);
+
+private:
+    struct Record {
+        int topic_index = -1;
+        qint64 stamp_ns = -1;           // header.stamp in local wall clock, -1 if the msg has no header
+        qint64 received_ns = 0;
+        qint64 decoded_ns = 0;
+        qint64 dispatched_ns = 0;
+        qint64 rendered_ns = 0;
+    };
+
+    qint64 wallNowNs() const { return m_wallEpochNs + m_clock.nsecsElapsed(); }
+    int topicIndex(const QString &topic);
+    static qint64 headerStampNs(const QJsonObject &msg);
+    static qint64 usBetween(qint64 from_ns, qint64 to_ns) { return (to_ns - from_ns) / 1000; }
+    void storeTrace(const Record &record);
+    void markRendered(QObject *view);
+    void unwatchView(QObject *view);
+
+    RosBridgeClient *m_client = nullptr;
+
+    QElapsedTimer m_clock;
+    qint64 m_wallEpochNs{0};
+
+    QHash<QString, int> m_topicIndex;
+    QList<TopicLatency> m_topics;
+
+    Record m_current;
+    bool m_inFlight{false};
+
+    static constexpr int kMaxPendingRender = 4096;     // per topic
+    QHash<int, std::vector<Record>> m_pendingRender;  // topic index -> dispatched, not painted yet
+    QHash<QObject*, QList<int>> m_viewTopics;
+
+    static constexpr int kTraceCapacity = 16384;
+    std::vector<Record> m_trace;
+    int m_traceHead{0};
+    bool m_traceWrapped{false};
+
+    // clock offset ( ROS time - local wall time ), min-RTT sample of the last kClockSamples pings
+    static constexpr int kClockSamples = 8;
+    QTimer m_pingTimer;
+    quint64 m_pingSeq{0};
+    QHash<QString, qint64> m_pingSentNs;
+    std::array<qint64, kClockSamples> m_sampleOffsetNs{};
+    std::array<qint64, kClockSamples> m_sampleRttNs{};
+    int m_sampleCount{0};
+    int m_sampleHead{0};
+    bool m_offsetValid{false};
+    qint64 m_clockOffsetNs{0};
+    qint64 m_bestRttNs{-1};
+};
+}
+
+#endif
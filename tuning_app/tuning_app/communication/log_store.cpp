@@ -0,0 +1,573 @@
+#include "log_store.hpp"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QJsonValue>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+using LineList = QVector<quint16>;
+
+bool isWordByte(char c)
+{
+    const unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_' || u >= 0x80;
+}
+
+// both sorted ascending
+LineList intersect(const LineList &a, const LineList &b)
+{
+    LineList out;
+    out.reserve(qMin(a.size(), b.size()));
+    std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(out));
+    return out;
+}
+
+LineList unite(QList<const LineList*> lists)
+{
+    LineList out;
+    for (const LineList *list : lists) out += *list;
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+}
+
+//================================================================================
+// 1. append
+//================================================================================
+
+rom_dynamics::communication::LogStore::LogStore()
+{
+    if (!m_spillDir.isValid())
+        qWarning() << "log store: no temporary directory, evicted lines are dropped";
+}
+
+rom_dynamics::communication::LogStore::~LogStore()
+{
+    clear();
+}
+
+void rom_dynamics::communication::LogStore::append(const QJsonObject &log)
+{
+    const QJsonObject stamp = log.value("stamp").toObject();
+    const qint64 stamp_ns = static_cast<qint64>(stamp.value("sec").toDouble()) * 1000000000LL
+                          + static_cast<qint64>(stamp.value("nanosec").toDouble());
+    append(stamp_ns, log.value("level").toInt(), log.value("name").toString(), log.value("msg").toString());
+}
+
+void rom_dynamics::communication::LogStore::append(qint64 stamp_ns, int ros_level, const QString &node, const QString &text)
+{
+    if (m_segments.isEmpty() || m_segments.last()->count == kSegmentLines)
+    {
+        // the previous segment is sealed now and may be evicted
+        Segment *segment = new Segment;
+        segment->first_id = m_nextId;
+        segment->data = new SegmentData;
+        m_segments.append(segment);
+        evict();
+    }
+
+    Segment &segment = *m_segments.last();
+    SegmentData &data = *segment.data;
+    const QByteArray utf8 = text.toUtf8();
+
+    Line line;
+    line.stamp_ns = stamp_ns;
+    line.offset = static_cast<quint32>(data.text.size());
+    line.length = static_cast<quint32>(utf8.size());
+    line.node = internNode(node);
+    line.level = static_cast<quint8>(levelIndex(ros_level));
+
+    const quint16 line_index = static_cast<quint16>(segment.count);
+    data.text.append(utf8);
+    data.lines.append(line);
+
+    const qint64 before = data.bytes + segment.index_bytes;
+    data.bytes += utf8.size() + static_cast<qint64>(sizeof(Line));
+    indexWords(data, line_index);
+
+    segment.by_level[line.level].append(line_index);
+    LineList &by_node = segment.by_node[line.node];
+    if (by_node.isEmpty()) segment.index_bytes += 32;
+    by_node.append(line_index);
+    segment.index_bytes += 2 * static_cast<qint64>(sizeof(quint16));
+
+    m_memoryBytes += data.bytes + segment.index_bytes - before;
+    ++segment.count;
+    ++m_nextId;
+}
+
+void rom_dynamics::communication::LogStore::clear()
+{
+    while (!m_segments.isEmpty()) dropFront();
+    // no line refers to a word id any more
+    m_words.clear();
+    m_wordBytes = 0;
+    m_wordsFull = false;
+    m_firstId = m_nextId;
+    m_memoryBytes = 0;
+    m_diskBytes = 0;
+}
+
+quint64 rom_dynamics::communication::LogStore::residentLines() const
+{
+    quint64 lines = 0;
+    for (const Segment *segment : m_segments)
+        if (segment->data) lines += segment->count;
+    return lines;
+}
+
+int rom_dynamics::communication::LogStore::levelIndex(int ros_level)
+{
+    // rcl_interfaces/msg/Log : DEBUG 10, INFO 20, WARN 30, ERROR 40, FATAL 50
+    return qBound(0, ros_level / 10 - 1, kLevels - 1);
+}
+
+const char *rom_dynamics::communication::LogStore::levelName(int index)
+{
+    static const char *names[kLevels] = { "DEBUG", "INFO", "WARN", "ERROR", "FATAL" };
+    return names[qBound(0, index, kLevels - 1)];
+}
+
+quint16 rom_dynamics::communication::LogStore::internNode(const QString &node)
+{
+    const auto it = m_nodeIds.constFind(node);
+    if (it != m_nodeIds.constEnd()) return it.value();
+
+    // quint16 ids; a stack with more nodes than that shares the last one
+    if (m_nodeNames.size() == 0xFFFF) return 0xFFFE;
+
+    const quint16 id = static_cast<quint16>(m_nodeNames.size());
+    m_nodeNames.append(node);
+    m_nodeIds.insert(node, id);
+    return id;
+}
+
+//================================================================================
+// 2. words
+//================================================================================
+
+void rom_dynamics::communication::LogStore::split(const char *text, int length, QList<QByteArray> &words)
+{
+    int begin = -1;
+    for (int i = 0; i <= length; ++i)
+    {
+        if (i < length && isWordByte(text[i]))
+        {
+            if (begin < 0) begin = i;
+            continue;
+        }
+        if (begin >= 0)
+        {
+            words.append(QByteArray(text + begin, i - begin).toLower());
+            begin = -1;
+        }
+    }
+}
+
+bool rom_dynamics::communication::LogStore::indexable(const QByteArray &word)
+{
+    if (word.size() < 2 || word.size() > 32) return false;
+    for (const char c : word)
+        if (c < '0' || c > '9') return true;
+    return false;
+}
+
+void rom_dynamics::communication::LogStore::indexWords(SegmentData &data, quint16 line_index)
+{
+    const Line &line = data.lines[line_index];
+    QList<QByteArray> words;
+    split(data.text.constData() + line.offset, static_cast<int>(line.length), words);
+
+    for (const QByteArray &word : words)
+    {
+        if (!indexable(word)) continue;
+
+        auto it = m_words.constFind(word);
+        if (it == m_words.constEnd())
+        {
+            // the dictionary lives as long as the store, keep it to a part of the budget
+            const qint64 cost = word.size() + kWordOverhead;
+            if (m_wordsFull || m_words.size() >= kMaxWords || 4 * (m_wordBytes + cost) > m_memoryBudget)
+            {
+                m_wordsFull = true;
+                continue;
+            }
+            it = m_words.insert(word, static_cast<quint32>(m_words.size()));
+            m_wordBytes += cost;
+            m_memoryBytes += cost;
+        }
+
+        LineList &lines = data.by_word[it.value()];
+        if (!lines.isEmpty() && lines.last() == line_index) continue;   // repeated in the line
+        if (lines.isEmpty()) data.bytes += 32;
+        lines.append(line_index);
+        data.bytes += static_cast<qint64>(sizeof(quint16));
+    }
+}
+
+quint32 rom_dynamics::communication::LogStore::bloomHash(quint32 word, int k)
+{
+    quint32 h = word * 0x9E3779B1u + static_cast<quint32>(k) * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h % kBloomBits;
+}
+
+//================================================================================
+// 3. query
+//================================================================================
+
+rom_dynamics::communication::LogStore::Query rom_dynamics::communication::LogStore::compile(const Filter &filter) const
+{
+    Query query;
+    query.min_level = qBound(0, filter.min_level, kLevels - 1);
+    query.nodes = filter.nodes;
+
+    const QByteArray text = filter.text.trimmed().toUtf8();
+    QList<QByteArray> words;
+    split(text.constData(), text.size(), words);
+
+    // words we never saw can still be in the lines when the dictionary is full
+    const bool saturated = m_wordsFull;
+    // while typing, the last word is a prefix
+    const bool last_is_prefix = !filter.text.isEmpty() && isWordByte(filter.text.toUtf8().back());
+
+    for (int i = 0; i < words.size(); ++i)
+    {
+        const QByteArray &word = words[i];
+        if (i == words.size() - 1 && last_is_prefix)
+        {
+            if (!indexable(word))
+            {
+                // a single character, a number or a long word is not in the index
+                query.unindexed.append(word);
+                continue;
+            }
+            bool overflow = saturated;
+            QList<quint32> ids;
+            for (auto it = m_words.lowerBound(word); it != m_words.constEnd() && !overflow; ++it)
+            {
+                if (!it.key().startsWith(word)) break;
+                ids.append(it.value());
+                overflow = ids.size() > kMaxPrefixWords;
+            }
+            if (overflow) query.unindexed.append(word);
+            else if (ids.isEmpty()) query.impossible = true;
+            else { query.prefix = ids; query.has_prefix = true; }
+            continue;
+        }
+
+        const auto it = m_words.constFind(word);
+        if (it != m_words.constEnd()) query.words.append(it.value());
+        else if (!indexable(word) || saturated) query.unindexed.append(word);
+        else query.impossible = true;
+    }
+    return query;
+}
+
+bool rom_dynamics::communication::LogStore::mayMatch(const Segment &segment, const Query &query) const
+{
+    bool level = false;
+    for (int l = query.min_level; l < kLevels && !level; ++l) level = !segment.by_level[l].isEmpty();
+    if (!level) return false;
+
+    if (!query.nodes.isEmpty())
+    {
+        bool node = false;
+        for (const quint16 id : query.nodes) node = node || segment.by_node.contains(id);
+        if (!node) return false;
+    }
+
+    if (segment.data || segment.bloom.isEmpty()) return true;
+
+    auto inBloom = [&](quint32 word) {
+        for (int k = 0; k < 3; ++k)
+            if (!segment.bloom.testBit(static_cast<int>(bloomHash(word, k)))) return false;
+        return true;
+    };
+    for (const quint32 word : query.words)
+        if (!inBloom(word)) return false;
+    if (query.has_prefix)
+        return std::any_of(query.prefix.cbegin(), query.prefix.cend(), inBloom);
+    return true;
+}
+
+void rom_dynamics::communication::LogStore::match(const Segment &segment, const SegmentData *data, const Query &query,
+                                                  int from, QVector<quint16> &out) const
+{
+    LineList candidates;
+    bool all = true;
+    auto restrict = [&](const LineList &lines) {
+        candidates = all ? lines : intersect(candidates, lines);
+        all = false;
+    };
+
+    if (query.min_level > 0)
+    {
+        QList<const LineList*> lists;
+        for (int l = query.min_level; l < kLevels; ++l) lists.append(&segment.by_level[l]);
+        restrict(unite(lists));
+    }
+    if (!query.nodes.isEmpty() && (all || !candidates.isEmpty()))
+    {
+        static const LineList none;
+        QList<const LineList*> lists;
+        for (const quint16 id : query.nodes)
+        {
+            const auto it = segment.by_node.constFind(id);
+            lists.append(it != segment.by_node.constEnd() ? &it.value() : &none);
+        }
+        restrict(unite(lists));
+    }
+    if (data)
+    {
+        static const LineList none;
+        for (const quint32 word : query.words)
+        {
+            if (!all && candidates.isEmpty()) break;
+            const auto it = data->by_word.constFind(word);
+            restrict(it != data->by_word.constEnd() ? it.value() : none);
+        }
+        if (query.has_prefix && (all || !candidates.isEmpty()))
+        {
+            QList<const LineList*> lists;
+            for (const quint32 word : query.prefix)
+            {
+                const auto it = data->by_word.constFind(word);
+                if (it != data->by_word.constEnd()) lists.append(&it.value());
+            }
+            restrict(unite(lists));
+        }
+    }
+    if (!all && candidates.isEmpty()) return;
+
+    auto accept = [&](quint16 line_index) {
+        if (line_index < from) return;
+        if (!query.unindexed.isEmpty())
+        {
+            const Line &line = data->lines[line_index];
+            const QByteArray lower = QByteArray(data->text.constData() + line.offset, static_cast<int>(line.length)).toLower();
+            for (const QByteArray &word : query.unindexed)
+                if (!lower.contains(word)) return;
+        }
+        out.append(line_index);
+    };
+
+    if (all)
+        for (int i = from; i < segment.count; ++i) accept(static_cast<quint16>(i));
+    else
+        for (const quint16 line_index : candidates) accept(line_index);
+}
+
+void rom_dynamics::communication::LogStore::query(const Filter &filter, quint64 from, QVector<quint64> &out)
+{
+    const Query compiled = compile(filter);
+    if (compiled.impossible) return;
+
+    from = qMax(from, m_firstId);
+    if (from >= m_nextId) return;
+
+    const bool needs_text = !compiled.words.isEmpty() || compiled.has_prefix || !compiled.unindexed.isEmpty();
+    QVector<quint16> hits;
+
+    for (int s = segmentOf(from); s < m_segments.size(); ++s)
+    {
+        Segment &segment = *m_segments[s];
+        if (!mayMatch(segment, compiled)) continue;
+
+        const SegmentData *data = segment.data;
+        if (!data && needs_text)
+        {
+            data = load(segment);
+            if (!data) continue;
+        }
+
+        const int begin = from > segment.first_id ? static_cast<int>(from - segment.first_id) : 0;
+        hits.clear();
+        match(segment, data, compiled, begin, hits);
+        for (const quint16 line_index : hits) out.append(segment.first_id + line_index);
+    }
+}
+
+bool rom_dynamics::communication::LogStore::entry(quint64 id, Entry &out)
+{
+    if (id < m_firstId || id >= m_nextId) return false;
+
+    Segment &segment = *m_segments[segmentOf(id)];
+    const int line_index = static_cast<int>(id - segment.first_id);
+    if (line_index >= segment.count) return false;
+
+    const SegmentData *data = segment.data ? segment.data : load(segment);
+    if (!data) return false;
+
+    const Line &line = data->lines[line_index];
+    out.stamp_ns = line.stamp_ns;
+    out.level = line.level;
+    out.node = line.node;
+    out.text = QString::fromUtf8(data->text.constData() + line.offset, static_cast<int>(line.length));
+    return true;
+}
+
+int rom_dynamics::communication::LogStore::segmentOf(quint64 id) const
+{
+    const auto it = std::upper_bound(m_segments.cbegin(), m_segments.cend(), id,
+                                     [](quint64 value, const Segment *segment) { return value < segment->first_id; });
+    return qMax(0, static_cast<int>(it - m_segments.cbegin()) - 1);
+}
+
+//================================================================================
+// 4. eviction
+//================================================================================
+
+void rom_dynamics::communication::LogStore::evict()
+{
+    // the last segment is still being filled
+    for (int i = 0; i + 1 < m_segments.size() && m_memoryBytes > m_memoryBudget; ++i)
+    {
+        Segment *segment = m_segments[i];
+        if (!segment->data || spill(*segment)) continue;
+
+        // could not write it : drop it and everything older, ids stay contiguous
+        for (int k = 0; k <= i; ++k) dropFront();
+        i = -1;
+    }
+
+    // the level / node lists of evicted segments and the files have limits too
+    while (m_segments.size() > 1 && !m_segments.first()->data
+           && (m_diskBytes > m_diskBudget || m_memoryBytes > m_memoryBudget))
+        dropFront();
+}
+
+bool rom_dynamics::communication::LogStore::spill(Segment &segment)
+{
+    if (!m_spillDir.isValid()) return false;
+    SegmentData *data = segment.data;
+
+    QByteArray raw;
+    {
+        QDataStream out(&raw, QIODevice::WriteOnly);
+        out.setByteOrder(QDataStream::LittleEndian);
+        out << static_cast<quint32>(data->lines.size());
+        for (const Line &line : data->lines)
+            out << line.stamp_ns << line.offset << line.length << line.node << line.level;
+        out << data->text;
+        // the word lists too, reading them back is cheaper than splitting every line again
+        out << static_cast<quint32>(data->by_word.size());
+        for (auto it = data->by_word.constBegin(); it != data->by_word.constEnd(); ++it)
+        {
+            out << it.key() << static_cast<quint32>(it.value().size());
+            for (const quint16 line_index : it.value()) out << line_index;
+        }
+    }
+
+    capture::Compression compression = capture::bestAvailableCompression();
+    QByteArray stored = capture::compress(raw, compression);
+    if (stored.isEmpty())
+    {
+        compression = capture::Compression::None;
+        stored = raw;
+    }
+
+    const QString path = m_spillDir.filePath(QStringLiteral("segment_%1.rlog").arg(segment.first_id));
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(stored) != stored.size())
+    {
+        qWarning() << "log store: could not write" << path << file.errorString();
+        file.remove();
+        return false;
+    }
+
+    segment.bloom = QBitArray(kBloomBits);
+    for (auto it = data->by_word.constBegin(); it != data->by_word.constEnd(); ++it)
+        for (int k = 0; k < 3; ++k) segment.bloom.setBit(static_cast<int>(bloomHash(it.key(), k)));
+
+    segment.file = path;
+    segment.raw_size = static_cast<quint32>(raw.size());
+    segment.stored_size = stored.size();
+    segment.compression = compression;
+    segment.index_bytes += kBloomBits / 8;
+
+    m_diskBytes += segment.stored_size;
+    m_memoryBytes -= data->bytes - kBloomBits / 8;
+    segment.data = nullptr;
+    delete data;
+    return true;
+}
+
+rom_dynamics::communication::LogStore::SegmentData *rom_dynamics::communication::LogStore::load(Segment &segment)
+{
+    for (int i = 0; i < m_cache.size(); ++i)
+    {
+        if (m_cache[i].first != &segment) continue;
+        m_cache.move(i, 0);
+        return m_cache.first().second;
+    }
+
+    QFile file(segment.file);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "log store: could not read" << segment.file << file.errorString();
+        return nullptr;
+    }
+    const QByteArray raw = capture::decompress(file.readAll(), segment.compression, segment.raw_size);
+    if (static_cast<quint32>(raw.size()) != segment.raw_size) return nullptr;
+
+    SegmentData *data = new SegmentData;
+    QDataStream in(raw);
+    in.setByteOrder(QDataStream::LittleEndian);
+    quint32 count = 0;
+    in >> count;
+    data->lines.resize(static_cast<int>(count));
+    for (Line &line : data->lines)
+        in >> line.stamp_ns >> line.offset >> line.length >> line.node >> line.level;
+    in >> data->text;
+    quint32 words = 0;
+    in >> words;
+    for (quint32 w = 0; w < words && in.status() == QDataStream::Ok; ++w)
+    {
+        quint32 word = 0, size = 0;
+        in >> word >> size;
+        if (size > count) break;
+        LineList &lines = data->by_word[word];
+        lines.resize(static_cast<int>(size));
+        for (quint16 &line_index : lines) in >> line_index;
+    }
+    if (in.status() != QDataStream::Ok || static_cast<int>(count) != segment.count)
+    {
+        delete data;
+        return nullptr;
+    }
+
+    m_cache.prepend(qMakePair(&segment, data));
+    while (m_cache.size() > kCacheSegments) delete m_cache.takeLast().second;
+    return data;
+}
+
+void rom_dynamics::communication::LogStore::dropFront()
+{
+    Segment *segment = m_segments.takeFirst();
+
+    for (int i = 0; i < m_cache.size(); ++i)
+    {
+        if (m_cache[i].first != segment) continue;
+        delete m_cache.takeAt(i).second;
+        break;
+    }
+    if (!segment->file.isEmpty())
+    {
+        QFile::remove(segment->file);
+        m_diskBytes -= segment->stored_size;
+    }
+
+    m_memoryBytes -= segment->index_bytes + (segment->data ? segment->data->bytes : 0);
+    m_firstId = m_segments.isEmpty() ? m_nextId : m_segments.first()->first_id;
+    delete segment->data;
+    delete segment;
+}
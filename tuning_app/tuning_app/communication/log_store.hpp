@@ -0,0 +1,182 @@
+#ifndef ROM_LOG_STORE_HPP
+#define ROM_LOG_STORE_HPP
+
+#pragma once
+#include <QBitArray>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVector>
+#include "session_capture.hpp"
+
+namespace rom_dynamics::communication {
+
+// /rosout ( rcl_interfaces/msg/Log ) kept in memory and searchable.
+//
+// Lines get consecutive ids and are appended into segments of kSegmentLines. A segment
+// keeps fixed size records, its message text in one arena and inverted indexes from
+// level, node and word ( lower case, [a-z0-9_] and non ASCII, 2..32 chars, not only
+// digits ) to the sorted line indexes that carry them, so a query intersects a few short
+// lists per segment instead of looking at every line. Node names and words are interned
+// once for the whole store; the word dictionary is sorted, so a prefix is a range of it,
+// and counts against memoryBudget() : it stops growing at a quarter of the budget ( or
+// kMaxWords ) and later words are not indexed. Query words that are not indexable
+// ( numbers, long words, a prefix matching too many words ) are matched as substrings of
+// the candidate lines.
+//
+// Once the segments use more than memoryBudget() the oldest sealed one moves its records,
+// text and word index into a compressed ( capture::compress ) file of a temporary
+// directory. Its level / node lists and a bloom filter over its word ids stay, so level
+// and node filters never touch the disk and a word search only reads back the segments
+// that may contain the word ( kCacheSegments are kept decoded ). Past diskBudget() the
+// oldest segments are dropped and firstId() moves on.
+class LogStore {
+public:
+    static constexpr int kSegmentLines = 16384;
+    static constexpr int kLevels = 5;                           // debug info warn error fatal
+    static constexpr qint64 kDefaultMemoryBudget = 128LL << 20;
+    static constexpr qint64 kDefaultDiskBudget = 1LL << 30;
+    static constexpr int kMaxWords = 1 << 20;                   // later words are not indexed
+    static constexpr int kMaxPrefixWords = 512;
+
+    struct Filter {
+        int min_level = 0;          // level index
+        QList<quint16> nodes;       // empty : every node
+        QString text;               // words, all must match, the last one as a prefix
+
+        bool isEmpty() const { return min_level == 0 && nodes.isEmpty() && text.trimmed().isEmpty(); }
+    };
+
+    struct Entry {
+        qint64 stamp_ns = 0;
+        int level = 0;              // level index
+        quint16 node = 0;
+        QString text;
+    };
+
+    LogStore();
+    ~LogStore();
+
+    LogStore(const LogStore &) = delete;
+    LogStore &operator=(const LogStore &) = delete;
+
+    // one decoded rcl_interfaces/msg/Log
+    void append(const QJsonObject &log);
+    void append(qint64 stamp_ns, int ros_level, const QString &node, const QString &text);
+    void clear();
+
+    // ids of the kept lines are [firstId(), endId())
+    quint64 firstId() const { return m_firstId; }
+    quint64 endId() const { return m_nextId; }
+
+    // false when the id is gone or its segment could not be read back
+    bool entry(quint64 id, Entry &out);
+
+    // appends the ids >= from that match, ascending
+    void query(const Filter &filter, quint64 from, QVector<quint64> &out);
+
+    const QStringList &nodeNames() const { return m_nodeNames; }
+    static int levelIndex(int ros_level);       // 10..50 -> 0..4
+    static const char *levelName(int index);
+
+    void setMemoryBudget(qint64 bytes) { m_memoryBudget = bytes; evict(); }
+    qint64 memoryBudget() const { return m_memoryBudget; }
+    void setDiskBudget(qint64 bytes) { m_diskBudget = bytes; evict(); }
+    qint64 diskBudget() const { return m_diskBudget; }
+
+    qint64 memoryBytes() const { return m_memoryBytes; }
+    qint64 diskBytes() const { return m_diskBytes; }
+    quint64 residentLines() const;
+    int wordCount() const { return m_words.size(); }
+
+private:
+    static constexpr int kCacheSegments = 2;
+    static constexpr int kBloomBits = 1 << 15;
+    static constexpr int kWordOverhead = 96;    // map node + QByteArray header, per word
+
+    struct Line {
+        qint64 stamp_ns = 0;
+        quint32 offset = 0;         // into SegmentData::text
+        quint32 length = 0;
+        quint16 node = 0;
+        quint8 level = 0;
+    };
+
+    // the part that goes to disk
+    struct SegmentData {
+        QVector<Line> lines;
+        QByteArray text;
+        QHash<quint32, QVector<quint16>> by_word;
+        qint64 bytes = 0;           // approximate heap use
+    };
+
+    struct Segment {
+        quint64 first_id = 0;
+        int count = 0;
+        SegmentData *data = nullptr;            // nullptr once evicted
+
+        QVector<quint16> by_level[kLevels];
+        QHash<quint16, QVector<quint16>> by_node;
+        qint64 index_bytes = 0;
+        QBitArray bloom;                        // word ids, set on eviction
+
+        QString file;
+        quint32 raw_size = 0;
+        qint64 stored_size = 0;
+        capture::Compression compression{capture::Compression::None};
+    };
+
+    struct Query {
+        int min_level = 0;
+        QList<quint16> nodes;
+        QList<quint32> words;                   // all required
+        QList<quint32> prefix;                  // any of them, empty with has_prefix : no match
+        bool has_prefix = false;
+        QList<QByteArray> unindexed;            // matched as substrings of the candidates
+        bool impossible = false;
+    };
+
+    void indexWords(SegmentData &data, quint16 line_index);
+    quint16 internNode(const QString &node);
+    Query compile(const Filter &filter) const;
+    bool mayMatch(const Segment &segment, const Query &query) const;
+    void match(const Segment &segment, const SegmentData *data, const Query &query,
+               int from, QVector<quint16> &out) const;
+
+    int segmentOf(quint64 id) const;
+    SegmentData *load(Segment &segment);
+    void evict();
+    bool spill(Segment &segment);
+    void dropFront();
+
+    static void split(const char *text, int length, QList<QByteArray> &words);
+    static bool indexable(const QByteArray &word);
+
+    static quint32 bloomHash(quint32 word, int k);
+
+    QList<Segment*> m_segments;                 // oldest first, the last one is filled
+    QList<QPair<Segment*, SegmentData*>> m_cache;   // read back segments, newest first
+
+    QHash<QString, quint16> m_nodeIds;
+    QStringList m_nodeNames;
+    QMap<QByteArray, quint32> m_words;          // sorted : a prefix is a range
+    qint64 m_wordBytes{0};                      // part of m_memoryBytes
+    bool m_wordsFull{false};                    // some words were not interned
+
+    QTemporaryDir m_spillDir;
+    quint64 m_firstId{0};
+    quint64 m_nextId{0};
+    qint64 m_memoryBudget{kDefaultMemoryBudget};
+    qint64 m_diskBudget{kDefaultDiskBudget};
+    qint64 m_memoryBytes{0};
+    qint64 m_diskBytes{0};
+};
+}
+
+#endif
@@ -1,10 +1,13 @@
 #include "ros_bridge_client.hpp"
+#include "latency_tracer.hpp"
+#include "session_capture.hpp"
 //#include "rom_structures.h" // for ROM_COLOR_* macros
 
 #include <QDateTime>
 #include <QDebug>
 #include <cmath>
 #include <QMetaType>
+#include <QRandomGenerator>
 
 rom_dynamics::communication::RosBridgeClient::RosBridgeClient(const QString &robot_ns, const QString &host, quint16 port, QObject *parent)
     : QObject(parent), m_robotNamespace(robot_ns), m_host(host), m_port(port) {
@@ -16,6 +19,10 @@ rom_dynamics::communication::RosBridgeClient::RosBridgeClient(const QString &rob
         qDebug().noquote() << QString("%1[      RosBridgeClient::RosBridgeClient      ]%2")
                               .arg(ROM_COLOR_GREEN).arg(ROM_COLOR_RESET);
     #endif
+    m_tracer = new LatencyTracer(this, this);
+    connect(this, &RosBridgeClient::connected, m_tracer, [this]() { m_tracer->startClockSync(); });
+    connect(this, &RosBridgeClient::disconnected, m_tracer, &LatencyTracer::stopClockSync);
+
     connect(&m_socket, &QWebSocket::connected, this, &RosBridgeClient::onSocketConnected);
     connect(&m_socket, &QWebSocket::disconnected, this, &RosBridgeClient::onSocketDisconnected);
     connect(&m_socket, &QWebSocket::textMessageReceived, this, &RosBridgeClient::onTextMessageReceived);
@@ -23,10 +30,15 @@ rom_dynamics::communication::RosBridgeClient::RosBridgeClient(const QString &rob
 
     this->connectToServer();
 
-    m_reconnectTimer.setInterval(3000);
+    m_reconnectTimer.setInterval(kReconnectBaseMs);
     m_reconnectTimer.setSingleShot(true);
     connect(&m_reconnectTimer, &QTimer::timeout, this, &RosBridgeClient::ensureReconnect);
 
+    // zero interval -> fires once the current burst ( e.g. tab activation ) returned to the event loop
+    m_flushTimer.setInterval(0);
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, &QTimer::timeout, this, &RosBridgeClient::flushOutbox);
+
 }
 
 // MAIN API
@@ -37,6 +49,7 @@ void rom_dynamics::communication::RosBridgeClient::connectToServer()
                               .arg(ROM_COLOR_GREEN).arg(ROM_COLOR_RESET);
     #endif
 
+    m_reconnectEnabled = true;
     if (isConnected()) return;
 
     const QUrl url(QStringLiteral("ws://%1:%2").arg(m_host).arg(m_port));
@@ -50,6 +63,7 @@ void rom_dynamics::communication::RosBridgeClient::disconnectFromServer()
                               .arg(ROM_COLOR_GREEN).arg(ROM_COLOR_RESET);
     #endif
 
+    m_reconnectEnabled = false;
     m_reconnectTimer.stop();
     
     if (isConnected()) 
@@ -66,7 +80,125 @@ void rom_dynamics::communication::RosBridgeClient::sendJson(const QJsonObject &o
     #endif
 
     QJsonDocument doc(obj);
-    m_socket.sendTextMessage(QString::fromUtf8(doc.toJson(QJsonDocument::Compact)));
+    sendText(QString::fromUtf8(doc.toJson(QJsonDocument::Compact)));
+}
+
+void rom_dynamics::communication::RosBridgeClient::sendText(const QString &frame) 
+{
+    if (m_outbox.size() >= kMaxOutboxFrames)
+    {
+        qWarning() << "RosBridgeClient outbox full, dropping oldest frame";
+        m_outbox.removeFirst();
+    }
+    m_outbox.append(frame);
+    scheduleFlush();
+}
+
+void rom_dynamics::communication::RosBridgeClient::scheduleFlush() 
+{
+    if (!m_flushTimer.isActive())
+    {
+        m_flushTimer.start();
+    }
+}
+
+void rom_dynamics::communication::RosBridgeClient::flushOutbox() 
+{
+    // stays buffered until onSocketConnected flushes again
+    if (!isConnected()) return;
+
+    static const QString subscribe_template   = QStringLiteral(R"({"op":"subscribe","topic":"%1","type":"%2"})");
+    static const QString unsubscribe_template = QStringLiteral(R"({"op":"unsubscribe","topic":"%1"})");
+
+    int sent = 0;
+
+    // subscriptions : only the net difference between desired and on-wire state goes out
+    for (const QString &topic : std::as_const(m_dirtyTopics))
+    {
+        auto desired = m_subscriptions.constFind(topic);
+        auto wire = m_wireSubscriptions.constFind(topic);
+
+        if (desired != m_subscriptions.constEnd())
+        {
+            if (wire != m_wireSubscriptions.constEnd() && wire.value() == desired.value()) continue;
+
+            m_socket.sendTextMessage(subscribe_template.arg(jsonEscaped(topic), jsonEscaped(desired.value())));
+            m_wireSubscriptions.insert(topic, desired.value());
+            ++sent;
+        }
+        else if (wire != m_wireSubscriptions.constEnd())
+        {
+            m_socket.sendTextMessage(unsubscribe_template.arg(jsonEscaped(topic)));
+            m_wireSubscriptions.remove(topic);
+            ++sent;
+        }
+    }
+    m_dirtyTopics.clear();
+
+    for (const QString &frame : std::as_const(m_outbox))
+    {
+        m_socket.sendTextMessage(frame);
+        ++sent;
+    }
+    m_outbox.clear();
+
+    if (sent > 0)
+    {
+        m_socket.flush();
+    }
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[        RosBridgeClient::flushOutbox        ] : %2 frames %3")
+                              .arg(ROM_COLOR_GREEN).arg(sent).arg(ROM_COLOR_RESET);
+    #endif
+}
+
+QString rom_dynamics::communication::RosBridgeClient::jsonEscaped(const QString &value) 
+{
+    // ROS names and types never need escaping, keep the fast path allocation free
+    bool plain = true;
+    for (const QChar c : value)
+    {
+        if (c == u'"' || c == u'\\' || c.unicode() < 0x20)
+        {
+            plain = false;
+            break;
+        }
+    }
+    if (plain) return value;
+
+    QString escaped;
+    escaped.reserve(value.size() + 8);
+    for (const QChar c : value)
+    {
+        if (c == u'"')              escaped += QStringLiteral("\\\"");
+        else if (c == u'\\')        escaped += QStringLiteral("\\\\");
+        else if (c.unicode() < 0x20) escaped += QStringLiteral("\\u%1").arg(c.unicode(), 4, 16, QChar(u'0'));
+        else                        escaped += c;
+    }
+    return escaped;
+}
+
+QString rom_dynamics::communication::RosBridgeClient::peekPublishTopic(const QByteArray &frame)
+{
+    // rosbridge writes op and topic ahead of msg, so the head of the frame is enough
+    const QByteArray head = QByteArray::fromRawData(frame.constData(), qMin<qsizetype>(frame.size(), 512));
+    if (!head.contains("\"publish\"")) return QString();
+
+    int key = head.indexOf("\"topic\"");
+    if (key < 0) return QString();
+    const int open = head.indexOf('"', head.indexOf(':', key + 7) + 1);
+    if (open < 0) return QString();
+    const int close = head.indexOf('"', open + 1);
+    if (close < 0) return QString();
+    return QString::fromUtf8(head.constData() + open + 1, close - open - 1);
+}
+
+void rom_dynamics::communication::RosBridgeClient::setRawTopic(const QString &topic_name, bool raw)
+{
+    const QString topic = m_robotNamespace + topic_name;
+    if (raw) m_rawTopics.insert(topic);
+    else m_rawTopics.remove(topic);
 }
 
 void rom_dynamics::communication::RosBridgeClient::ensureReconnect() 
@@ -82,6 +214,38 @@ void rom_dynamics::communication::RosBridgeClient::ensureReconnect()
     }
 }
 
+void rom_dynamics::communication::RosBridgeClient::scheduleReconnect() 
+{
+    // disconnected and errorOccurred both land here for the same drop
+    if (!m_reconnectEnabled || isConnected() || m_reconnectTimer.isActive()) return;
+
+    // exponential backoff with equal jitter : [ delay/2, delay ]
+    const int exponent = qMin(m_reconnectAttempt, 16);
+    const int delay = static_cast<int>(qMin<qint64>(kReconnectCapMs, qint64(kReconnectBaseMs) << exponent));
+    const int jittered = delay / 2 + QRandomGenerator::global()->bounded(delay / 2 + 1);
+
+    ++m_reconnectAttempt;
+    m_reconnectTimer.start(jittered);
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[     RosBridgeClient::scheduleReconnect     ] : attempt %2 in %3 ms %4")
+                              .arg(ROM_COLOR_GREEN).arg(m_reconnectAttempt).arg(jittered).arg(ROM_COLOR_RESET);
+    #endif
+}
+
+void rom_dynamics::communication::RosBridgeClient::replaySubscriptions() 
+{
+    // a fresh socket has no subscriptions on the rosbridge side
+    m_wireSubscriptions.clear();
+    m_dirtyTopics = m_subscriptions.keys();
+    flushOutbox();
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[    RosBridgeClient::replaySubscriptions    ] : %2 topics %3")
+                              .arg(ROM_COLOR_GREEN).arg(m_subscriptions.size()).arg(ROM_COLOR_RESET);
+    #endif
+}
+
 
 void rom_dynamics::communication::RosBridgeClient::onSocketConnected() 
 {
@@ -90,6 +254,19 @@ void rom_dynamics::communication::RosBridgeClient::onSocketConnected()
                               .arg(ROM_COLOR_GREEN).arg(ROM_COLOR_RESET);
     #endif
 
+    m_reconnectTimer.stop();
+
+    // a previous connection dropped -> start the reconnect-to-first-message clock
+    if (m_outageClock.isValid())
+    {
+        m_reconnectClock.start();
+        m_awaitingFirstMessage = true;
+    }
+    m_reconnectAttempt = 0;
+
+    // rosbridge forgets everything with the socket, subscribe again
+    replaySubscriptions();
+
     emit connected(); // slot to mainwindow
     
 }
@@ -101,12 +278,15 @@ void rom_dynamics::communication::RosBridgeClient::onSocketDisconnected()
                               .arg(ROM_COLOR_GREEN).arg(ROM_COLOR_RESET);
     #endif
 
-    emit disconnected();
-
-    if (!isConnected()) 
+    if (!m_awaitingFirstMessage)
     {
-        m_reconnectTimer.start();
+        m_outageClock.start();
     }
+    m_awaitingFirstMessage = false;
+
+    emit disconnected();
+
+    scheduleReconnect();
 }
 
 void rom_dynamics::communication::RosBridgeClient::onSocketError(QAbstractSocket::SocketError) 
@@ -117,10 +297,7 @@ void rom_dynamics::communication::RosBridgeClient::onSocketError(QAbstractSocket
     #endif
 
     emit errorOccurred(m_socket.errorString());
-    if (!isConnected()) 
-    {
-        m_reconnectTimer.start();
-    }
+    scheduleReconnect();
 }
 
 void rom_dynamics::communication::RosBridgeClient::onTextMessageReceived(const QString &msg) 
@@ -132,8 +309,24 @@ void rom_dynamics::communication::RosBridgeClient::onTextMessageReceived(const Q
 
     // qDebug() << " RosBridgeClient::onTextMessageReceived Msg: " << msg;
 
+    m_tracer->markReceived();
+
+    const QByteArray frame = msg.toUtf8();
+
+    // large raw topics ( maps ) : no QJsonDocument here, the consumer decodes off this thread
+    if (!m_rawTopics.isEmpty())
+    {
+        const QString raw_topic = peekPublishTopic(frame);
+        if (!raw_topic.isEmpty() && m_rawTopics.contains(raw_topic))
+        {
+            if (m_recorder) m_recorder->record(raw_topic, frame);
+            emit receivedRawTopicMessage(raw_topic, frame);
+            return;
+        }
+    }
+
     QJsonParseError err{};
-    QJsonDocument doc = QJsonDocument::fromJson(msg.toUtf8(), &err);
+    QJsonDocument doc = QJsonDocument::fromJson(frame, &err);
 
     if (err.error != QJsonParseError::NoError) 
     {
@@ -152,9 +345,33 @@ void rom_dynamics::communication::RosBridgeClient::onTextMessageReceived(const Q
     if (op == "publish") 
     {
         const QString topic = obj.value("topic").toString();
+
+        if (m_awaitingFirstMessage)
+        {
+            m_awaitingFirstMessage = false;
+            m_lastReconnectLatencyMs = m_reconnectClock.elapsed();
+            m_lastOutageMs = m_outageClock.elapsed();
+            m_outageClock.invalidate();
+            emit reconnectLatencyMeasured(m_lastReconnectLatencyMs, m_lastOutageMs);
+        }
+
+        if (m_recorder) m_recorder->record(topic, frame);
         
-            emit receivedTopicMessage(topic, obj.value("msg").toObject());
+            const QJsonObject topic_msg = obj.value("msg").toObject();
+            m_tracer->markDecoded(topic, topic_msg);
+
+            emit receivedTopicMessage(topic, topic_msg);
             // qDebug() << "receivedTopicMessage emitted" << obj;
+
+            // direct connections returned -> handlers are done with it
+            m_tracer->markDispatched();
+    }
+    else if (op == "service_response") 
+    {
+        emit serviceResponse(obj.value("id").toString(),
+                             obj.value("service").toString(),
+                             obj.value("result").toBool(),
+                             obj.value("values").toObject());
     }
 }
 
@@ -162,19 +379,19 @@ void rom_dynamics::communication::RosBridgeClient::onTextMessageReceived(const Q
 // ROSBRIDGE API
 void rom_dynamics::communication::RosBridgeClient::subscribeTopic(const QString &topic_name, const QString &msg_type)
 {
+    QString topic_to_subscribe = m_robotNamespace + topic_name;
+    m_subscriptions.insert(topic_to_subscribe, msg_type);
+    if (!m_dirtyTopics.contains(topic_to_subscribe)) m_dirtyTopics.append(topic_to_subscribe);
+
+    // not connected yet -> the table is replayed from onSocketConnected; a handshake in
+    // progress or a pending backoff retry is left alone
     if (!isConnected())
     {
-        connectToServer();
+        if (m_socket.state() == QAbstractSocket::UnconnectedState && !m_reconnectTimer.isActive())
+            connectToServer();
+        return;
     }
-
-    QString topic_to_subscribe = m_robotNamespace + topic_name;
-
-    QJsonObject msg;
-
-    msg["op"] = "subscribe";
-    msg["topic"] = topic_to_subscribe;
-    msg["type"] = msg_type;
-    sendJson(msg);
+    scheduleFlush();
    
 
     #ifdef ROM_DEBUG
@@ -191,14 +408,26 @@ void rom_dynamics::communication::RosBridgeClient::unsubscribeTopic(const QStrin
                               .arg(ROM_COLOR_GREEN).arg(ROM_COLOR_RESET);
     #endif
 
+    QString topic_to_unsubscribe = m_robotNamespace + topic_name;
+    m_subscriptions.remove(topic_to_unsubscribe);
+    if (!m_dirtyTopics.contains(topic_to_unsubscribe)) m_dirtyTopics.append(topic_to_unsubscribe);
+
     if (!isConnected() ) return;
+    scheduleFlush();
 
-    QString topic_to_unsubscribe = m_robotNamespace + topic_name;
+}
+
+void rom_dynamics::communication::RosBridgeClient::callService(const QString &service_name, const QJsonObject &args, const QString &id)
+{
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[       RosBridgeClient::callService        ] : %2 %3")
+                              .arg(ROM_COLOR_GREEN).arg(service_name).arg(ROM_COLOR_RESET);
+    #endif
 
     QJsonObject msg;
-    msg["op"] = "unsubscribe";
-    msg["topic"] = topic_to_unsubscribe;
+    msg["op"] = "call_service";
+    msg["service"] = m_robotNamespace + service_name;
+    msg["args"] = args;
+    msg["id"] = id;
     sendJson(msg);
-
 }
-
@@ -6,11 +6,18 @@
 #include <QWebSocket>
 #include <QTimer>
 #include <QTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QSet>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 
 namespace rom_dynamics::communication {
+
+class LatencyTracer;
+class SessionRecorder;
     
 class RosBridgeClient : public QObject {
     Q_OBJECT
@@ -28,6 +35,28 @@ public:
     // --------------------------------- TOPIC SUBSCRIPTIONS
     void subscribeTopic(const QString &topic_name, const QString &msg_type);
     void unsubscribeTopic(const QString &topic_name);
+    const QHash<QString, QString> &activeSubscriptions() const { return m_subscriptions; }
+
+    // raw topics skip the JSON decode on this thread and come out as receivedRawTopicMessage
+    // ( whole rosbridge frame ), for large messages a consumer parses on its own worker thread
+    void setRawTopic(const QString &topic_name, bool raw = true);
+    bool isRawTopic(const QString &topic_name) const { return m_rawTopics.contains(m_robotNamespace + topic_name); }
+
+    // --------------------------------- SERVICES
+    void callService(const QString &service_name, const QJsonObject &args, const QString &id);
+
+    // --------------------------------- INSTRUMENTATION
+    LatencyTracer *latencyTracer() const { return m_tracer; }
+
+    // --------------------------------- CAPTURE
+    // every received publish frame is handed to the recorder as raw bytes ( nullptr = off )
+    void setRecorder(SessionRecorder *recorder) { m_recorder = recorder; }
+    SessionRecorder *recorder() const { return m_recorder; }
+
+    // --------------------------------- RECONNECT METRICS
+    qint64 lastReconnectLatencyMs() const { return m_lastReconnectLatencyMs; }
+    qint64 lastOutageMs() const { return m_lastOutageMs; }
+    int reconnectAttempts() const { return m_reconnectAttempt; }
 
 signals:
     // --------------------------------- MAIN API
@@ -37,6 +66,15 @@ signals:
     
     // --------------------------------- TOPIC SUBSCRIPTIONS
     void receivedTopicMessage(const QString &topic_name, const QJsonObject &msg);
+    void receivedRawTopicMessage(const QString &topic_name, const QByteArray &frame);
+
+    // --------------------------------- SERVICES
+    void serviceResponse(const QString &id, const QString &service_name, bool result, const QJsonObject &values);
+
+    // --------------------------------- RECONNECT METRICS
+    // first publish after a reconnect; latency is measured from the socket being
+    // connected again, outage from the moment the previous connection dropped
+    void reconnectLatencyMeasured(qint64 reconnect_to_first_message_ms, qint64 outage_ms);
 
 private slots:
     void onSocketConnected();
@@ -51,7 +89,15 @@ protected:
 
 private:
     void sendJson(const QJsonObject &obj);
+    void sendText(const QString &frame);
+    void scheduleFlush();
+    void flushOutbox();
     void ensureReconnect();
+    void scheduleReconnect();
+    void replaySubscriptions();
+
+    static QString jsonEscaped(const QString &value);
+    static QString peekPublishTopic(const QByteArray &frame);
 
     // main api variables
     QWebSocket m_socket;
@@ -60,6 +106,37 @@ private:
     quint16 m_port{9090};
     QTimer m_reconnectTimer;
 
+    // reconnect backoff : min(cap, base * 2^attempt) with jitter
+    static constexpr int kReconnectBaseMs = 500;
+    static constexpr int kReconnectCapMs  = 30000;
+    int m_reconnectAttempt{0};
+    bool m_reconnectEnabled{true};      // false after disconnectFromServer()
+
+    // subscription table ( namespaced topic -> msg type ), replayed on every connect
+    QHash<QString, QString> m_subscriptions;
+    QSet<QString> m_rawTopics;          // namespaced
+
+    // outbound queue : subscription ops are coalesced per topic ( desired vs on-wire state ),
+    // other frames are kept in order; everything goes out in one flush per event loop turn
+    static constexpr int kMaxOutboxFrames = 1024;
+    QHash<QString, QString> m_wireSubscriptions;
+    QStringList m_dirtyTopics;
+    QStringList m_outbox;
+    QTimer m_flushTimer;
+
+    // reconnect-to-first-message metric
+    QElapsedTimer m_outageClock;
+    QElapsedTimer m_reconnectClock;
+    bool m_awaitingFirstMessage{false};
+    qint64 m_lastReconnectLatencyMs{-1};
+    qint64 m_lastOutageMs{-1};
+
+    // receive / decode / dispatch stamps, owned by the client
+    LatencyTracer *m_tracer = nullptr;
+
+    // not owned
+    SessionRecorder *m_recorder = nullptr;
+
     
 };
 }
@@ -0,0 +1,134 @@
+#include "service_caller.hpp"
+#include "../design/rom_structures.h" // for ROM_COLOR_* macros
+
+#include <QDebug>
+
+using namespace rom_dynamics::data_types;
+
+rom_dynamics::communication::ServiceCaller::ServiceCaller(RosBridgeClient *client, int max_in_flight, QObject *parent)
+    : QObject(parent), m_client(client), m_maxInFlight(qMax(1, max_in_flight))
+{
+    m_clock.start();
+
+    // one timer for every deadline instead of one per call
+    m_timeoutTimer.setInterval(100);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, &ServiceCaller::sweepTimeouts);
+
+    if (m_client)
+    {
+        connect(m_client, &RosBridgeClient::serviceResponse, this, &ServiceCaller::onServiceResponse);
+        connect(m_client, &RosBridgeClient::disconnected, this, &ServiceCaller::onDisconnected);
+        connect(m_client, &RosBridgeClient::connected, this, &ServiceCaller::pump);
+    }
+}
+
+QString rom_dynamics::communication::ServiceCaller::call(const QString &service_name, const QJsonObject &args, Callback done, int timeout_ms)
+{
+    Pending pending;
+    pending.id = QStringLiteral("rom_svc_%1").arg(++m_seq);
+    pending.service = service_name;
+    pending.args = args;
+    pending.done = std::move(done);
+    pending.timeout_ms = timeout_ms;
+
+    const QString id = pending.id;
+    m_queue.append(pending);
+    pump();
+    return id;
+}
+
+void rom_dynamics::communication::ServiceCaller::setMaxInFlight(int max_in_flight)
+{
+    m_maxInFlight = qMax(1, max_in_flight);
+    pump();
+}
+
+void rom_dynamics::communication::ServiceCaller::cancelAll(const QString &reason)
+{
+    const QList<Pending> queued = m_queue;
+    const QList<Pending> in_flight = m_inFlight.values();
+    m_queue.clear();
+    m_inFlight.clear();
+    m_timeoutTimer.stop();
+
+    for (const Pending &pending : in_flight) finish(pending, false, QJsonObject(), reason);
+    for (const Pending &pending : queued) finish(pending, false, QJsonObject(), reason);
+}
+
+void rom_dynamics::communication::ServiceCaller::pump()
+{
+    if (!m_client || !m_client->isConnected()) return;
+
+    while (!m_queue.isEmpty() && m_inFlight.size() < m_maxInFlight)
+    {
+        Pending pending = m_queue.takeFirst();
+        pending.sent_ms = m_clock.elapsed();
+        m_inFlight.insert(pending.id, pending);
+        m_client->callService(pending.service, pending.args, pending.id);
+    }
+
+    if (!m_inFlight.isEmpty() && !m_timeoutTimer.isActive()) m_timeoutTimer.start();
+}
+
+void rom_dynamics::communication::ServiceCaller::onServiceResponse(const QString &id, const QString &service_name, bool result, const QJsonObject &values)
+{
+    Q_UNUSED(service_name);
+
+    // other callers ( LatencyTracer ) share the signal, their ids are not ours
+    auto it = m_inFlight.find(id);
+    if (it == m_inFlight.end()) return;
+
+    const Pending pending = it.value();
+    m_inFlight.erase(it);
+
+    finish(pending, result, values, result ? QString() : QStringLiteral("service call failed"));
+    pump();
+}
+
+void rom_dynamics::communication::ServiceCaller::onDisconnected()
+{
+    // answers to these can never arrive on the next connection; queued calls wait for it
+    const QList<Pending> in_flight = m_inFlight.values();
+    m_inFlight.clear();
+    for (const Pending &pending : in_flight) finish(pending, false, QJsonObject(), QStringLiteral("disconnected"));
+}
+
+void rom_dynamics::communication::ServiceCaller::sweepTimeouts()
+{
+    const qint64 now = m_clock.elapsed();
+
+    QList<Pending> expired;
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end();)
+    {
+        if (now - it->sent_ms >= it->timeout_ms)
+        {
+            expired.append(it.value());
+            it = m_inFlight.erase(it);
+        }
+        else ++it;
+    }
+    if (m_inFlight.isEmpty()) m_timeoutTimer.stop();
+
+    for (const Pending &pending : expired) finish(pending, false, QJsonObject(), QStringLiteral("timeout"));
+    if (!expired.isEmpty()) pump();
+}
+
+void rom_dynamics::communication::ServiceCaller::finish(Pending pending, bool ok, const QJsonObject &values, const QString &error)
+{
+    ServiceResult result;
+    result.id = pending.id;
+    result.service = pending.service;
+    result.ok = ok;
+    result.values = values;
+    result.error = error;
+    result.rtt_ms = pending.sent_ms >= 0 ? m_clock.elapsed() - pending.sent_ms : -1;
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[      ServiceCaller::finish      ] : %2 %3 %4 ms %5 %6")
+                              .arg(ROM_COLOR_GREEN).arg(result.service).arg(ok ? "ok" : "failed")
+                              .arg(result.rtt_ms).arg(error).arg(ROM_COLOR_RESET);
+    #endif
+
+    if (pending.done) pending.done(result);
+    emit finished(result);
+}
@@ -0,0 +1,84 @@
+#ifndef ROM_SERVICE_CALLER_HPP
+#define ROM_SERVICE_CALLER_HPP
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QJsonObject>
+#include <functional>
+
+#include "ros_bridge_client.hpp"
+
+namespace rom_dynamics::communication {
+
+struct ServiceResult {
+    QString id;
+    QString service;
+    bool ok = false;
+    QJsonObject values;
+    QString error;          // timeout, disconnect or the rosbridge error text
+    qint64 rtt_ms = -1;     // send -> response, -1 when it never went out
+};
+
+// call_service with request / response correlation on top of RosBridgeClient.
+// Every call gets its own id. At most maxInFlight() calls are on the wire, the
+// rest wait in FIFO order. A call without an answer fails after its timeout, and
+// every call in flight fails when the connection drops.
+class ServiceCaller : public QObject {
+    Q_OBJECT
+public:
+    using Callback = std::function<void(const ServiceResult &result)>;
+
+    static constexpr int kDefaultTimeoutMs = 5000;
+
+    explicit ServiceCaller(RosBridgeClient *client, int max_in_flight = 4, QObject *parent = nullptr);
+
+    // returns the correlation id; done runs exactly once
+    QString call(const QString &service_name, const QJsonObject &args,
+                 Callback done = {}, int timeout_ms = kDefaultTimeoutMs);
+
+    void setMaxInFlight(int max_in_flight);
+    int maxInFlight() const { return m_maxInFlight; }
+    int inFlight() const { return m_inFlight.size(); }
+    int queued() const { return m_queue.size(); }
+
+    void cancelAll(const QString &reason);
+
+signals:
+    void finished(const rom_dynamics::communication::ServiceResult &result);
+
+private slots:
+    void onServiceResponse(const QString &id, const QString &service_name, bool result, const QJsonObject &values);
+    void onDisconnected();
+    void pump();
+
+private:
+    struct Pending {
+        QString id;
+        QString service;
+        QJsonObject args;
+        Callback done;
+        int timeout_ms = kDefaultTimeoutMs;
+        qint64 sent_ms = -1;
+    };
+
+    void sweepTimeouts();
+    void finish(Pending pending, bool ok, const QJsonObject &values, const QString &error);
+
+    QPointer<RosBridgeClient> m_client;
+    int m_maxInFlight{4};
+    quint64 m_seq{0};
+    QList<Pending> m_queue;
+    QHash<QString, Pending> m_inFlight;
+    QTimer m_timeoutTimer;
+    QElapsedTimer m_clock;
+};
+}
+
+Q_DECLARE_METATYPE(rom_dynamics::communication::ServiceResult)
+
+#endif
@@ -0,0 +1,231 @@
+#include "session_capture.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QtEndian>
+
+#ifdef ROM_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+//================================================================================
+// 1. capture helpers
+//================================================================================
+
+rom_dynamics::communication::capture::Compression rom_dynamics::communication::capture::bestAvailableCompression()
+{
+#ifdef ROM_HAVE_ZSTD
+    return Compression::Zstd;
+#else
+    return Compression::Zlib;
+#endif
+}
+
+QByteArray rom_dynamics::communication::capture::compress(const QByteArray &raw, Compression compression)
+{
+    switch (compression)
+    {
+        case Compression::Zlib:
+            // qCompress prefixes 4 bytes of size, the chunk header already has it
+            return qCompress(raw, 3).mid(4);
+#ifdef ROM_HAVE_ZSTD
+        case Compression::Zstd:
+        {
+            QByteArray out(static_cast<int>(ZSTD_compressBound(raw.size())), Qt::Uninitialized);
+            const size_t n = ZSTD_compress(out.data(), out.size(), raw.constData(), raw.size(), 3);
+            if (ZSTD_isError(n)) return QByteArray();
+            out.truncate(static_cast<int>(n));
+            return out;
+        }
+#endif
+        default:
+            return raw;
+    }
+}
+
+QByteArray rom_dynamics::communication::capture::decompress(const QByteArray &stored, Compression compression, quint32 raw_size)
+{
+    switch (compression)
+    {
+        case Compression::None:
+            return stored;
+        case Compression::Zlib:
+        {
+            QByteArray prefixed(4, Qt::Uninitialized);
+            qToBigEndian(raw_size, prefixed.data());
+            prefixed += stored;
+            return qUncompress(prefixed);
+        }
+        case Compression::Zstd:
+        {
+#ifdef ROM_HAVE_ZSTD
+            QByteArray out(static_cast<int>(raw_size), Qt::Uninitialized);
+            const size_t n = ZSTD_decompress(out.data(), out.size(), stored.constData(), stored.size());
+            if (ZSTD_isError(n) || n != raw_size) return QByteArray();
+            return out;
+#else
+            qWarning() << "capture chunk is zstd compressed, but tuning_app was built without zstd";
+            return QByteArray();
+#endif
+        }
+    }
+    return QByteArray();
+}
+
+//================================================================================
+// 2. SessionRecorder
+//================================================================================
+
+rom_dynamics::communication::SessionRecorder::SessionRecorder(QObject *parent)
+    : QObject(parent)
+{
+    m_out.setByteOrder(QDataStream::LittleEndian);
+
+    m_flushTimer.setInterval(kChunkMaxAgeMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &SessionRecorder::flushAgedChunks);
+}
+
+rom_dynamics::communication::SessionRecorder::~SessionRecorder()
+{
+    close();
+}
+
+bool rom_dynamics::communication::SessionRecorder::open(const QString &file_path, capture::Compression compression)
+{
+    close();
+
+    m_file.setFileName(file_path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "SessionRecorder cannot open" << file_path << ":" << m_file.errorString();
+        return false;
+    }
+
+    m_out.setDevice(&m_file);
+    m_compression = compression;
+    m_topicIds.clear();
+    m_topicNames.clear();
+    m_pending.clear();
+    m_index.clear();
+    m_messages = 0;
+
+    m_out.writeRawData(capture::kFileMagic, 8);
+    m_out << capture::kVersion;
+    m_out << static_cast<qint64>(QDateTime::currentMSecsSinceEpoch() * 1000000LL);
+
+    m_clock.start();
+    m_flushTimer.start();
+    return true;
+}
+
+void rom_dynamics::communication::SessionRecorder::close()
+{
+    if (!m_file.isOpen()) return;
+
+    m_flushTimer.stop();
+    for (int id = 0; id < m_pending.size(); ++id)
+    {
+        flushChunk(static_cast<quint16>(id));
+    }
+
+    // trailer : chunk index + footer
+    const quint64 index_offset = static_cast<quint64>(m_file.pos());
+    m_out << capture::kIndexTag << static_cast<quint32>(m_topicNames.size());
+    for (const QString &topic : std::as_const(m_topicNames))
+    {
+        const QByteArray name = topic.toUtf8();
+        m_out << static_cast<quint16>(name.size());
+        m_out.writeRawData(name.constData(), name.size());
+    }
+    m_out << static_cast<quint32>(m_index.size());
+    for (const capture::ChunkIndexEntry &entry : std::as_const(m_index))
+    {
+        m_out << entry.offset << entry.topic_id << entry.first_ts_ns << entry.last_ts_ns << entry.count;
+    }
+    m_out << index_offset;
+    m_out.writeRawData(capture::kFooterMagic, 8);
+
+    m_out.setDevice(nullptr);
+    m_file.close();
+}
+
+quint16 rom_dynamics::communication::SessionRecorder::topicId(const QString &topic)
+{
+    auto it = m_topicIds.constFind(topic);
+    if (it != m_topicIds.constEnd()) return it.value();
+
+    const quint16 id = static_cast<quint16>(m_topicIds.size());
+    m_topicIds.insert(topic, id);
+    m_topicNames.append(topic);
+    m_pending.append(PendingChunk{});
+
+    // topic table lives inline so a file without trailer can still be read
+    const QByteArray name = topic.toUtf8();
+    m_out << capture::kTopicTag << id << static_cast<quint16>(name.size());
+    m_out.writeRawData(name.constData(), name.size());
+    return id;
+}
+
+void rom_dynamics::communication::SessionRecorder::record(const QString &topic, const QByteArray &frame)
+{
+    if (!m_file.isOpen()) return;
+
+    const qint64 ts = m_clock.nsecsElapsed();
+    const quint16 id = topicId(topic);
+    PendingChunk &chunk = m_pending[id];
+
+    if (chunk.first_ts_ns < 0) chunk.first_ts_ns = ts;
+    chunk.last_ts_ns = ts;
+    ++chunk.count;
+
+    char head[12];
+    qToLittleEndian(ts, head);
+    qToLittleEndian(static_cast<quint32>(frame.size()), head + 8);
+    chunk.payload.append(head, sizeof(head));
+    chunk.payload.append(frame);
+    ++m_messages;
+
+    if (chunk.payload.size() >= kChunkMaxBytes)
+    {
+        flushChunk(id);
+    }
+}
+
+void rom_dynamics::communication::SessionRecorder::flushChunk(quint16 topic_id)
+{
+    PendingChunk &chunk = m_pending[topic_id];
+    if (chunk.count == 0) return;
+
+    const QByteArray stored = capture::compress(chunk.payload, m_compression);
+    const capture::Compression used = stored.isEmpty() ? capture::Compression::None : m_compression;
+    const QByteArray &body = stored.isEmpty() ? chunk.payload : stored;
+
+    capture::ChunkIndexEntry entry;
+    entry.offset = static_cast<quint64>(m_file.pos());
+    entry.topic_id = topic_id;
+    entry.first_ts_ns = chunk.first_ts_ns;
+    entry.last_ts_ns = chunk.last_ts_ns;
+    entry.count = chunk.count;
+    m_index.append(entry);
+
+    m_out << capture::kChunkTag << topic_id << static_cast<quint8>(used) << static_cast<quint8>(0)
+          << chunk.count << chunk.first_ts_ns << chunk.last_ts_ns
+          << static_cast<quint32>(chunk.payload.size()) << static_cast<quint32>(body.size());
+    m_out.writeRawData(body.constData(), body.size());
+    m_file.flush();
+
+    chunk = PendingChunk{};
+}
+
+void rom_dynamics::communication::SessionRecorder::flushAgedChunks()
+{
+    const qint64 now = m_clock.nsecsElapsed();
+    for (int id = 0; id < m_pending.size(); ++id)
+    {
+        const PendingChunk &chunk = m_pending[id];
+        if (chunk.count > 0 && now - chunk.first_ts_ns >= qint64(kChunkMaxAgeMs) * 1000000LL)
+        {
+            flushChunk(static_cast<quint16>(id));
+        }
+    }
+}
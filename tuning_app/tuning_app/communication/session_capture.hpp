@@ -0,0 +1,103 @@
+#ifndef ROM_SESSION_CAPTURE_HPP
+#define ROM_SESSION_CAPTURE_HPP
+
+#pragma once
+#include <QObject>
+#include <QFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+#include <QStringList>
+
+namespace rom_dynamics::communication {
+
+// ROMCAP capture file ( little endian )
+//
+//   header : "ROMCAP01" | u32 version | i64 start wall clock [ns]
+//   records, append only :
+//     TOPC : u16 topic id | u16 len | topic utf8
+//     CHNK : u16 topic id | u8 compression | u8 reserved | u32 count
+//            | i64 first ts | i64 last ts | u32 raw size | u32 stored size | payload
+//            payload ( after decompression ) = count x ( i64 ts | u32 len | rosbridge publish frame )
+//   trailer ( written by close(), missing after a crash -> reader rescans the records ) :
+//     INDX : u32 topic count | count x ( u16 len | topic utf8 )
+//            | u32 chunk count | count x ( u64 offset | u16 topic id | i64 first ts | i64 last ts | u32 count )
+//     u64 index offset | "ROMCAPIX"
+//
+// Timestamps are nanoseconds since the start of the recording.
+namespace capture {
+    inline constexpr char kFileMagic[]   = "ROMCAP01";
+    inline constexpr char kFooterMagic[] = "ROMCAPIX";
+    inline constexpr quint32 kVersion    = 1;
+    inline constexpr quint32 kTopicTag   = 0x43504F54; // "TOPC"
+    inline constexpr quint32 kChunkTag   = 0x4B4E4843; // "CHNK"
+    inline constexpr quint32 kIndexTag   = 0x58444E49; // "INDX"
+    inline constexpr int kHeaderSize     = 8 + 4 + 8;
+    inline constexpr int kFooterSize     = 8 + 8;
+
+    enum class Compression : quint8 { None = 0, Zlib = 1, Zstd = 2 };
+
+    struct ChunkIndexEntry {
+        quint64 offset = 0;             // file offset of the CHNK tag
+        quint16 topic_id = 0;
+        qint64 first_ts_ns = 0;
+        qint64 last_ts_ns = 0;
+        quint32 count = 0;
+    };
+
+    Compression bestAvailableCompression();
+    QByteArray compress(const QByteArray &raw, Compression compression);
+    QByteArray decompress(const QByteArray &stored, Compression compression, quint32 raw_size);
+}
+
+// Writes every received rosbridge publish frame into a ROMCAP file.
+// Frames are buffered per topic and written as one ( compressed ) chunk when the
+// buffer is full or older than kChunkMaxAgeMs.
+class SessionRecorder : public QObject {
+    Q_OBJECT
+public:
+    explicit SessionRecorder(QObject *parent = nullptr);
+    ~SessionRecorder() override;
+
+    bool open(const QString &file_path, capture::Compression compression = capture::bestAvailableCompression());
+    void close();
+    bool isRecording() const { return m_file.isOpen(); }
+
+    void record(const QString &topic, const QByteArray &frame);
+
+    quint64 messageCount() const { return m_messages; }
+    qint64 bytesWritten() const { return m_file.isOpen() ? m_file.pos() : 0; }
+
+private:
+    static constexpr int kChunkMaxBytes  = 256 * 1024;
+    static constexpr int kChunkMaxAgeMs  = 1000;
+
+    struct PendingChunk {
+        QByteArray payload;
+        quint32 count = 0;
+        qint64 first_ts_ns = -1;
+        qint64 last_ts_ns = 0;
+    };
+
+    quint16 topicId(const QString &topic);
+    void flushChunk(quint16 topic_id);
+    void flushAgedChunks();
+
+    QFile m_file;
+    QDataStream m_out;
+    QElapsedTimer m_clock;
+    capture::Compression m_compression{capture::Compression::None};
+
+    QHash<QString, quint16> m_topicIds;
+    QStringList m_topicNames;           // indexed by topic id
+    QList<PendingChunk> m_pending;      // indexed by topic id
+    QList<capture::ChunkIndexEntry> m_index;
+    QTimer m_flushTimer;
+    quint64 m_messages{0};
+};
+}
+
+#endif
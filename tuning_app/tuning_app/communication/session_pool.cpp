@@ -0,0 +1,216 @@
+#include "session_pool.hpp"
+#include "ros_bridge_client.hpp"
+#include "../design/rom_structures.h" // for ROM_COLOR_* macros
+
+#include <QDebug>
+
+//================================================================================
+// 1. RobotSession ( worker thread )
+//================================================================================
+
+rom_dynamics::communication::RobotSession::RobotSession(const QString &key, const QString &robot_ns, const QString &host, quint16 port, double max_rate_hz)
+    : QObject(nullptr)
+    , m_key(key)
+    , m_robotNamespace(robot_ns)
+    , m_host(host)
+    , m_port(port)
+    , m_maxRateHz(max_rate_hz)
+{
+}
+
+void rom_dynamics::communication::RobotSession::start()
+{
+    // created here so the socket, its timers and the JSON decode belong to the worker thread
+    m_client = new RosBridgeClient(m_robotNamespace, m_host, m_port, this);
+    connect(m_client, &RosBridgeClient::receivedTopicMessage, this, &RobotSession::onClientMessage);
+    connect(m_client, &RosBridgeClient::connected, this, [this]() { emit connectionChanged(m_key, true); });
+    connect(m_client, &RosBridgeClient::disconnected, this, [this]() { emit connectionChanged(m_key, false); });
+
+    m_flushTimer = new QTimer(this);
+    connect(m_flushTimer, &QTimer::timeout, this, &RobotSession::flushPending);
+    setMaxRate(m_maxRateHz);
+}
+
+void rom_dynamics::communication::RobotSession::stop()
+{
+    if (m_flushTimer) m_flushTimer->stop();
+    if (m_client) m_client->disconnectFromServer();
+    m_pending.clear();
+}
+
+void rom_dynamics::communication::RobotSession::subscribeTopic(const QString &topic_name, const QString &msg_type)
+{
+    if (m_client) m_client->subscribeTopic(topic_name, msg_type);
+}
+
+void rom_dynamics::communication::RobotSession::unsubscribeTopic(const QString &topic_name)
+{
+    if (m_client) m_client->unsubscribeTopic(topic_name);
+    m_pending.remove(topic_name);
+}
+
+void rom_dynamics::communication::RobotSession::setMaxRate(double max_rate_hz)
+{
+    m_maxRateHz = qBound(1.0, max_rate_hz, 1000.0);
+    if (m_flushTimer)
+    {
+        m_flushTimer->start(qMax(1, qRound(1000.0 / m_maxRateHz)));
+    }
+}
+
+void rom_dynamics::communication::RobotSession::onClientMessage(const QString &topic_name, const QJsonObject &msg)
+{
+    m_received.fetch_add(1, std::memory_order_relaxed);
+
+    // ui side matches topics without the robot namespace, like the main client
+    QString topic = topic_name;
+    if (!m_robotNamespace.isEmpty() && topic.startsWith(m_robotNamespace))
+    {
+        topic.remove(0, m_robotNamespace.size());
+    }
+    m_pending.insert(topic, msg);
+}
+
+void rom_dynamics::communication::RobotSession::flushPending()
+{
+    if (m_pending.isEmpty()) return;
+
+    for (auto it = m_pending.constBegin(); it != m_pending.constEnd(); ++it)
+    {
+        emit receivedTopicMessage(m_key, it.key(), it.value());
+    }
+    m_forwarded.fetch_add(m_pending.size(), std::memory_order_relaxed);
+    m_pending.clear();
+}
+
+//================================================================================
+// 2. RobotSessionPool ( ui thread )
+//================================================================================
+
+rom_dynamics::communication::RobotSessionPool::RobotSessionPool(QObject *parent)
+    : QObject(parent)
+{
+}
+
+rom_dynamics::communication::RobotSessionPool::~RobotSessionPool()
+{
+    clear();
+}
+
+QString rom_dynamics::communication::RobotSessionPool::sessionKey(const QString &robot_ns, const QString &host, quint16 port)
+{
+    return QString("%1@%2:%3").arg(robot_ns, host).arg(port);
+}
+
+QString rom_dynamics::communication::RobotSessionPool::addSession(const QString &robot_ns, const QString &host, quint16 port)
+{
+    const QString key = sessionKey(robot_ns, host, port);
+    if (m_sessions.contains(key)) return key;
+
+    Worker worker;
+    worker.thread = new QThread(this);
+    worker.thread->setObjectName("rom session " + key);
+    worker.session = new RobotSession(key, robot_ns, host, port, m_maxRateHz);
+    worker.session->moveToThread(worker.thread);
+
+    connect(worker.thread, &QThread::started, worker.session, &RobotSession::start);
+    connect(worker.thread, &QThread::finished, worker.session, &QObject::deleteLater);
+
+    // queued : emitted from the worker thread
+    connect(worker.session, &RobotSession::receivedTopicMessage, this, &RobotSessionPool::receivedTopicMessage);
+    connect(worker.session, &RobotSession::connectionChanged, this, &RobotSessionPool::sessionConnectionChanged);
+
+    worker.thread->start();
+
+    // start() is queued ahead of these, so the client exists when they run
+    RobotSession *session = worker.session;
+    for (auto it = m_topics.constBegin(); it != m_topics.constEnd(); ++it)
+    {
+        QMetaObject::invokeMethod(session, [session, topic = it.key(), type = it.value()]() {
+            session->subscribeTopic(topic, type);
+        }, Qt::QueuedConnection);
+    }
+
+    m_sessions.insert(key, worker);
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[    RobotSessionPool::addSession    ] : %2 ( %3 sessions )%4")
+                              .arg(ROM_COLOR_GREEN).arg(key).arg(m_sessions.size()).arg(ROM_COLOR_RESET);
+    #endif
+    return key;
+}
+
+void rom_dynamics::communication::RobotSessionPool::removeSession(const QString &session_key)
+{
+    auto it = m_sessions.find(session_key);
+    if (it == m_sessions.end()) return;
+
+    Worker worker = it.value();
+    m_sessions.erase(it);
+
+    QMetaObject::invokeMethod(worker.session, &RobotSession::stop, Qt::BlockingQueuedConnection);
+    worker.thread->quit();
+    worker.thread->wait();
+    delete worker.thread;   // session went with QThread::finished -> deleteLater
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[   RobotSessionPool::removeSession   ] : %2%3")
+                              .arg(ROM_COLOR_GREEN).arg(session_key).arg(ROM_COLOR_RESET);
+    #endif
+}
+
+void rom_dynamics::communication::RobotSessionPool::clear()
+{
+    const QStringList keys = m_sessions.keys();
+    for (const QString &key : keys)
+    {
+        removeSession(key);
+    }
+}
+
+void rom_dynamics::communication::RobotSessionPool::subscribeAll(const QString &topic_name, const QString &msg_type)
+{
+    m_topics.insert(topic_name, msg_type);
+    for (const Worker &worker : std::as_const(m_sessions))
+    {
+        RobotSession *session = worker.session;
+        QMetaObject::invokeMethod(session, [session, topic_name, msg_type]() {
+            session->subscribeTopic(topic_name, msg_type);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void rom_dynamics::communication::RobotSessionPool::unsubscribeAll(const QString &topic_name)
+{
+    m_topics.remove(topic_name);
+    for (const Worker &worker : std::as_const(m_sessions))
+    {
+        RobotSession *session = worker.session;
+        QMetaObject::invokeMethod(session, [session, topic_name]() {
+            session->unsubscribeTopic(topic_name);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void rom_dynamics::communication::RobotSessionPool::setMaxRate(double max_rate_hz)
+{
+    m_maxRateHz = max_rate_hz;
+    for (const Worker &worker : std::as_const(m_sessions))
+    {
+        RobotSession *session = worker.session;
+        QMetaObject::invokeMethod(session, [session, max_rate_hz]() {
+            session->setMaxRate(max_rate_hz);
+        }, Qt::QueuedConnection);
+    }
+}
+
+quint64 rom_dynamics::communication::RobotSessionPool::receivedCount(const QString &session_key) const
+{
+    auto it = m_sessions.constFind(session_key);
+    return it == m_sessions.constEnd() ? 0 : it->session->receivedCount();
+}
+
+quint64 rom_dynamics::communication::RobotSessionPool::forwardedCount(const QString &session_key) const
+{
+    auto it = m_sessions.constFind(session_key);
+    return it == m_sessions.constEnd() ? 0 : it->session->forwardedCount();
+}
@@ -0,0 +1,108 @@
+#ifndef ROM_SESSION_POOL_HPP
+#define ROM_SESSION_POOL_HPP
+
+#pragma once
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QHash>
+#include <QStringList>
+#include <QJsonObject>
+#include <atomic>
+
+namespace rom_dynamics::communication {
+
+class RosBridgeClient;
+
+// One extra robot. Lives on its own QThread: the RosBridgeClient ( socket, JSON decode )
+// is created inside that thread, so parsing never touches the ui thread.
+// Messages are coalesced per topic ( latest wins ) and forwarded at most max_rate_hz
+// times per second, which bounds the ui thread cost per session.
+class RobotSession : public QObject {
+    Q_OBJECT
+public:
+    RobotSession(const QString &key, const QString &robot_ns, const QString &host, quint16 port, double max_rate_hz);
+
+    const QString &key() const { return m_key; }
+
+    // written by the worker, read by the ui
+    quint64 receivedCount() const { return m_received.load(std::memory_order_relaxed); }
+    quint64 forwardedCount() const { return m_forwarded.load(std::memory_order_relaxed); }
+
+public slots:
+    // worker thread only ( queued from RobotSessionPool )
+    void start();
+    void stop();
+    void subscribeTopic(const QString &topic_name, const QString &msg_type);
+    void unsubscribeTopic(const QString &topic_name);
+    void setMaxRate(double max_rate_hz);
+
+signals:
+    // topic_name is relative to the session namespace
+    void receivedTopicMessage(const QString &session_key, const QString &topic_name, const QJsonObject &msg);
+    void connectionChanged(const QString &session_key, bool connected);
+
+private:
+    void onClientMessage(const QString &topic_name, const QJsonObject &msg);
+    void flushPending();
+
+    QString m_key;
+    QString m_robotNamespace;
+    QString m_host;
+    quint16 m_port{9090};
+    double m_maxRateHz{30.0};
+
+    RosBridgeClient *m_client = nullptr;
+    QTimer *m_flushTimer = nullptr;
+    QHash<QString, QJsonObject> m_pending;  // latest message per topic since the last flush
+
+    std::atomic<quint64> m_received{0};
+    std::atomic<quint64> m_forwarded{0};
+};
+
+// Pool of RobotSessions keyed by namespace@host:port, used to overlay several robots
+// next to the main RosBridgeClient. Topic subscriptions are pool wide and replayed
+// to sessions added later.
+class RobotSessionPool : public QObject {
+    Q_OBJECT
+public:
+    explicit RobotSessionPool(QObject *parent = nullptr);
+    ~RobotSessionPool() override;
+
+    static QString sessionKey(const QString &robot_ns, const QString &host, quint16 port);
+
+    QString addSession(const QString &robot_ns, const QString &host, quint16 port);
+    void removeSession(const QString &session_key);
+    void clear();
+
+    bool contains(const QString &session_key) const { return m_sessions.contains(session_key); }
+    QStringList sessions() const { return m_sessions.keys(); }
+    int size() const { return m_sessions.size(); }
+
+    void subscribeAll(const QString &topic_name, const QString &msg_type);
+    void unsubscribeAll(const QString &topic_name);
+
+    // per session, per topic forward rate into the ui thread
+    void setMaxRate(double max_rate_hz);
+    double maxRate() const { return m_maxRateHz; }
+
+    quint64 receivedCount(const QString &session_key) const;
+    quint64 forwardedCount(const QString &session_key) const;
+
+signals:
+    void receivedTopicMessage(const QString &session_key, const QString &topic_name, const QJsonObject &msg);
+    void sessionConnectionChanged(const QString &session_key, bool connected);
+
+private:
+    struct Worker {
+        QThread *thread = nullptr;
+        RobotSession *session = nullptr;
+    };
+
+    QHash<QString, Worker> m_sessions;
+    QHash<QString, QString> m_topics;       // topic -> msg type, replayed to new sessions
+    double m_maxRateHz{30.0};
+};
+}
+
+#endif
@@ -0,0 +1,348 @@
+#include "session_replay.hpp"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+rom_dynamics::communication::SessionReplay::SessionReplay(QObject *parent)
+    : QObject(parent)
+{
+    m_tickTimer.setTimerType(Qt::PreciseTimer);
+    m_tickTimer.setInterval(kTickMs);
+    connect(&m_tickTimer, &QTimer::timeout, this, &SessionReplay::onTick);
+}
+
+bool rom_dynamics::communication::SessionReplay::open(const QString &file_path)
+{
+    close();
+
+    m_file.setFileName(file_path);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "SessionReplay cannot open" << file_path << ":" << m_file.errorString();
+        return false;
+    }
+
+    char magic[8];
+    if (m_file.read(magic, 8) != 8 || memcmp(magic, capture::kFileMagic, 8) != 0)
+    {
+        qWarning() << "SessionReplay :" << file_path << "is not a ROMCAP file";
+        m_file.close();
+        return false;
+    }
+
+    // recorder killed before close() -> no trailer, walk the records instead
+    if (!readIndexFromFooter() && !rebuildIndexByScan())
+    {
+        m_file.close();
+        return false;
+    }
+
+    std::sort(m_chunks.begin(), m_chunks.end(), [](const Chunk &a, const Chunk &b) {
+        return a.index.first_ts_ns < b.index.first_ts_ns;
+    });
+
+    m_cursors.clear();
+    m_cursors.resize(m_topics.size());
+    m_duration = 0;
+    m_totalMessages = 0;
+    for (int i = 0; i < m_chunks.size(); ++i)
+    {
+        const capture::ChunkIndexEntry &entry = m_chunks[i].index;
+        if (entry.topic_id >= m_cursors.size()) continue;
+        m_cursors[entry.topic_id].chunks.append(i);
+        m_duration = qMax(m_duration, entry.last_ts_ns);
+        m_totalMessages += entry.count;
+    }
+
+    seek(0);
+    return true;
+}
+
+void rom_dynamics::communication::SessionReplay::close()
+{
+    pause();
+    m_file.close();
+    m_topics.clear();
+    m_chunks.clear();
+    m_cursors.clear();
+    m_position = 0;
+    m_duration = 0;
+    m_totalMessages = 0;
+}
+
+bool rom_dynamics::communication::SessionReplay::readIndexFromFooter()
+{
+    const qint64 size = m_file.size();
+    if (size < capture::kHeaderSize + capture::kFooterSize) return false;
+
+    QDataStream in(&m_file);
+    in.setByteOrder(QDataStream::LittleEndian);
+
+    m_file.seek(size - capture::kFooterSize);
+    quint64 index_offset = 0;
+    char magic[8];
+    in >> index_offset;
+    if (in.readRawData(magic, 8) != 8 || memcmp(magic, capture::kFooterMagic, 8) != 0) return false;
+    if (index_offset < quint64(capture::kHeaderSize) || index_offset >= quint64(size)) return false;
+
+    m_file.seek(static_cast<qint64>(index_offset));
+    quint32 tag = 0, topic_count = 0, chunk_count = 0;
+    in >> tag >> topic_count;
+    if (tag != capture::kIndexTag) return false;
+
+    QStringList topics;
+    for (quint32 i = 0; i < topic_count && in.status() == QDataStream::Ok; ++i)
+    {
+        quint16 len = 0;
+        in >> len;
+        QByteArray name(len, Qt::Uninitialized);
+        in.readRawData(name.data(), len);
+        topics.append(QString::fromUtf8(name));
+    }
+
+    in >> chunk_count;
+    QList<Chunk> chunks;
+    chunks.reserve(chunk_count);
+    for (quint32 i = 0; i < chunk_count && in.status() == QDataStream::Ok; ++i)
+    {
+        Chunk chunk;
+        in >> chunk.index.offset >> chunk.index.topic_id >> chunk.index.first_ts_ns
+           >> chunk.index.last_ts_ns >> chunk.index.count;
+        chunks.append(chunk);
+    }
+    if (in.status() != QDataStream::Ok) return false;
+
+    m_topics = topics;
+    m_chunks = chunks;
+    return true;
+}
+
+bool rom_dynamics::communication::SessionReplay::rebuildIndexByScan()
+{
+    QDataStream in(&m_file);
+    in.setByteOrder(QDataStream::LittleEndian);
+    m_file.seek(capture::kHeaderSize);
+
+    m_topics.clear();
+    m_chunks.clear();
+
+    while (!m_file.atEnd())
+    {
+        const qint64 record_offset = m_file.pos();
+        quint32 tag = 0;
+        in >> tag;
+        if (in.status() != QDataStream::Ok) break;
+
+        if (tag == capture::kTopicTag)
+        {
+            quint16 id = 0, len = 0;
+            in >> id >> len;
+            QByteArray name(len, Qt::Uninitialized);
+            if (in.readRawData(name.data(), len) != len) break;
+            while (m_topics.size() <= id) m_topics.append(QString());
+            m_topics[id] = QString::fromUtf8(name);
+        }
+        else if (tag == capture::kChunkTag)
+        {
+            Chunk chunk;
+            quint8 compression = 0, reserved = 0;
+            quint32 raw_size = 0, stored_size = 0;
+            in >> chunk.index.topic_id >> compression >> reserved >> chunk.index.count
+               >> chunk.index.first_ts_ns >> chunk.index.last_ts_ns >> raw_size >> stored_size;
+            if (in.status() != QDataStream::Ok) break;
+
+            // chunk cut short by a crash -> drop it and everything after
+            if (m_file.pos() + stored_size > m_file.size()) break;
+            m_file.seek(m_file.pos() + stored_size);
+
+            chunk.index.offset = static_cast<quint64>(record_offset);
+            m_chunks.append(chunk);
+        }
+        else
+        {
+            break;  // INDX or garbage
+        }
+    }
+
+    if (m_topics.isEmpty())
+    {
+        qWarning() << "SessionReplay :" << m_file.fileName() << "contains no topics";
+        return false;
+    }
+    return true;
+}
+
+bool rom_dynamics::communication::SessionReplay::loadChunk(TopicCursor &cursor)
+{
+    cursor.payload.clear();
+    cursor.offset = 0;
+    cursor.remaining = 0;
+    cursor.next_ts = -1;
+
+    while (cursor.chunk_pos < cursor.chunks.size())
+    {
+        const capture::ChunkIndexEntry &entry = m_chunks[cursor.chunks[cursor.chunk_pos++]].index;
+
+        QDataStream in(&m_file);
+        in.setByteOrder(QDataStream::LittleEndian);
+        m_file.seek(static_cast<qint64>(entry.offset));
+
+        quint32 tag = 0, count = 0, raw_size = 0, stored_size = 0;
+        quint16 topic_id = 0;
+        quint8 compression = 0, reserved = 0;
+        qint64 first_ts = 0, last_ts = 0;
+        in >> tag >> topic_id >> compression >> reserved >> count >> first_ts >> last_ts >> raw_size >> stored_size;
+        if (in.status() != QDataStream::Ok || tag != capture::kChunkTag) continue;
+
+        const QByteArray stored = m_file.read(stored_size);
+        cursor.payload = capture::decompress(stored, static_cast<capture::Compression>(compression), raw_size);
+        if (cursor.payload.size() != int(raw_size) || count == 0) continue;
+
+        cursor.remaining = static_cast<int>(count);
+        cursor.next_ts = qFromLittleEndian<qint64>(cursor.payload.constData());
+        return true;
+    }
+    return false;
+}
+
+void rom_dynamics::communication::SessionReplay::advance(TopicCursor &cursor)
+{
+    const quint32 len = qFromLittleEndian<quint32>(cursor.payload.constData() + cursor.offset + 8);
+    cursor.offset += 12 + static_cast<int>(len);
+
+    if (--cursor.remaining > 0 && cursor.offset + 12 <= cursor.payload.size())
+    {
+        cursor.next_ts = qFromLittleEndian<qint64>(cursor.payload.constData() + cursor.offset);
+        return;
+    }
+    loadChunk(cursor);
+}
+
+int rom_dynamics::communication::SessionReplay::nextCursor() const
+{
+    // a handful of topics -> linear scan beats a heap
+    int best = -1;
+    qint64 best_ts = 0;
+    for (int i = 0; i < m_cursors.size(); ++i)
+    {
+        const qint64 ts = m_cursors[i].next_ts;
+        if (ts >= 0 && (best < 0 || ts < best_ts))
+        {
+            best = i;
+            best_ts = ts;
+        }
+    }
+    return best;
+}
+
+void rom_dynamics::communication::SessionReplay::emitFrame(int topic_id, const char *frame, int size)
+{
+    // payload is the raw rosbridge publish frame, decode it exactly like the live client
+    const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(frame, size));
+    if (!doc.isObject()) return;
+
+    emit receivedTopicMessage(m_topics.value(topic_id), doc.object().value("msg").toObject());
+    ++m_runMessages;
+}
+
+void rom_dynamics::communication::SessionReplay::play()
+{
+    if (!m_file.isOpen() || m_playing) return;
+    if (nextCursor() < 0) seek(0);
+
+    m_playing = true;
+    m_runMessages = 0;
+    m_runClock.start();
+    restartClock();
+
+    m_tickTimer.setInterval(m_speed > 0.0 ? kTickMs : 0);
+    m_tickTimer.start();
+}
+
+void rom_dynamics::communication::SessionReplay::pause()
+{
+    m_playing = false;
+    m_tickTimer.stop();
+}
+
+void rom_dynamics::communication::SessionReplay::setSpeed(double speed)
+{
+    m_speed = qMax(0.0, speed);
+    restartClock();
+    if (m_playing) m_tickTimer.setInterval(m_speed > 0.0 ? kTickMs : 0);
+}
+
+void rom_dynamics::communication::SessionReplay::restartClock()
+{
+    m_wallOriginTs = m_position;
+    m_wall.start();
+    m_positionClock.start();
+}
+
+void rom_dynamics::communication::SessionReplay::seek(qint64 ts_ns)
+{
+    if (!m_file.isOpen()) return;
+    ts_ns = qBound<qint64>(0, ts_ns, m_duration);
+
+    for (TopicCursor &cursor : m_cursors)
+    {
+        // first chunk that still has messages at or after ts_ns
+        cursor.chunk_pos = 0;
+        while (cursor.chunk_pos < cursor.chunks.size()
+               && m_chunks[cursor.chunks[cursor.chunk_pos]].index.last_ts_ns < ts_ns)
+        {
+            ++cursor.chunk_pos;
+        }
+
+        if (!loadChunk(cursor)) continue;
+        while (cursor.next_ts >= 0 && cursor.next_ts < ts_ns) advance(cursor);
+    }
+
+    m_position = ts_ns;
+    restartClock();
+    emit positionChanged(m_position);
+}
+
+void rom_dynamics::communication::SessionReplay::onTick()
+{
+    const qint64 target = m_speed > 0.0
+        ? m_wallOriginTs + static_cast<qint64>(m_wall.nsecsElapsed() * m_speed)
+        : std::numeric_limits<qint64>::max();
+
+    int emitted = 0;
+    int id = nextCursor();
+    while (id >= 0 && emitted < kMaxBatch)
+    {
+        TopicCursor &cursor = m_cursors[id];
+        if (cursor.next_ts > target) break;
+
+        const quint32 len = qFromLittleEndian<quint32>(cursor.payload.constData() + cursor.offset + 8);
+        m_position = cursor.next_ts;
+        emitFrame(id, cursor.payload.constData() + cursor.offset + 12, static_cast<int>(len));
+        advance(cursor);
+
+        ++emitted;
+        id = nextCursor();
+    }
+
+    if (m_positionClock.elapsed() >= kPositionEveryMs || id < 0)
+    {
+        m_positionClock.restart();
+        emit positionChanged(m_position);
+    }
+
+    if (id < 0)
+    {
+        pause();
+        if (m_speed == 0.0)
+        {
+            emit throughputMeasured(m_runMessages, m_runClock.nsecsElapsed() / 1e9);
+        }
+        emit finished();
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef ROM_SESSION_REPLAY_HPP
+#define ROM_SESSION_REPLAY_HPP
+
+#pragma once
+#include "session_capture.hpp"
+
+#include <QObject>
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QStringList>
+#include <QList>
+
+namespace rom_dynamics::communication {
+
+// Plays a ROMCAP file back through the same signal RosBridgeClient uses,
+// so MainWindow::onReceivedTopicMessage cannot tell a replay from a robot.
+//   speed 1.0 / N   : paced against the wall clock
+//   speed 0         : as fast as possible ( batches per event loop turn ), doubles as a throughput benchmark
+class SessionReplay : public QObject {
+    Q_OBJECT
+public:
+    explicit SessionReplay(QObject *parent = nullptr);
+
+    bool open(const QString &file_path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void play();
+    void pause();
+    bool isPlaying() const { return m_playing; }
+
+    void setSpeed(double speed);
+    double speed() const { return m_speed; }
+
+    // jump to a capture time, nanoseconds from the start of the recording
+    void seek(qint64 ts_ns);
+
+    qint64 position() const { return m_position; }
+    qint64 duration() const { return m_duration; }
+    quint64 messageCount() const { return m_totalMessages; }
+    const QStringList &topics() const { return m_topics; }
+
+signals:
+    void receivedTopicMessage(const QString &topic_name, const QJsonObject &msg);
+    void positionChanged(qint64 ts_ns);
+    void finished();
+    // as-fast-as-possible runs report decode + dispatch throughput when they reach the end
+    void throughputMeasured(quint64 messages, double seconds);
+
+private slots:
+    void onTick();
+
+private:
+    static constexpr int kTickMs          = 5;
+    static constexpr int kMaxBatch        = 1000;
+    static constexpr int kPositionEveryMs = 50;
+
+    struct Chunk {
+        capture::ChunkIndexEntry index;
+    };
+
+    // merge cursor over the chunks of one topic; one decompressed chunk at a time
+    struct TopicCursor {
+        QList<int> chunks;              // into m_chunks, sorted by first ts
+        int chunk_pos = 0;              // next chunk to load
+        QByteArray payload;
+        int offset = 0;
+        int remaining = 0;              // messages left in payload
+        qint64 next_ts = -1;            // -1 -> exhausted
+    };
+
+    bool readIndexFromFooter();
+    bool rebuildIndexByScan();
+    bool loadChunk(TopicCursor &cursor);
+    void advance(TopicCursor &cursor);
+    int nextCursor() const;
+    void emitFrame(int topic_id, const char *frame, int size);
+    void restartClock();
+
+    QFile m_file;
+    QStringList m_topics;               // indexed by topic id
+    QList<Chunk> m_chunks;
+    QList<TopicCursor> m_cursors;
+
+    QTimer m_tickTimer;
+    QElapsedTimer m_wall;
+    QElapsedTimer m_positionClock;
+    qint64 m_wallOriginTs{0};           // capture time at m_wall start
+    qint64 m_position{0};
+    qint64 m_duration{0};
+    double m_speed{1.0};
+    bool m_playing{false};
+
+    quint64 m_totalMessages{0};
+    quint64 m_runMessages{0};
+    QElapsedTimer m_runClock;
+};
+}
+
+#endif
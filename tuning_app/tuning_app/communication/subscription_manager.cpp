@@ -0,0 +1,119 @@
+#include "subscription_manager.hpp"
+#include "../design/rom_structures.h" // for ROM_COLOR_* macros
+
+#include <QDebug>
+
+using namespace rom_dynamics::data_types;
+
+rom_dynamics::communication::SubscriptionManager::SubscriptionManager(RosBridgeClient *client, int grace_period_ms, QObject *parent)
+    : QObject(parent), m_client(client), m_gracePeriodMs(grace_period_ms)
+{
+    m_clock.start();
+
+    // idle topics are checked periodically instead of one timer per topic
+    m_sweepTimer.setInterval(qMax(250, m_gracePeriodMs / 4));
+    connect(&m_sweepTimer, &QTimer::timeout, this, &SubscriptionManager::sweepIdleTopics);
+}
+
+void rom_dynamics::communication::SubscriptionManager::acquire(const QString &owner, const QString &topic_name, const QString &msg_type)
+{
+    TopicEntry &entry = m_topics[topic_name];
+    entry.msg_type = msg_type;
+    entry.owners.insert(owner);
+    entry.idle_since_ms = -1;
+
+    // already alive on rosbridge ( held by another tab or still in grace ) -> nothing to send
+    if (entry.subscribed) return;
+
+    if (m_client)
+    {
+        m_client->subscribeTopic(topic_name, msg_type);
+        entry.subscribed = true;
+    }
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[      SubscriptionManager::acquire      ] : %2 by %3 %4")
+                              .arg(ROM_COLOR_CYAN).arg(topic_name).arg(owner).arg(ROM_COLOR_RESET);
+    #endif
+}
+
+void rom_dynamics::communication::SubscriptionManager::release(const QString &owner, const QString &topic_name)
+{
+    auto it = m_topics.find(topic_name);
+    if (it == m_topics.end()) return;
+
+    if (!it->owners.remove(owner)) return;
+    if (!it->owners.isEmpty()) return;
+
+    // last owner gone, keep the subscription hot for the grace period
+    it->idle_since_ms = m_clock.elapsed();
+    if (!m_sweepTimer.isActive())
+    {
+        m_sweepTimer.start();
+    }
+
+    #ifdef ROM_DEBUG
+        qDebug().noquote() << QString("%1[      SubscriptionManager::release      ] : %2 by %3 %4")
+                              .arg(ROM_COLOR_CYAN).arg(topic_name).arg(owner).arg(ROM_COLOR_RESET);
+    #endif
+}
+
+void rom_dynamics::communication::SubscriptionManager::releaseAll(const QString &owner)
+{
+    const QList<QString> topics = m_topics.keys();
+    for (const QString &topic_name : topics)
+    {
+        release(owner, topic_name);
+    }
+}
+
+int rom_dynamics::communication::SubscriptionManager::refCount(const QString &topic_name) const
+{
+    auto it = m_topics.constFind(topic_name);
+    return it == m_topics.constEnd() ? 0 : it->owners.size();
+}
+
+bool rom_dynamics::communication::SubscriptionManager::isSubscribed(const QString &topic_name) const
+{
+    auto it = m_topics.constFind(topic_name);
+    return it != m_topics.constEnd() && it->subscribed;
+}
+
+void rom_dynamics::communication::SubscriptionManager::sweepIdleTopics()
+{
+    const qint64 now = m_clock.elapsed();
+    bool still_idle = false;
+
+    for (auto it = m_topics.begin(); it != m_topics.end(); )
+    {
+        if (it->idle_since_ms < 0)
+        {
+            ++it;
+            continue;
+        }
+
+        if (now - it->idle_since_ms < m_gracePeriodMs)
+        {
+            still_idle = true;
+            ++it;
+            continue;
+        }
+
+        if (it->subscribed && m_client)
+        {
+            m_client->unsubscribeTopic(it.key());
+        }
+
+        #ifdef ROM_DEBUG
+            qDebug().noquote() << QString("%1[  SubscriptionManager::sweepIdleTopics  ] : %2 expired %3")
+                                  .arg(ROM_COLOR_CYAN).arg(it.key()).arg(ROM_COLOR_RESET);
+        #endif
+
+        it = m_topics.erase(it);
+    }
+
+    if (!still_idle)
+    {
+        m_sweepTimer.stop();
+    }
+}
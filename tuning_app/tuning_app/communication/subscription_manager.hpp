@@ -0,0 +1,55 @@
+#ifndef ROM_SUBSCRIPTION_MANAGER_HPP
+#define ROM_SUBSCRIPTION_MANAGER_HPP
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+
+#include "ros_bridge_client.hpp"
+
+namespace rom_dynamics::communication {
+
+// Reference counts topic subscriptions across tabs ( owners ).
+// A topic stays subscribed on rosbridge while at least one owner holds it,
+// and for a grace period after the last owner released it, so switching
+// between tabs that share a topic never tears the ROS subscription down.
+class SubscriptionManager : public QObject {
+    Q_OBJECT
+public:
+    explicit SubscriptionManager(RosBridgeClient *client,
+        int grace_period_ms = 5000,
+        QObject *parent = nullptr);
+
+    void acquire(const QString &owner, const QString &topic_name, const QString &msg_type);
+    void release(const QString &owner, const QString &topic_name);
+    void releaseAll(const QString &owner);
+
+    int refCount(const QString &topic_name) const;
+    bool isSubscribed(const QString &topic_name) const;
+
+    void setGracePeriod(int grace_period_ms) { m_gracePeriodMs = grace_period_ms; }
+    int gracePeriod() const { return m_gracePeriodMs; }
+
+private:
+    struct TopicEntry {
+        QString msg_type;
+        QSet<QString> owners;
+        bool subscribed = false;
+        qint64 idle_since_ms = -1;      // -1 while owned
+    };
+
+    void sweepIdleTopics();
+
+    QPointer<RosBridgeClient> m_client;
+    QHash<QString, TopicEntry> m_topics;
+    int m_gracePeriodMs{5000};
+    QTimer m_sweepTimer;
+    QElapsedTimer m_clock;
+};
+}
+
+#endif
@@ -0,0 +1,455 @@
+#include "behaviorTree.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QPainter>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QXmlStreamReader>
+#include <QGraphicsSceneMouseEvent>
+#include <functional>
+
+using namespace rom_dynamics::ui::qt;
+
+namespace {
+
+QColor statusColor(RomBtModel::Status status)
+{
+    switch (status)
+    {
+    case RomBtModel::Running: return QColor(QColorConstants::Svg::orange);
+    case RomBtModel::Success: return QColor("#03fc84");
+    case RomBtModel::Failure: return QColor(255, 60, 60);
+    case RomBtModel::Skipped: return QColor(90, 110, 140);
+    default:                  return QColor(120, 120, 120);
+    }
+}
+
+// xml element, only what the outline needs
+struct XmlElement {
+    QString tag;
+    QString name;
+    QString id;
+    QList<XmlElement> children;
+};
+
+}
+
+//================================================================================
+// 1. RomBtModel
+//================================================================================
+
+RomBtModel::Status rom_dynamics::ui::qt::RomBtModel::statusFromString(const QString &status)
+{
+    if (status == QLatin1String("RUNNING")) return Running;
+    if (status == QLatin1String("SUCCESS")) return Success;
+    if (status == QLatin1String("FAILURE")) return Failure;
+    if (status == QLatin1String("SKIPPED")) return Skipped;
+    return Idle;
+}
+
+const char *rom_dynamics::ui::qt::RomBtModel::statusName(Status status)
+{
+    static const char *names[STATUS_COUNT] = { "IDLE", "RUNNING", "SUCCESS", "FAILURE", "SKIPPED" };
+    return names[status];
+}
+
+bool rom_dynamics::ui::qt::RomBtModel::loadXml(const QByteArray &xml, QString *error)
+{
+    // whole document into a small element tree first, SubTree references need every BehaviorTree
+    QXmlStreamReader reader(xml);
+    XmlElement document;
+    QList<XmlElement*> stack{ &document };
+    QString main_tree;
+    while (!reader.atEnd())
+    {
+        reader.readNext();
+        if (reader.isStartElement())
+        {
+            XmlElement element;
+            element.tag = reader.name().toString();
+            element.name = reader.attributes().value("name").toString();
+            element.id = reader.attributes().value("ID").toString();
+            if (element.tag == QLatin1String("root")) main_tree = reader.attributes().value("main_tree_to_execute").toString();
+            stack.last()->children.append(element);
+            stack.append(&stack.last()->children.last());
+        }
+        else if (reader.isEndElement() && stack.size() > 1)
+        {
+            stack.removeLast();
+        }
+    }
+    if (reader.hasError())
+    {
+        if (error) *error = reader.errorString();
+        return false;
+    }
+
+    QHash<QString, const XmlElement*> trees;
+    const XmlElement *first_tree = nullptr;
+    std::function<void(const XmlElement&)> collect = [&](const XmlElement &e) {
+        if (e.tag == QLatin1String("BehaviorTree"))
+        {
+            trees.insert(e.id, &e);
+            if (!first_tree) first_tree = &e;
+            return;
+        }
+        for (const XmlElement &child : e.children) collect(child);
+    };
+    collect(document);
+    if (trees.isEmpty())
+    {
+        if (error) *error = "no BehaviorTree element";
+        return false;
+    }
+    const XmlElement *root = trees.value(main_tree, nullptr);
+    if (!root) root = first_tree;
+
+    clear();
+
+    std::function<void(const XmlElement&, int, int)> add = [&](const XmlElement &e, int parent, int level) {
+        // v4 : <ComputePathToPose name=".."/>, v3 : <Action ID="ComputePathToPose" name=".."/>
+        const QString type = e.id.isEmpty() ? e.tag : e.id;
+        const QString name = e.name.isEmpty() ? type : e.name;
+        const int index = appendNode(name, type, parent);
+
+        if (e.tag.startsWith(QLatin1String("SubTree")) && level < 16)
+        {
+            const XmlElement *sub = trees.value(e.id, nullptr);
+            if (sub) for (const XmlElement &child : sub->children) add(child, index, level + 1);
+        }
+        for (const XmlElement &child : e.children) add(child, index, level);
+    };
+    for (const XmlElement &child : root->children) add(child, -1, 0);
+    return true;
+}
+
+void rom_dynamics::ui::qt::RomBtModel::clear()
+{
+    nodes_.clear();
+    by_name_.clear();
+    by_uid_.clear();
+    uids_seen_.clear();
+    events_ = 0;
+    last_event_t_ = 0.0;
+    since_last_event_.invalidate();
+}
+
+int rom_dynamics::ui::qt::RomBtModel::appendNode(const QString &name, const QString &type, int parent)
+{
+    Node node;
+    node.name = name;
+    node.type = type;
+    node.parent = parent;
+    node.depth = parent >= 0 ? nodes_[parent].depth + 1 : 0;
+    node.row = nodes_.size();
+    nodes_.append(node);
+    by_name_[name].append(node.row);
+    return node.row;
+}
+
+int rom_dynamics::ui::qt::RomBtModel::nodeFor(const QString &name, quint64 uid)
+{
+    if (uid != 0)
+    {
+        auto known = by_uid_.constFind(uid);
+        if (known != by_uid_.constEnd()) return known.value();
+
+        const int k = uids_seen_[name]++;
+        const QList<int> candidates = by_name_.value(name);
+        const int index = k < candidates.size() ? candidates[k] : appendNode(name, QString(), -1);
+        by_uid_.insert(uid, index);
+        return index;
+    }
+
+    auto candidates = by_name_.constFind(name);
+    if (candidates != by_name_.constEnd() && !candidates->isEmpty()) return candidates->first();
+    return appendNode(name, QString(), -1);
+}
+
+int rom_dynamics::ui::qt::RomBtModel::apply(const QJsonObject &log, QSet<int> &changed)
+{
+    const QJsonArray event_log = log.value("event_log").toArray();
+    for (const QJsonValue &value : event_log)
+    {
+        const QJsonObject event = value.toObject();
+        const QJsonObject stamp = event.value("timestamp").toObject();
+        const double t = stamp.value("sec").toDouble() + stamp.value("nanosec").toDouble() * 1e-9;
+
+        const int index = nodeFor(event.value("node_name").toString(), quint64(event.value("uid").toInteger()));
+        Node &node = nodes_[index];
+
+        const Status to = statusFromString(event.value("current_status").toString());
+        if (node.transitions > 0) node.time_in[node.status] += qMax(0.0, t - node.since);
+
+        Transition &transition = node.history[node.history_head];
+        transition.t = t;
+        transition.from = statusFromString(event.value("previous_status").toString());
+        transition.to = to;
+        node.history_head = (node.history_head + 1) % HISTORY;
+        node.history_size = qMin(node.history_size + 1, HISTORY);
+        ++node.transitions;
+
+        node.status = to;
+        node.since = t;
+        changed.insert(index);
+
+        if (t > last_event_t_) last_event_t_ = t;
+        since_last_event_.start();
+        ++events_;
+    }
+    return event_log.size();
+}
+
+double rom_dynamics::ui::qt::RomBtModel::now() const
+{
+    return since_last_event_.isValid() ? last_event_t_ + since_last_event_.elapsed() / 1000.0 : last_event_t_;
+}
+
+double rom_dynamics::ui::qt::RomBtModel::tickRate(int index) const
+{
+    const Node &node = nodes_[index];
+    const double t_now = now();
+    const double from = t_now - RATE_WINDOW_SEC;
+
+    int count = 0;
+    double oldest = t_now;
+    for (int age = 0; age < node.history_size; ++age)
+    {
+        const Transition &transition = node.transition(age);
+        if (transition.t < from) break;
+        if (transition.to == Running) ++count;
+        oldest = transition.t;
+    }
+
+    // a full ring that does not reach back over the whole window covers a shorter span
+    double span = RATE_WINDOW_SEC;
+    if (node.history_size == HISTORY && oldest > from) span = t_now - oldest;
+    return span > 1e-3 ? count / span : 0.0;
+}
+
+//================================================================================
+// 2. RomBtNodeItem
+//================================================================================
+
+rom_dynamics::ui::qt::RomBtNodeItem::RomBtNodeItem(const RomBtModel *model, int index, QGraphicsItem *parent)
+    : QGraphicsObject(parent), model_(model), index_(index)
+{
+    const RomBtModel::Node &node = model_->node(index_);
+    setPos(node.depth * INDENT, node.row * ROW_H);
+}
+
+QRectF rom_dynamics::ui::qt::RomBtNodeItem::boundingRect() const
+{
+    return QRectF(0, 0, WIDTH - model_->node(index_).depth * INDENT, ROW_H - 2);
+}
+
+void rom_dynamics::ui::qt::RomBtNodeItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
+{
+    const RomBtModel::Node &node = model_->node(index_);
+    const QRectF r = boundingRect();
+    const QColor color = statusColor(node.status);
+
+    painter->fillRect(QRectF(r.left(), r.top(), 4, r.height()), color);
+    if (node.status == RomBtModel::Running) painter->fillRect(r.adjusted(4, 0, 0, 0), QColor(255, 165, 0, 28));
+
+    QFont font = painter->font();
+    font.setPixelSize(11);
+    painter->setFont(font);
+
+    painter->setPen(QColor(220, 220, 220));
+    const QRectF text = r.adjusted(9, 0, -150, 0);
+    QString label = node.name;
+    if (!node.type.isEmpty() && node.type != node.name) label += QString("  <%1>").arg(node.type);
+    painter->drawText(text, Qt::AlignVCenter | Qt::AlignLeft, painter->fontMetrics().elidedText(label, Qt::ElideRight, int(text.width())));
+
+    if (node.transitions == 0) return;
+    const double in_state = qMax(0.0, model_->now() - node.since);
+    painter->setPen(color);
+    painter->drawText(r.adjusted(0, 0, -4, 0), Qt::AlignVCenter | Qt::AlignRight,
+                      QString("%1 Hz  %2 s  %3").arg(model_->tickRate(index_), 0, 'f', 1)
+                                                .arg(in_state, 0, 'f', 1)
+                                                .arg(RomBtModel::statusName(node.status)));
+}
+
+void rom_dynamics::ui::qt::RomBtNodeItem::mousePressEvent(QGraphicsSceneMouseEvent *event)
+{
+    emit selected(index_);
+    event->accept();
+}
+
+//================================================================================
+// 3. RomBtMonitor
+//================================================================================
+
+rom_dynamics::ui::qt::RomBtMonitor::RomBtMonitor(QWidget *parent)
+    : QWidget(parent)
+{
+    const QString btnStyle = "QPushButton { color: #c3c9d4; border-radius: 4px; border: 1px solid #c3c9d4; padding: 2px 10px; }"
+                             "QPushButton:hover { color: white; border: 1px solid orange; }";
+
+    xmlBtn_ = new QPushButton("Tree XML", this);
+    xmlBtn_->setStyleSheet(btnStyle);
+    xmlBtn_->setToolTip("Load the behavior tree xml for the full structure ( optional )");
+    connect(xmlBtn_, &QPushButton::clicked, this, [this]() {
+        const QString path = QFileDialog::getOpenFileName(this, "Behavior tree xml", QString(), "Behavior tree (*.xml)");
+        if (!path.isEmpty()) loadXmlFile(path);
+    });
+
+    clearBtn_ = new QPushButton("Clear", this);
+    clearBtn_->setStyleSheet(btnStyle);
+    connect(clearBtn_, &QPushButton::clicked, this, &RomBtMonitor::clear);
+
+    status_ = new QLabel("waiting for /behavior_tree_log", this);
+    status_->setStyleSheet("color: #03fc84; font: 10px;");
+
+    scene_ = new QGraphicsScene(this);
+    view_ = new QGraphicsView(scene_, this);
+    view_->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    view_->setStyleSheet("QGraphicsView { border: 1px solid #444; background: #2e2e2e; }");
+    // rows repaint themselves, no need for a full viewport pass per event
+    view_->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+
+    details_ = new QLabel(this);
+    details_->setFixedWidth(250);
+    details_->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    details_->setWordWrap(true);
+    details_->setStyleSheet("color: #bdb7b7; font: 10px monospace; border: 1px solid #444; padding: 4px;");
+    details_->setText("click a node for its transitions");
+
+    QHBoxLayout *top = new QHBoxLayout();
+    top->addWidget(xmlBtn_);
+    top->addWidget(clearBtn_);
+    top->addWidget(status_, 1);
+
+    QHBoxLayout *body = new QHBoxLayout();
+    body->addWidget(view_, 1);
+    body->addWidget(details_);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->addLayout(top);
+    layout->addLayout(body, 1);
+    setLayout(layout);
+
+    frameTimer_.setSingleShot(true);
+    frameTimer_.setInterval(REFRESH_MS);
+    connect(&frameTimer_, &QTimer::timeout, this, &RomBtMonitor::flush);
+
+    statsTimer_.setInterval(STATS_MS);
+    connect(&statsTimer_, &QTimer::timeout, this, [this]() {
+        if (!isVisible()) return;
+        view_->viewport()->update();        // time in state keeps counting without events
+        if (selected_ >= 0) showDetails(selected_);
+
+        const double elapsed = rate_clock_.isValid() ? rate_clock_.restart() / 1000.0 : 0.0;
+        if (elapsed > 0.0) event_rate_ = rate_events_ / elapsed;
+        rate_events_ = 0;
+        rate_clock_.start();
+        status_->setText(QString("%1 nodes  %2 events  %3 events/s")
+                         .arg(model_.size()).arg(model_.events()).arg(event_rate_, 0, 'f', 0));
+    });
+    statsTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomBtMonitor::applyLog(const QJsonObject &log)
+{
+    rate_events_ += model_.apply(log, dirty_);
+    if (!frameTimer_.isActive()) frameTimer_.start();
+}
+
+bool rom_dynamics::ui::qt::RomBtMonitor::loadXmlFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        status_->setText(QString("cannot open %1").arg(path));
+        return false;
+    }
+
+    QString error;
+    if (!model_.loadXml(file.readAll(), &error))
+    {
+        status_->setText(QString("%1 : %2").arg(QFileInfo(path).fileName(), error));
+        return false;
+    }
+
+    scene_->clear();
+    items_.clear();
+    dirty_.clear();
+    selected_ = -1;
+    syncItems();
+    status_->setText(QString("%1 : %2 nodes").arg(QFileInfo(path).fileName()).arg(model_.size()));
+    return true;
+}
+
+void rom_dynamics::ui::qt::RomBtMonitor::clear()
+{
+    model_.clear();
+    scene_->clear();
+    items_.clear();
+    dirty_.clear();
+    selected_ = -1;
+    details_->setText("click a node for its transitions");
+}
+
+void rom_dynamics::ui::qt::RomBtMonitor::syncItems()
+{
+    // only nodes the scene has not seen yet, existing rows stay where they are
+    for (int i = items_.size(); i < model_.size(); ++i)
+    {
+        RomBtNodeItem *item = new RomBtNodeItem(&model_, i);
+        connect(item, &RomBtNodeItem::selected, this, &RomBtMonitor::showDetails);
+        scene_->addItem(item);
+        items_.append(item);
+    }
+    scene_->setSceneRect(0, 0, RomBtNodeItem::WIDTH, qMax(1, model_.rows()) * RomBtNodeItem::ROW_H);
+}
+
+void rom_dynamics::ui::qt::RomBtMonitor::flush()
+{
+    if (items_.size() < model_.size()) syncItems();
+
+    for (int index : std::as_const(dirty_))
+    {
+        if (index < items_.size()) items_[index]->update();
+    }
+    if (selected_ >= 0 && dirty_.contains(selected_)) showDetails(selected_);
+    dirty_.clear();
+}
+
+void rom_dynamics::ui::qt::RomBtMonitor::showDetails(int index)
+{
+    if (index < 0 || index >= model_.size()) return;
+    selected_ = index;
+
+    const RomBtModel::Node &node = model_.node(index);
+    const double now = model_.now();
+
+    QString text = QString("<b>%1</b><br>").arg(node.name.toHtmlEscaped());
+    if (!node.type.isEmpty()) text += QString("%1<br>").arg(node.type.toHtmlEscaped());
+    text += QString("<br>%1 transitions, %2 Hz<br>").arg(node.transitions).arg(model_.tickRate(index), 0, 'f', 2);
+
+    // totals including the current state up to now
+    text += "<br>time in state<br>";
+    for (int s = 0; s < RomBtModel::STATUS_COUNT; ++s)
+    {
+        double total = node.time_in[s];
+        if (s == node.status && node.transitions > 0) total += qMax(0.0, now - node.since);
+        if (total <= 0.0) continue;
+        text += QString("&nbsp;&nbsp;%1 %2 s<br>").arg(RomBtModel::statusName(RomBtModel::Status(s))).arg(total, 0, 'f', 2);
+    }
+
+    text += "<br>last transitions<br>";
+    for (int age = 0; age < qMin(node.history_size, 20); ++age)
+    {
+        const RomBtModel::Transition &transition = node.transition(age);
+        text += QString("&nbsp;&nbsp;-%1 s  %2 -> <span style='color:%3'>%4</span><br>")
+                    .arg(now - transition.t, 0, 'f', 2)
+                    .arg(RomBtModel::statusName(transition.from))
+                    .arg(statusColor(transition.to).name())
+                    .arg(RomBtModel::statusName(transition.to));
+    }
+    details_->setText(text);
+}
@@ -0,0 +1,172 @@
+#ifndef ROM_BEHAVIOR_TREE_HPP
+#define ROM_BEHAVIOR_TREE_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QGraphicsView>
+#include <QGraphicsScene>
+#include <QGraphicsObject>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QVector>
+#include <QJsonObject>
+
+namespace rom_dynamics::ui::qt {
+
+//================================================================================
+// 1. model : structure once, status changes as deltas
+//================================================================================
+// Nodes come from the tree XML ( optional ) or are appended the first time an event
+// names them. Each node keeps its last HISTORY transitions in a ring; tick rate and
+// time in state are derived from it. Events are keyed by uid when the log carries one
+// ( nav2 iron+ ); the k-th uid seen for a name is the k-th node with that name in the
+// XML. Without uids every event goes to the first node of its name.
+class RomBtModel {
+public:
+    static constexpr int HISTORY = 64;
+    static constexpr double RATE_WINDOW_SEC = 10.0;
+
+    enum Status { Idle, Running, Success, Failure, Skipped, STATUS_COUNT };
+    static Status statusFromString(const QString &status);
+    static const char *statusName(Status status);
+
+    struct Transition {
+        double t = 0.0;
+        Status from = Idle;
+        Status to = Idle;
+    };
+
+    struct Node {
+        QString name;
+        QString type;               // xml tag, empty for discovered nodes
+        int parent = -1;
+        int depth = 0;
+        int row = 0;                // outline row, fixed once assigned
+        Status status = Idle;
+        double since = 0.0;         // time of the last transition
+        double time_in[STATUS_COUNT] = {};
+        QVector<Transition> history = QVector<Transition>(HISTORY);
+        int history_head = 0;
+        int history_size = 0;
+        quint64 transitions = 0;
+
+        const Transition &transition(int age) const { return history[(history_head - 1 - age + HISTORY * 2) % HISTORY]; }
+    };
+
+    // replaces the structure; false when the xml has no tree
+    bool loadXml(const QByteArray &xml, QString *error = nullptr);
+    void clear();
+
+    // one nav2_msgs/BehaviorTreeLog; appends changed node indices ( new nodes included )
+    int apply(const QJsonObject &log, QSet<int> &changed);
+
+    int size() const { return nodes_.size(); }
+    const Node &node(int index) const { return nodes_[index]; }
+    int rows() const { return nodes_.size(); }
+
+    // newest event time, advanced by the wall clock since that event
+    double now() const;
+
+    // entries into RUNNING per second over RATE_WINDOW_SEC
+    double tickRate(int index) const;
+
+    quint64 events() const { return events_; }
+
+private:
+    int nodeFor(const QString &name, quint64 uid);
+    int appendNode(const QString &name, const QString &type, int parent);
+
+    QVector<Node> nodes_;
+    QHash<QString, QList<int>> by_name_;
+    QHash<quint64, int> by_uid_;
+    QHash<QString, int> uids_seen_;     // name -> uids mapped so far
+
+    double last_event_t_ = 0.0;
+    QElapsedTimer since_last_event_;
+    quint64 events_ = 0;
+};
+
+//================================================================================
+// 2. one outline row
+//================================================================================
+class RomBtNodeItem : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int ROW_H = 18;
+    static constexpr int INDENT = 14;
+    static constexpr int WIDTH = 460;
+
+    RomBtNodeItem(const RomBtModel *model, int index, QGraphicsItem *parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+    int index() const { return index_; }
+
+signals:
+    void selected(int index);
+
+protected:
+    void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
+
+private:
+    const RomBtModel *model_;
+    int index_;
+};
+
+//================================================================================
+// 3. BT tab widget
+//================================================================================
+// Events are applied to the model as they arrive; only the rows they touched are
+// repainted, at most every REFRESH_MS. New nodes get the next outline row, rows
+// that already exist never move.
+class RomBtMonitor : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_MS = 33;
+    static constexpr int STATS_MS = 500;    // time in state / tick rate text of every row
+
+    explicit RomBtMonitor(QWidget *parent = nullptr);
+    ~RomBtMonitor() override = default;
+
+    void applyLog(const QJsonObject &log);
+    bool loadXmlFile(const QString &path);
+    void clear();
+
+private:
+    void flush();
+    void syncItems();
+    void showDetails(int index);
+
+    RomBtModel model_;
+    QGraphicsScene *scene_;
+    QGraphicsView *view_;
+    QLabel *details_;
+    QLabel *status_;
+    QPushButton *xmlBtn_;
+    QPushButton *clearBtn_;
+    QVector<RomBtNodeItem*> items_;
+    QSet<int> dirty_;
+    int selected_ = -1;
+    QTimer frameTimer_;
+    QTimer statsTimer_;
+
+    // events per second, for the status line
+    quint64 rate_events_ = 0;
+    QElapsedTimer rate_clock_;
+    double event_rate_ = 0.0;
+};
+
+}
+
+#endif // ROM_BEHAVIOR_TREE_HPP
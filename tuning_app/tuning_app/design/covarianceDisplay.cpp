@@ -70,8 +70,7 @@ void rom_dynamics::ui::qt::RomPositionCovarianceGraph::initializeChart()
     ellipse_series_->attachAxis(axisX_);
     ellipse_series_->attachAxis(axisY_);
     
-    chart_view_ = new QChartView(chart_);
-    chart_view_->setRenderHint(QPainter::Antialiasing);
+    chart_view_ = new RomChartView(chart_);
 }
 
 void rom_dynamics::ui::qt::RomPositionCovarianceGraph::updateGraph(double ekf_pose_x, 
@@ -86,37 +85,15 @@ void rom_dynamics::ui::qt::RomPositionCovarianceGraph::updateGraph(double ekf_po
 
 void rom_dynamics::ui::qt::RomPositionCovarianceGraph::drawPositionEllipse(const Eigen::Matrix2d& covariance_xy)
 {
-    // Calculate Eigenvalues and Eigenvectors for the Ellipse
-    EigenSolver<Matrix2d> es(covariance_xy);
-    Vector2d eigenvalues = es.eigenvalues().real();
-    Matrix2d eigenvectors = es.eigenvectors().real();
-
-    // 95% confidence chi-squared value for 2 DOF
-    double k = 2.4477; 
-    double major_axis = k * std::sqrt(eigenvalues(0));
-    double minor_axis = k * std::sqrt(eigenvalues(1));
-    double angle = std::atan2(eigenvectors(1, 0), eigenvectors(0, 0)); // Angle of major axis
-
-    ellipse_series_->clear();
-    
-    // Generate Ellipse points
-    const int num_points = 50;
-    for (int i = 0; i <= num_points; ++i) 
-    {
-        double theta = 2.0 * M_PI * i / num_points;
-        double x_rotated = major_axis * std::cos(theta);
-        double y_rotated = minor_axis * std::sin(theta);
-
-        // --- NORMALIZATION: Rotate and Translate to (0, 0) ---
-        // Original: double x_point = current_x_ + (x_rotated * std::cos(angle) - y_rotated * std::sin(angle));
-        // Original: double y_point = current_y_ + (x_rotated * std::sin(angle) + y_rotated * std::cos(angle));
+    // closed form symmetric 2x2, one replace() instead of clear() + 51 append()
+    // symmetric part, the two off diagonal entries come from separate message fields
+    const double xy = 0.5 * (covariance_xy(0, 1) + covariance_xy(1, 0));
+    const QList<QPointF> &points = ellipse_.points(covariance_xy(0, 0), xy, covariance_xy(1, 1));
+    ellipse_series_->replace(points);
 
-        double x_point = (x_rotated * std::cos(angle) - y_rotated * std::sin(angle));
-        double y_point = (x_rotated * std::sin(angle) + y_rotated * std::cos(angle));
+    const double major_axis = ellipse_.lastAxes().major;
+    const double minor_axis = ellipse_.lastAxes().minor;
 
-        ellipse_series_->append(x_point, y_point);
-    }
-    
     // --- AXIS RANGING: Dynamically center on (0, 0) and scale to the ellipse size ---
     double range = std::max(major_axis, minor_axis) * 1.2; // 20% padding
     
@@ -221,8 +198,7 @@ void rom_dynamics::ui::qt::RomYawCovarianceGraph::initializeChart()
     dummyScatter->attachAxis(radialAxis); 
     dummyScatter->attachAxis(angularAxis); 
     
-    chart_view_ = new QChartView(chart_);
-    chart_view_->setRenderHint(QPainter::Antialiasing);
+    chart_view_ = new RomChartView(chart_);
 }
 
 void rom_dynamics::ui::qt::RomYawCovarianceGraph::updateGraph(double ekf_pose_yaw, double yaw_variance)
@@ -271,3 +247,226 @@ void rom_dynamics::ui::qt::RomYawCovarianceGraph::drawYawSector(double yaw, doub
     QString title = QString("Covariance of EKF Yaw");
     chart_->setTitle(title);
 }
+
+//================================================================================
+// 3. RomCovarianceTimeline Implementation
+//================================================================================
+
+rom_dynamics::ui::qt::RomCovarianceTimeline::RomCovarianceTimeline(QWidget *parent)
+    : QWidget(parent)
+{
+    chart_ = new QChart();
+
+    QFont titleFont;
+    QColor titleColor(QColorConstants::Svg::orange);
+    titleFont.setFamily("SF Pro Text");
+    titleFont.setPointSize(10);
+    chart_->setTitle("EKF Covariance Timeline ( log10 )");
+    chart_->setTitleBrush(QBrush(titleColor));
+    chart_->setTitleFont(titleFont);
+
+    chart_->setBackgroundBrush(Qt::NoBrush);
+    chart_->setPlotAreaBackgroundBrush(Qt::NoBrush);
+    chart_->setBackgroundRoundness(0);
+    chart_->legend()->setLabelColor(QColor(189, 183, 183));
+    chart_->legend()->setAlignment(Qt::AlignBottom);
+
+    axisX_ = new QValueAxis();
+    axisY_ = new QValueAxis();
+    axisX_->setTitleText("s");
+
+    QColor axisColor(189, 183, 183, 80);
+    axisX_->setGridLineColor(axisColor);
+    axisY_->setGridLineColor(axisColor);
+    axisX_->setLabelsColor(axisColor);
+    axisY_->setLabelsColor(axisColor);
+    axisX_->setTitleBrush(QBrush(axisColor));
+    axisX_->setLinePen(QPen(axisColor));
+    axisY_->setLinePen(QPen(axisColor));
+
+    QFont axisFont;
+    axisFont.setFamily("SF Pro Text");
+    axisFont.setPointSize(7);
+    axisX_->setLabelsFont(axisFont);
+    axisY_->setLabelsFont(axisFont);
+
+    axisX_->setRange(0, 60);
+    axisY_->setRange(-6, 1);
+
+    chart_->addAxis(axisX_, Qt::AlignBottom);
+    chart_->addAxis(axisY_, Qt::AlignLeft);
+
+    const QList<QPair<RomCovarianceHistory::Metric, QColor>> plotted = {
+        { RomCovarianceHistory::PoseTrace,  QColor(QColorConstants::Svg::orange) },
+        { RomCovarianceHistory::PoseLogDet, QColor(255, 0, 0) },
+        { RomCovarianceHistory::VarX,       QColor("#03fc84") },
+        { RomCovarianceHistory::VarY,       QColor("#00bfff") },
+        { RomCovarianceHistory::VarYaw,     QColor(180, 120, 255) },
+        { RomCovarianceHistory::TwistTrace, QColor(189, 183, 183) },
+    };
+    for (const auto &entry : plotted)
+    {
+        Curve curve;
+        curve.metric = entry.first;
+        curve.series = new QLineSeries();
+        curve.series->setName(RomCovarianceHistory::metricName(entry.first));
+        curve.series->setPen(QPen(entry.second, 1.5));
+        chart_->addSeries(curve.series);
+        curve.series->attachAxis(axisX_);
+        curve.series->attachAxis(axisY_);
+        curves_.append(curve);
+    }
+
+    chart_view_ = new RomChartView(chart_);
+    chart_view_->setRubberBand(QChartView::HorizontalRubberBand); // drag to zoom, right click to zoom out
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(chart_view_);
+    setLayout(layout);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    // zoom -> decimate the visible slice
+    connect(axisX_, &QValueAxis::rangeChanged, this, [this](qreal min, qreal max) {
+        if (settingRange_) return;
+        zoomed_ = !(min <= oldestX() && max >= last_t_ - t0_);
+        zoomMin_ = min;
+        zoomMax_ = max;
+        refresh();
+    });
+
+    frameTimer_.setSingleShot(true);
+    frameTimer_.setInterval(REFRESH_MS);
+    connect(&frameTimer_, &QTimer::timeout, this, &RomCovarianceTimeline::refresh);
+}
+
+void rom_dynamics::ui::qt::RomCovarianceTimeline::append(double t_sec, const double *pose, const double *twist)
+{
+    // stamps went back ( robot restarted, replay seek ) : start a new timeline
+    if (!history_.isEmpty() && t_sec < last_t_) clear();
+    if (history_.isEmpty()) t0_ = t_sec;
+    last_t_ = t_sec;
+
+    history_.append(t_sec, pose, twist);
+
+    if (isVisible() && !frameTimer_.isActive()) frameTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomCovarianceTimeline::clear()
+{
+    history_.clear();
+    zoomed_ = false;
+    for (Curve &curve : curves_)
+    {
+        curve.lod.clear();
+        curve.consumed = 0;
+        curve.series->clear();
+    }
+}
+
+// log10 of the metric ( log det already is ), NaN when it cannot be drawn
+double rom_dynamics::ui::qt::RomCovarianceTimeline::plotValue(int i, RomCovarianceHistory::Metric metric) const
+{
+    const double value = history_.metric(i, metric);
+    if (!std::isfinite(value)) return qQNaN();
+    if (metric == RomCovarianceHistory::PoseLogDet || metric == RomCovarianceHistory::TwistLogDet) return value;
+    return value > 0.0 ? std::log10(value) : qQNaN();
+}
+
+void rom_dynamics::ui::qt::RomCovarianceTimeline::feed(Curve &curve, int px)
+{
+    // power of two widths : the buckets start over only each time the span doubles
+    const double span = qMax(1.0, last_t_ - t0_ - oldestX());
+    const double dt = std::exp2(std::ceil(std::log2(span / px)));
+    if (curve.lod.bucketWidth() != dt)
+    {
+        curve.lod.setBucketWidth(dt);
+        curve.consumed = 0;
+    }
+
+    quint64 fresh = history_.written() - curve.consumed;
+    if (fresh > quint64(history_.size()))
+    {
+        curve.lod.clear();
+        fresh = quint64(history_.size());
+    }
+    for (int i = history_.size() - int(fresh); i < history_.size(); ++i)
+        curve.lod.append(history_.time(i) - t0_, plotValue(i, curve.metric));
+    curve.consumed = history_.written();
+
+    // samples the ring overwrote
+    curve.lod.trimBefore(oldestX());
+}
+
+void rom_dynamics::ui::qt::RomCovarianceTimeline::visiblePoints(RomCovarianceHistory::Metric metric, int px,
+                                                                double &y_min, double &y_max)
+{
+    // history times only go forward ( clear() on a jump back )
+    auto lowerBound = [this](double x) {
+        int lo = 0, hi = history_.size();
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            if (history_.time(mid) - t0_ < x) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    };
+    // one neighbour each side so the line reaches the plot edges
+    const int first = qMax(0, lowerBound(zoomMin_) - 1);
+    const int last = qMin(history_.size(), lowerBound(zoomMax_) + 1);
+    const int per_bucket = qMax(1, (last - first + px - 1) / px);
+
+    scratch_.clear();
+    for (int i = first; i < last; i += per_bucket)
+    {
+        QPointF lo, hi;
+        bool any = false;
+        for (int j = i; j < qMin(last, i + per_bucket); ++j)
+        {
+            const double v = plotValue(j, metric);
+            if (!std::isfinite(v)) continue;
+            const QPointF p(history_.time(j) - t0_, v);
+            if (!any || v < lo.y()) lo = p;
+            if (!any || v > hi.y()) hi = p;
+            any = true;
+        }
+        if (!any) continue;
+        scratch_.append(lo.x() <= hi.x() ? lo : hi);
+        if (lo != hi) scratch_.append(lo.x() <= hi.x() ? hi : lo);
+        y_min = qMin(y_min, lo.y());
+        y_max = qMax(y_max, hi.y());
+    }
+}
+
+void rom_dynamics::ui::qt::RomCovarianceTimeline::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    refresh();
+}
+
+void rom_dynamics::ui::qt::RomCovarianceTimeline::refresh()
+{
+    if (history_.isEmpty()) return;
+
+    double y_min = std::numeric_limits<double>::max();
+    double y_max = std::numeric_limits<double>::lowest();
+
+    const int px = qMax(16, int(chart_->plotArea().width()));
+    for (Curve &curve : curves_)
+    {
+        // the buckets follow the data even while zoomed, so zooming out is immediate
+        feed(curve, px);
+        if (zoomed_) visiblePoints(curve.metric, px, y_min, y_max);
+        else curve.lod.points(scratch_, y_min, y_max);
+        curve.series->replace(scratch_);
+    }
+    if (y_min > y_max) return;
+
+    if (!zoomed_)
+    {
+        settingRange_ = true;
+        axisX_->setRange(oldestX(), qMax(oldestX() + 1.0, last_t_ - t0_));
+        settingRange_ = false;
+    }
+    axisY_->setRange(std::floor(y_min - 0.25), std::ceil(y_max + 0.25));
+}
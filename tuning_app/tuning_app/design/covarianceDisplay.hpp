@@ -11,6 +11,11 @@
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QValueAxis>
 #include <Eigen/Dense> // For Eigen decomposition
+#include "romChartView.hpp"
+#include "covarianceEllipse.hpp"
+#include "covarianceHistory.hpp"
+#include "decimation.hpp"
+#include <QTimer>
 
 namespace rom_dynamics::ui::qt {
 class RomPositionCovarianceGraph : public QWidget
@@ -26,11 +31,12 @@ public:
                      const Eigen::Matrix2d& covariance_xy);
 
 private:
-    QChartView *chart_view_;
+    RomChartView *chart_view_;
     QChart *chart_;
     QScatterSeries *ellipse_series_;
     QValueAxis *axisX_;
     QValueAxis *axisY_;
+    RomCovarianceEllipse ellipse_;
     
     double current_x_ = 0.0;
     double current_y_ = 0.0;
@@ -50,7 +56,7 @@ public:
     void updateGraph(double ekf_pose_yaw, double yaw_variance);
 
 private:
-    QChartView *chart_view_;
+    RomChartView *chart_view_;
     QPolarChart *chart_;
     QLineSeries *yaw_arc_series_;
     
@@ -65,6 +71,62 @@ private:
     }
 };
 
+// How the covariance evolves: trace, log10 det and per axis variances of the /odom
+// covariances over the whole RomCovarianceHistory, on a log10 axis. The history is the only
+// copy of the samples : every curve feeds the samples appended since the last frame into
+// time aligned min / max buckets ( RomWindowMinMax, bucket = span / plot width rounded up to
+// a power of two ), a zoomed view re-decimates the visible slice of the history columns.
+// Redrawn at most every REFRESH_MS while visible.
+class RomCovarianceTimeline : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_MS = 100;
+
+    explicit RomCovarianceTimeline(QWidget *parent = nullptr);
+    ~RomCovarianceTimeline() override = default;
+
+    // pose / twist : 36 values row major ( nav_msgs/Odometry covariance )
+    void append(double t_sec, const double *pose, const double *twist);
+    void clear();
+
+    const RomCovarianceHistory &history() const { return history_; }
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
+private:
+    struct Curve {
+        RomCovarianceHistory::Metric metric;
+        QLineSeries *series = nullptr;
+        RomWindowMinMax lod;
+        quint64 consumed = 0;       // history_.written() already in lod
+    };
+
+    void refresh();
+    double plotValue(int i, RomCovarianceHistory::Metric metric) const;
+    double oldestX() const { return history_.isEmpty() ? 0.0 : history_.time(0) - t0_; }
+    void feed(Curve &curve, int px);
+    void visiblePoints(RomCovarianceHistory::Metric metric, int px, double &y_min, double &y_max);
+
+    RomChartView *chart_view_;
+    QChart *chart_;
+    QValueAxis *axisX_;
+    QValueAxis *axisY_;
+    QList<Curve> curves_;
+
+    RomCovarianceHistory history_;
+    double t0_ = 0.0;
+    double last_t_ = 0.0;
+    bool settingRange_ = false;
+    bool zoomed_ = false;
+    double zoomMin_ = 0.0;
+    double zoomMax_ = 0.0;
+    QList<QPointF> scratch_;
+    QTimer frameTimer_;
+};
+
 }
 
 #endif // ROM_COVARIANCE_GRAPHS_HPP
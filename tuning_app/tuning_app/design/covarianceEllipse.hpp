@@ -0,0 +1,93 @@
+#ifndef ROM_COVARIANCE_ELLIPSE_HPP
+#define ROM_COVARIANCE_ELLIPSE_HPP
+
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QtMath>
+#include <array>
+#include <cmath>
+
+namespace rom_dynamics::ui::qt {
+
+// Confidence ellipse of a symmetric 2x2 covariance [ xx xy ; xy yy ].
+// Eigen decomposition in closed form ( no iterative solver ), the ellipse is the fixed
+// unit circle table mapped through one 2x2 matrix, written into a reused point buffer
+// that goes to the series with a single replace().
+class RomCovarianceEllipse {
+public:
+    static constexpr int SEGMENTS = 50;             // SEGMENTS + 1 points, first == last
+    static constexpr double K_95 = 2.4477;          // sqrt( chi2 2 dof, 95 % )
+
+    struct Axes {
+        double major = 0.0;     // semi axes, already scaled by k
+        double minor = 0.0;
+        double angle = 0.0;     // of the major axis, rad
+    };
+
+    // lambda = m +- sqrt( d^2 + xy^2 ),  m = ( xx + yy ) / 2,  d = ( xx - yy ) / 2
+    static Axes axes(double xx, double xy, double yy, double k = K_95)
+    {
+        const double m = 0.5 * (xx + yy);
+        const double d = 0.5 * (xx - yy);
+        const double r = std::hypot(d, xy);
+
+        Axes a;
+        // numerically not positive definite -> flat ellipse instead of NaN
+        a.major = k * std::sqrt(qMax(0.0, m + r));
+        a.minor = k * std::sqrt(qMax(0.0, m - r));
+        a.angle = 0.5 * std::atan2(2.0 * xy, xx - yy);
+        return a;
+    }
+
+    RomCovarianceEllipse()
+    {
+        for (int i = 0; i <= SEGMENTS; ++i)
+        {
+            const double theta = 2.0 * M_PI * i / SEGMENTS;
+            cos_[i] = std::cos(theta);
+            sin_[i] = std::sin(theta);
+        }
+        // exact closure, the last point lands on the first
+        cos_[SEGMENTS] = cos_[0];
+        sin_[SEGMENTS] = sin_[0];
+        points_.resize(SEGMENTS + 1);
+    }
+
+    // ellipse centred on ( cx, cy ); the returned list is reused by the next call
+    const QList<QPointF> &points(double xx, double xy, double yy, double cx = 0.0, double cy = 0.0, double k = K_95)
+    {
+        axes_ = axes(xx, xy, yy, k);
+
+        // p = R( angle ) * diag( major, minor ) * ( cos, sin ) + c
+        const double c = std::cos(axes_.angle);
+        const double s = std::sin(axes_.angle);
+        const double m00 = c * axes_.major, m01 = -s * axes_.minor;
+        const double m10 = s * axes_.major, m11 =  c * axes_.minor;
+
+        std::array<double, SEGMENTS + 1> px;
+        std::array<double, SEGMENTS + 1> py;
+        for (int i = 0; i <= SEGMENTS; ++i)     // no branches, no calls : vectorizes
+        {
+            px[i] = cx + m00 * cos_[i] + m01 * sin_[i];
+            py[i] = cy + m10 * cos_[i] + m11 * sin_[i];
+        }
+
+        QPointF *out = points_.data();
+        for (int i = 0; i <= SEGMENTS; ++i) out[i] = QPointF(px[i], py[i]);
+        return points_;
+    }
+
+    // of the last points() call
+    const Axes &lastAxes() const { return axes_; }
+
+private:
+    std::array<double, SEGMENTS + 1> cos_;
+    std::array<double, SEGMENTS + 1> sin_;
+    QList<QPointF> points_;
+    Axes axes_;
+};
+}
+
+#endif
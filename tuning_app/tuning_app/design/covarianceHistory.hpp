@@ -0,0 +1,142 @@
+#ifndef ROM_COVARIANCE_HISTORY_HPP
+#define ROM_COVARIANCE_HISTORY_HPP
+
+#pragma once
+
+#include <QVector>
+#include <QtMath>
+#include <Eigen/Dense>
+#include <array>
+#include <cmath>
+
+namespace rom_dynamics::ui::qt {
+
+// Fixed capacity history of nav_msgs/Odometry covariances, one column per value.
+//   pose / twist : 6x6 row major as in the message, stored as the 21 upper triangle entries
+//   metrics      : derived once per sample on append ( trace, log10 det, per axis variance )
+// Columns are plain double arrays indexed by the same ring slot, so one metric over
+// minutes of data is a contiguous scan and a new sample never allocates.
+class RomCovarianceHistory {
+public:
+    static constexpr int DIM = 6;                       // x y z roll pitch yaw
+    static constexpr int PACKED = DIM * (DIM + 1) / 2;  // 21
+
+    enum Metric {
+        PoseTrace,
+        PoseLogDet,     // log10, NaN when not positive definite
+        VarX,
+        VarY,
+        VarYaw,
+        TwistTrace,
+        TwistLogDet,
+        VarVx,
+        VarVyaw,
+        METRIC_COUNT
+    };
+
+    static const char *metricName(Metric metric)
+    {
+        static const char *names[METRIC_COUNT] = {
+            "pose trace", "pose log det", "var x", "var y", "var yaw",
+            "twist trace", "twist log det", "var vx", "var vyaw"
+        };
+        return names[metric];
+    }
+
+    // upper triangle slot of ( row, col ), either order
+    static constexpr int packedIndex(int row, int col)
+    {
+        return row <= col ? row * DIM - row * (row - 1) / 2 + (col - row)
+                          : packedIndex(col, row);
+    }
+
+    explicit RomCovarianceHistory(int capacity = 1 << 16) { setCapacity(capacity); }
+
+    void setCapacity(int capacity)
+    {
+        capacity_ = qMax(1, capacity);
+        time_ = QVector<double>(capacity_);
+        for (QVector<double> &column : pose_) column = QVector<double>(capacity_);
+        for (QVector<double> &column : twist_) column = QVector<double>(capacity_);
+        for (QVector<double> &column : metrics_) column = QVector<double>(capacity_);
+        clear();
+    }
+    void clear() { head_ = 0; size_ = 0; written_ = 0; }
+
+    // pose / twist : 36 values row major, time in seconds
+    void append(double t_sec, const double *pose, const double *twist)
+    {
+        const int slot = head_;
+        head_ = (head_ + 1) % capacity_;
+        if (size_ < capacity_) ++size_;
+        ++written_;
+
+        time_[slot] = t_sec;
+        for (int r = 0; r < DIM; ++r)
+        {
+            for (int c = r; c < DIM; ++c)
+            {
+                const int k = packedIndex(r, c);
+                pose_[k][slot] = pose[r * DIM + c];
+                twist_[k][slot] = twist[r * DIM + c];
+            }
+        }
+
+        metrics_[PoseTrace][slot]   = trace(pose);
+        metrics_[PoseLogDet][slot]  = log10Det(pose);
+        metrics_[VarX][slot]        = pose[packedDiag(0)];
+        metrics_[VarY][slot]        = pose[packedDiag(1)];
+        metrics_[VarYaw][slot]      = pose[packedDiag(5)];
+        metrics_[TwistTrace][slot]  = trace(twist);
+        metrics_[TwistLogDet][slot] = log10Det(twist);
+        metrics_[VarVx][slot]       = twist[packedDiag(0)];
+        metrics_[VarVyaw][slot]     = twist[packedDiag(5)];
+    }
+
+    int size() const { return size_; }
+    int capacity() const { return capacity_; }
+    bool isEmpty() const { return size_ == 0; }
+    quint64 written() const { return written_; }
+
+    // i = 0 is the oldest sample still stored
+    double time(int i) const { return time_[slot(i)]; }
+    double pose(int i, int row, int col) const { return pose_[packedIndex(row, col)][slot(i)]; }
+    double twist(int i, int row, int col) const { return twist_[packedIndex(row, col)][slot(i)]; }
+    double metric(int i, Metric metric) const { return metrics_[metric][slot(i)]; }
+
+private:
+    static constexpr int packedDiag(int axis) { return axis * DIM + axis; }   // into the 36 array
+
+    static double trace(const double *m)
+    {
+        double sum = 0.0;
+        for (int axis = 0; axis < DIM; ++axis) sum += m[packedDiag(axis)];
+        return sum;
+    }
+
+    static double log10Det(const double *m)
+    {
+        // Cholesky : det = prod( L_ii )^2, summed as logs so tiny variances do not underflow
+        const Eigen::Map<const Eigen::Matrix<double, DIM, DIM, Eigen::RowMajor>> matrix(m);
+        const Eigen::LLT<Eigen::Matrix<double, DIM, DIM>> llt(matrix);
+        if (llt.info() != Eigen::Success) return qQNaN();
+
+        double log_det = 0.0;
+        for (int axis = 0; axis < DIM; ++axis) log_det += std::log10(llt.matrixLLT()(axis, axis));
+        return 2.0 * log_det;
+    }
+
+    int slot(int i) const { return (head_ - size_ + i + capacity_) % capacity_; }
+
+    int capacity_ = 1;
+    QVector<double> time_;
+    std::array<QVector<double>, PACKED> pose_;
+    std::array<QVector<double>, PACKED> twist_;
+    std::array<QVector<double>, METRIC_COUNT> metrics_;
+    int head_ = 0;
+    int size_ = 0;
+    quint64 written_ = 0;
+};
+}
+
+#endif
@@ -0,0 +1,369 @@
+#ifndef ROM_DECIMATION_HPP
+#define ROM_DECIMATION_HPP
+
+#pragma once
+
+#include <QList>
+#include <QPointF>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace rom_dynamics::ui::qt {
+
+// Level of detail for long chart series. Both classes keep every sample and hand the
+// series a subset bounded by the plot width in pixels. Buckets have a fixed power of two
+// size, so finished buckets never change while data streams in; when there are too many
+// buckets the size doubles ( O(n) once per doubling of n -> O(1) amortized per sample ).
+
+//================================================================================
+// 1. min / max buckets, x must not decrease ( time series )
+//================================================================================
+class RomMinMaxLod {
+public:
+    static constexpr int MAX_HISTORY = 1 << 20;
+
+    void setPixelWidth(int px)
+    {
+        px = qMax(16, px);
+        if (px == px_) return;
+        px_ = px;
+        rebuild();
+    }
+
+    void clear()
+    {
+        full_.clear();
+        buckets_.clear();
+        tail_ = Bucket{};
+        bucket_size_ = 1;
+    }
+
+    void append(const QPointF &p)
+    {
+        if (full_.size() >= MAX_HISTORY)
+        {
+            full_.remove(0, MAX_HISTORY / 2);   // keep the newest half, rare
+            full_.append(p);
+            rebuild();
+            return;
+        }
+
+        full_.append(p);
+        add(tail_, p);
+        if (tail_.count == bucket_size_)
+        {
+            buckets_.append(tail_);
+            tail_ = Bucket{};
+            if (buckets_.size() > 2 * px_) coarsen();
+        }
+    }
+
+    int size() const { return full_.size(); }
+    const QList<QPointF> &full() const { return full_; }
+
+    // zoomed in : decimate only the visible slice
+    void setViewRange(double x_min, double x_max) { view_ = true; view_min_ = x_min; view_max_ = x_max; }
+    void clearViewRange() { view_ = false; }
+    bool hasViewRange() const { return view_; }
+
+    QList<QPointF> points() const
+    {
+        QList<QPointF> out;
+        if (full_.isEmpty()) return out;
+
+        if (view_) return visiblePoints();
+
+        out.reserve(buckets_.size() * 2 + 2);
+        for (const Bucket &b : buckets_) emit2(out, b);
+        if (tail_.count > 0) emit2(out, tail_);
+        return out;
+    }
+
+private:
+    struct Bucket {
+        QPointF min;
+        QPointF max;
+        int count = 0;
+    };
+
+    static void add(Bucket &b, const QPointF &p)
+    {
+        if (b.count == 0) { b.min = b.max = p; }
+        else
+        {
+            if (p.y() < b.min.y()) b.min = p;
+            if (p.y() > b.max.y()) b.max = p;
+        }
+        ++b.count;
+    }
+
+    static Bucket merge(const Bucket &a, const Bucket &b)
+    {
+        if (a.count == 0) return b;
+        if (b.count == 0) return a;
+        Bucket m;
+        m.min = b.min.y() < a.min.y() ? b.min : a.min;
+        m.max = b.max.y() > a.max.y() ? b.max : a.max;
+        m.count = a.count + b.count;
+        return m;
+    }
+
+    // min and max in x order, so the line still goes forward
+    static void emit2(QList<QPointF> &out, const Bucket &b)
+    {
+        const QPointF &first  = b.min.x() <= b.max.x() ? b.min : b.max;
+        const QPointF &second = b.min.x() <= b.max.x() ? b.max : b.min;
+        out.append(first);
+        if (second != first) out.append(second);
+    }
+
+    void coarsen()
+    {
+        // pairwise merge of finished buckets, no need to touch the samples
+        QList<Bucket> merged;
+        merged.reserve(buckets_.size() / 2 + 1);
+        int i = 0;
+        for (; i + 1 < buckets_.size(); i += 2) merged.append(merge(buckets_[i], buckets_[i + 1]));
+        if (i < buckets_.size()) tail_ = merge(buckets_[i], tail_);
+        buckets_ = merged;
+        bucket_size_ *= 2;
+    }
+
+    void rebuild()
+    {
+        buckets_.clear();
+        tail_ = Bucket{};
+        bucket_size_ = 1;
+        while (bucket_size_ * 2 * px_ < full_.size()) bucket_size_ *= 2;
+
+        for (const QPointF &p : std::as_const(full_))
+        {
+            add(tail_, p);
+            if (tail_.count == bucket_size_) { buckets_.append(tail_); tail_ = Bucket{}; }
+        }
+    }
+
+    QList<QPointF> visiblePoints() const
+    {
+        auto lo = std::lower_bound(full_.cbegin(), full_.cend(), view_min_,
+                                   [](const QPointF &p, double x) { return p.x() < x; });
+        auto hi = std::upper_bound(lo, full_.cend(), view_max_,
+                                   [](double x, const QPointF &p) { return x < p.x(); });
+        // one neighbour each side so the line reaches the plot edges
+        int first = qMax(0, int(lo - full_.cbegin()) - 1);
+        int last  = qMin(int(full_.size()), int(hi - full_.cbegin()) + 1);
+
+        const int n = last - first;
+        const int per_bucket = qMax(1, (n + px_ - 1) / px_);
+
+        QList<QPointF> out;
+        out.reserve(2 * (n / per_bucket + 1));
+        for (int i = first; i < last; i += per_bucket)
+        {
+            Bucket b;
+            for (int j = i; j < qMin(last, i + per_bucket); ++j) add(b, full_[j]);
+            emit2(out, b);
+        }
+        return out;
+    }
+
+    QList<QPointF> full_;
+    QList<Bucket> buckets_;     // finished buckets of bucket_size_ samples
+    Bucket tail_;               // bucket still filling
+    int bucket_size_ = 1;
+    int px_ = 800;
+
+    bool view_ = false;
+    double view_min_ = 0.0;
+    double view_max_ = 0.0;
+};
+
+//================================================================================
+// 2. largest triangle three buckets, any ordered path ( x / y trajectory )
+//================================================================================
+class RomLttbLod {
+public:
+    static constexpr int MAX_HISTORY = 1 << 20;
+
+    // about two selected points per horizontal pixel
+    void setPixelWidth(int px)
+    {
+        px = qMax(16, px);
+        if (px == px_) return;
+        px_ = px;
+        rebuild();
+    }
+
+    void clear()
+    {
+        full_.clear();
+        selected_.clear();
+        bucket_size_ = 1;
+    }
+
+    void append(const QPointF &p)
+    {
+        if (full_.size() >= MAX_HISTORY)
+        {
+            full_.remove(0, MAX_HISTORY / 2);
+            full_.append(p);
+            rebuild();
+            return;
+        }
+
+        full_.append(p);
+        if (full_.size() == 1)
+        {
+            selected_.append(p);    // first point is always kept
+            return;
+        }
+        sealReadyBuckets();
+        if (selected_.size() > 2 * px_) { bucket_size_ *= 2; reselect(); }
+    }
+
+    int size() const { return full_.size(); }
+    const QList<QPointF> &full() const { return full_; }
+
+    QList<QPointF> points() const
+    {
+        QList<QPointF> out = selected_;
+        if (full_.size() < 2) return out;
+
+        // tail not sealed yet : stride through it, always end on the newest sample
+        const int tail_start = 1 + (selected_.size() - 1) * bucket_size_;
+        for (int i = tail_start; i < full_.size() - 1; i += bucket_size_) out.append(full_[i]);
+        out.append(full_.last());
+        return out;
+    }
+
+private:
+    // bucket k covers full_[1 + k*B, 1 + (k+1)*B), it is sealed once bucket k+1 is complete
+    void sealReadyBuckets()
+    {
+        for (;;)
+        {
+            const int k = selected_.size() - 1;
+            const int next_end = 1 + (k + 2) * bucket_size_;
+            if (next_end > full_.size()) return;
+            selectBucket(k);
+        }
+    }
+
+    void selectBucket(int k)
+    {
+        const int begin = 1 + k * bucket_size_;
+        const int end = begin + bucket_size_;
+
+        // average of the following bucket
+        double ax = 0.0, ay = 0.0;
+        for (int i = end; i < end + bucket_size_; ++i) { ax += full_[i].x(); ay += full_[i].y(); }
+        ax /= bucket_size_; ay /= bucket_size_;
+
+        const QPointF a = selected_.last();
+        double best_area = -1.0;
+        int best = begin;
+        for (int i = begin; i < end; ++i)
+        {
+            const QPointF &p = full_[i];
+            const double area = std::fabs((a.x() - ax) * (p.y() - a.y()) - (a.x() - p.x()) * (ay - a.y()));
+            if (area > best_area) { best_area = area; best = i; }
+        }
+        selected_.append(full_[best]);
+    }
+
+    void reselect()
+    {
+        selected_.clear();
+        if (full_.isEmpty()) return;
+        selected_.append(full_.first());
+        sealReadyBuckets();
+    }
+
+    void rebuild()
+    {
+        bucket_size_ = 1;
+        while (bucket_size_ * 2 * px_ < full_.size()) bucket_size_ *= 2;
+        reselect();
+    }
+
+    QList<QPointF> full_;
+    QList<QPointF> selected_;   // full_[0] + one point per sealed bucket
+    int bucket_size_ = 1;
+    int px_ = 400;
+};
+
+//================================================================================
+// 3. min / max buckets over a sliding time window
+//================================================================================
+// Buckets are aligned to multiples of the bucket width in time, so a bucket is final
+// once a later sample arrived; appending is O(1) and old buckets fall off the front.
+// The samples themselves are not kept ( they live in the caller's columns ).
+class RomWindowMinMax {
+public:
+    // window / plot width, a new width starts over
+    void setBucketWidth(double dt)
+    {
+        dt = qMax(1e-6, dt);
+        if (dt == dt_) return;
+        dt_ = dt;
+        clear();
+    }
+    double bucketWidth() const { return dt_; }
+
+    void clear() { buckets_.clear(); }
+    bool isEmpty() const { return buckets_.isEmpty(); }
+
+    void append(double t, double v)
+    {
+        if (!std::isfinite(v)) return;
+        const QPointF p(t, v);
+        const qint64 key = qint64(std::floor(t / dt_));
+        if (buckets_.isEmpty() || key > buckets_.last().key)
+        {
+            buckets_.append(Bucket{ key, p, p });
+            return;
+        }
+        Bucket &b = buckets_.last();    // same bucket ( or time went back a little )
+        if (v < b.min.y()) b.min = p;
+        if (v > b.max.y()) b.max = p;
+    }
+
+    // returns the number of buckets dropped
+    int trimBefore(double t)
+    {
+        int drop = 0;
+        while (drop < buckets_.size() && double(buckets_[drop].key + 1) * dt_ < t) ++drop;
+        if (drop > 0) buckets_.remove(0, drop);
+        return drop;
+    }
+
+    // min and max of every bucket in x order; y range of what was emitted
+    void points(QList<QPointF> &out, double &y_min, double &y_max) const
+    {
+        out.clear();
+        out.reserve(buckets_.size() * 2);
+        for (const Bucket &b : buckets_)
+        {
+            const QPointF &first  = b.min.x() <= b.max.x() ? b.min : b.max;
+            const QPointF &second = b.min.x() <= b.max.x() ? b.max : b.min;
+            out.append(first);
+            if (second != first) out.append(second);
+            y_min = qMin(y_min, b.min.y());
+            y_max = qMax(y_max, b.max.y());
+        }
+    }
+
+private:
+    struct Bucket {
+        qint64 key = 0;
+        QPointF min;
+        QPointF max;
+    };
+
+    QList<Bucket> buckets_;
+    double dt_ = 0.05;
+};
+}
+
+#endif
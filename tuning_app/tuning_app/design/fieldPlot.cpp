@@ -0,0 +1,506 @@
+#include "fieldPlot.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QJsonArray>
+#include <QMimeData>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QMouseEvent>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+using namespace rom_dynamics::ui::qt;
+
+//================================================================================
+// 1. RomFieldStore
+//================================================================================
+
+bool rom_dynamics::ui::qt::RomFieldStore::splitPath(const QString &full, QString &topic, QString &path)
+{
+    const QString text = full.trimmed();
+    const int dot = text.indexOf('.');
+    if (!text.startsWith('/') || dot < 2 || dot == text.size() - 1) return false;
+    topic = text.left(dot);
+    path = text.mid(dot + 1);
+    return true;
+}
+
+bool rom_dynamics::ui::qt::RomFieldStore::parseSteps(const QString &path, QList<QPair<QString, int>> &steps)
+{
+    // name.name[3].name  or  name.3  ( array element )
+    steps.clear();
+    const QStringList parts = path.split('.');
+    for (const QString &part : parts)
+    {
+        const int bracket = part.indexOf('[');
+        const QString key = bracket < 0 ? part : part.left(bracket);
+
+        bool numeric = false;
+        const int index = key.toInt(&numeric);
+        if (numeric && index >= 0) steps.append({ QString(), index });
+        else if (!key.isEmpty()) steps.append({ key, -1 });
+        else if (bracket != 0) return false;
+
+        for (int open = bracket; open >= 0;)
+        {
+            const int close = part.indexOf(']', open);
+            if (close < 0) return false;
+            bool ok = false;
+            const int element = part.mid(open + 1, close - open - 1).toInt(&ok);
+            if (!ok || element < 0) return false;
+            steps.append({ QString(), element });
+
+            // only another [n] may follow, "a[0]b" is not a path
+            open = close + 1;
+            if (open == part.size()) break;
+            if (part[open] != '[') return false;
+        }
+    }
+    return !steps.isEmpty();
+}
+
+int rom_dynamics::ui::qt::RomFieldStore::acquire(const QString &topic, const QString &path)
+{
+    QList<QPair<QString, int>> steps;
+    if (topic.isEmpty() || !parseSteps(path, steps)) return -1;
+
+    const QString key = topic + "." + path;
+    int id = by_name_.value(key, -1);
+    if (id < 0)
+    {
+        id = fields_.size();
+        Field field;
+        field.topic = topic;
+        field.path = path;
+        fields_.append(field);
+        by_name_.insert(key, id);
+    }
+    if (fields_[id].refs++ > 0) return id;
+
+    // first user : empty column, field joins the topic's extractor
+    Topic &columns = topics_[topic];
+    columns.name = topic;
+    columns.fields.append(id);
+    fields_[id].values = QVector<double>(CAPACITY, qQNaN());
+    rebuildExtractor(topic);
+    return id;
+}
+
+void rom_dynamics::ui::qt::RomFieldStore::release(int field)
+{
+    if (field < 0 || field >= fields_.size() || fields_[field].refs <= 0) return;
+    if (--fields_[field].refs > 0) return;
+
+    const QString topic = fields_[field].topic;
+    fields_[field].values = QVector<double>();
+
+    auto it = topics_.find(topic);
+    if (it == topics_.end()) return;
+    it->fields.removeAll(field);
+    if (it->fields.isEmpty())
+    {
+        topics_.erase(it);
+        extractors_.remove(topic);
+    }
+    else rebuildExtractor(topic);
+}
+
+void rom_dynamics::ui::qt::RomFieldStore::rebuildExtractor(const QString &topic)
+{
+    Extractor extractor;
+    extractor.steps.append(Step());
+
+    QList<QPair<QString, int>> steps;
+    for (int id : std::as_const(topics_[topic].fields))
+    {
+        parseSteps(fields_[id].path, steps);
+
+        int node = 0;
+        for (const auto &step : std::as_const(steps))
+        {
+            int next = -1;
+            for (int child : std::as_const(extractor.steps[node].children))
+            {
+                const Step &s = extractor.steps[child];
+                if (s.key == step.first && s.index == step.second) { next = child; break; }
+            }
+            if (next < 0)
+            {
+                next = extractor.steps.size();
+                Step s;
+                s.key = step.first;
+                s.index = step.second;
+                extractor.steps.append(s);
+                extractor.steps[node].children.append(next);
+            }
+            node = next;
+        }
+        extractor.steps[node].fields.append(id);
+    }
+    extractors_.insert(topic, extractor);
+}
+
+void rom_dynamics::ui::qt::RomFieldStore::append(const QString &topic, const QJsonObject &msg, double t)
+{
+    auto it = topics_.find(topic);
+    if (it == topics_.end()) return;
+
+    Topic &columns = *it;
+    const int slot = columns.head;
+    columns.t[slot] = t;
+    columns.head = (columns.head + 1) % CAPACITY;
+    if (columns.size < CAPACITY) ++columns.size;
+    ++columns.written;
+
+    // a path missing from this message leaves a gap
+    for (int id : std::as_const(columns.fields)) fields_[id].values[slot] = qQNaN();
+    extract(*extractors_.constFind(topic), 0, msg, slot);
+}
+
+void rom_dynamics::ui::qt::RomFieldStore::extract(const Extractor &extractor, int step, const QJsonValue &value, int slot)
+{
+    const Step &s = extractor.steps[step];
+    if (!s.fields.isEmpty())
+    {
+        const double v = value.isDouble() ? value.toDouble() : value.isBool() ? (value.toBool() ? 1.0 : 0.0) : qQNaN();
+        for (int id : s.fields) fields_[id].values[slot] = v;
+    }
+    if (s.children.isEmpty()) return;
+
+    if (value.isObject())
+    {
+        const QJsonObject object = value.toObject();
+        for (int child : s.children)
+        {
+            const Step &c = extractor.steps[child];
+            if (!c.key.isEmpty()) extract(extractor, child, object.value(c.key), slot);
+        }
+    }
+    else if (value.isArray())
+    {
+        const QJsonArray array = value.toArray();
+        for (int child : s.children)
+        {
+            const Step &c = extractor.steps[child];
+            if (c.key.isEmpty()) extract(extractor, child, array.at(c.index), slot);
+        }
+    }
+}
+
+//================================================================================
+// 2. RomFieldPlot
+//================================================================================
+
+rom_dynamics::ui::qt::RomFieldPlot::RomFieldPlot(RomFieldStore *store, QWidget *parent)
+    : QWidget(parent)
+    , store_(store)
+{
+    chart_ = new QChart();
+    chart_->setBackgroundBrush(Qt::NoBrush);
+    chart_->setPlotAreaBackgroundBrush(Qt::NoBrush);
+    chart_->setBackgroundRoundness(0);
+    chart_->setMargins(QMargins(2, 2, 2, 2));
+    chart_->legend()->setLabelColor(QColor(189, 183, 183));
+    chart_->legend()->setAlignment(Qt::AlignTop);
+
+    QFont legendFont;
+    legendFont.setFamily("SF Pro Text");
+    legendFont.setPointSize(7);
+    chart_->legend()->setFont(legendFont);
+
+    axisX_ = new QValueAxis();
+    axisY_ = new QValueAxis();
+
+    QColor axisColor(189, 183, 183, 80);
+    axisX_->setGridLineColor(axisColor);
+    axisY_->setGridLineColor(axisColor);
+    axisX_->setLabelsColor(axisColor);
+    axisY_->setLabelsColor(axisColor);
+    axisX_->setLinePen(QPen(axisColor));
+    axisY_->setLinePen(QPen(axisColor));
+
+    QFont axisFont;
+    axisFont.setFamily("SF Pro Text");
+    axisFont.setPointSize(7);
+    axisX_->setLabelsFont(axisFont);
+    axisY_->setLabelsFont(axisFont);
+    axisX_->setLabelFormat("%.0f");
+    axisY_->setRange(y_min_, y_max_);
+
+    chart_->addAxis(axisX_, Qt::AlignBottom);
+    chart_->addAxis(axisY_, Qt::AlignLeft);
+
+    chart_view_ = new RomChartView(chart_);
+    chart_view_->setAcceptDrops(false);     // drops go to this widget
+    setAcceptDrops(true);
+    setToolTip("drop a numeric field here, double click to clear");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(chart_view_);
+    setLayout(layout);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+bool rom_dynamics::ui::qt::RomFieldPlot::addField(int field)
+{
+    for (const Curve *curve : std::as_const(curves_))
+    {
+        if (curve->field == field) return false;
+    }
+
+    static const QColor palette[] = {
+        QColor(QColorConstants::Svg::orange), QColor("#00bfff"), QColor("#03fc84"), QColor(180, 120, 255),
+        QColor("#ff5c8a"), QColor("#f5e050"), QColor("#5cffd6"), QColor("#c3c9d4"),
+    };
+
+    Curve *curve = new Curve;
+    curve->field = field;
+    curve->series = new QLineSeries();
+    curve->series->setName(store_->name(field));
+    curve->series->setPen(QPen(palette[curves_.size() % int(std::size(palette))], 1.2));
+    chart_->addSeries(curve->series);
+    curve->series->attachAxis(axisX_);
+    curve->series->attachAxis(axisY_);
+    chart_view_->applyBackend();
+
+    curves_.append(curve);
+    return true;
+}
+
+void rom_dynamics::ui::qt::RomFieldPlot::clear()
+{
+    const QList<int> removed = fields();
+    for (Curve *curve : std::as_const(curves_))
+    {
+        chart_->removeSeries(curve->series);
+        delete curve->series;
+        delete curve;
+    }
+    curves_.clear();
+    y_min_ = -1.0;
+    y_max_ = 1.0;
+    axisY_->setRange(y_min_, y_max_);
+
+    if (!removed.isEmpty()) emit fieldsCleared(removed);
+}
+
+QList<int> rom_dynamics::ui::qt::RomFieldPlot::fields() const
+{
+    QList<int> out;
+    for (const Curve *curve : curves_) out.append(curve->field);
+    return out;
+}
+
+void rom_dynamics::ui::qt::RomFieldPlot::refresh(double now, double window_sec)
+{
+    axisX_->setRange(now - window_sec, now);
+    if (curves_.isEmpty()) return;
+
+    // bucket width follows the plot width, a new width rebuilds from the columns
+    const int px = qMax(64, int(chart_->plotArea().width()));
+    const double dt = window_sec / px;
+
+    double y_min = std::numeric_limits<double>::max();
+    double y_max = std::numeric_limits<double>::lowest();
+
+    for (Curve *curve : std::as_const(curves_))
+    {
+        const RomFieldStore::Topic &topic = store_->topicOf(curve->field);
+        const QVector<double> &values = store_->values(curve->field);
+
+        if (curve->lod.bucketWidth() != dt)
+        {
+            curve->lod.setBucketWidth(dt);
+            curve->consumed = 0;
+        }
+
+        quint64 fresh = topic.written - curve->consumed;
+        if (fresh > quint64(topic.size))
+        {
+            curve->lod.clear();
+            fresh = quint64(topic.size);
+        }
+        for (int i = topic.size - int(fresh); i < topic.size; ++i)
+        {
+            const int slot = topic.slot(i);
+            curve->lod.append(topic.t[slot], values[slot]);
+        }
+        curve->consumed = topic.written;
+
+        const int dropped = curve->lod.trimBefore(now - window_sec);
+        if (fresh > 0 || dropped > 0)
+        {
+            double c_min = std::numeric_limits<double>::max();
+            double c_max = std::numeric_limits<double>::lowest();
+            curve->lod.points(scratch_, c_min, c_max);
+            curve->series->replace(scratch_);
+            curve->y_min = c_min;
+            curve->y_max = c_max;
+        }
+        if (!curve->lod.isEmpty())
+        {
+            y_min = qMin(y_min, curve->y_min);
+            y_max = qMax(y_max, curve->y_max);
+        }
+    }
+
+    if (y_min > y_max) return;
+    if (y_max - y_min < 1e-9) { y_min -= 0.5; y_max += 0.5; }
+    const double pad = (y_max - y_min) * 0.05;
+    if (y_min - pad != y_min_ || y_max + pad != y_max_)
+    {
+        y_min_ = y_min - pad;
+        y_max_ = y_max + pad;
+        axisY_->setRange(y_min_, y_max_);
+    }
+}
+
+void rom_dynamics::ui::qt::RomFieldPlot::dragEnterEvent(QDragEnterEvent *event)
+{
+    if (event->mimeData()->hasFormat(ROM_FIELD_MIME) || event->mimeData()->hasText()) event->acceptProposedAction();
+}
+
+void rom_dynamics::ui::qt::RomFieldPlot::dropEvent(QDropEvent *event)
+{
+    const QMimeData *mime = event->mimeData();
+    if (mime->hasFormat(ROM_FIELD_MIME))
+    {
+        const QStringList parts = QString::fromUtf8(mime->data(ROM_FIELD_MIME)).split('\n');
+        if (parts.size() == 3) emit fieldDropped(parts[0], parts[1], parts[2]);
+    }
+    else
+    {
+        QString topic, path;
+        if (RomFieldStore::splitPath(mime->text(), topic, path)) emit fieldDropped(topic, QString(), path);
+    }
+    event->acceptProposedAction();
+}
+
+void rom_dynamics::ui::qt::RomFieldPlot::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    clear();
+    event->accept();
+}
+
+//================================================================================
+// 3. RomFieldPlotPanel
+//================================================================================
+
+rom_dynamics::ui::qt::RomFieldPlotPanel::RomFieldPlotPanel(QWidget *parent)
+    : QWidget(parent)
+{
+    const QString btnStyle = "QPushButton { color: #c3c9d4; border-radius: 4px; border: 1px solid #c3c9d4; padding: 2px 10px; }"
+                             "QPushButton:hover { color: white; border: 1px solid orange; }";
+
+    pathEdit_ = new QLineEdit(this);
+    pathEdit_->setPlaceholderText("/odom.twist.twist.angular.z  ( or drag a field from the inspector )");
+    pathEdit_->setStyleSheet("color: #c3c9d4; font: 11px; border: 1px solid #555; border-radius: 3px;");
+    connect(pathEdit_, &QLineEdit::returnPressed, this, [this]() {
+        QString topic, path;
+        if (!RomFieldStore::splitPath(pathEdit_->text(), topic, path))
+        {
+            status_->setText("expected /topic.field.field");
+            return;
+        }
+        addPath(plots_.first(), topic, QString(), path);
+        pathEdit_->clear();
+    });
+
+    clearBtn_ = new QPushButton("Clear", this);
+    clearBtn_->setStyleSheet(btnStyle);
+    connect(clearBtn_, &QPushButton::clicked, this, [this]() {
+        for (RomFieldPlot *plot : std::as_const(plots_)) plot->clear();
+    });
+
+    QHBoxLayout *top = new QHBoxLayout();
+    top->addWidget(pathEdit_, 1);
+    top->addWidget(clearBtn_);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(4, 0, 8, 8);
+    layout->addLayout(top);
+
+    for (int i = 0; i < PLOTS; ++i)
+    {
+        RomFieldPlot *plot = new RomFieldPlot(&store_, this);
+        connect(plot, &RomFieldPlot::fieldDropped, this, [this, plot](const QString &topic, const QString &type, const QString &path) {
+            addPath(plot, topic, type, path);
+        });
+        connect(plot, &RomFieldPlot::fieldsCleared, this, &RomFieldPlotPanel::releaseFields);
+        plots_.append(plot);
+        layout->addWidget(plot, 1);
+    }
+
+    status_ = new QLabel(this);
+    status_->setStyleSheet("color: #bdb7b7; font-size: 10px;");
+    layout->addWidget(status_);
+    setLayout(layout);
+
+    clock_.start();
+    frameTimer_.setInterval(REFRESH_MS);
+    connect(&frameTimer_, &QTimer::timeout, this, &RomFieldPlotPanel::refresh);
+    frameTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomFieldPlotPanel::onMessage(const QString &topic, const QJsonObject &msg)
+{
+    if (!store_.hasTopic(topic)) return;
+
+    QElapsedTimer timer;
+    timer.start();
+    store_.append(topic, msg, clock_.nsecsElapsed() * 1e-9);
+    extractUs_ += (timer.nsecsElapsed() / 1000.0 - extractUs_) * 0.05;
+    ++samples_;
+}
+
+void rom_dynamics::ui::qt::RomFieldPlotPanel::addPath(RomFieldPlot *plot, const QString &topic, const QString &type, const QString &path)
+{
+    const bool new_topic = !store_.hasTopic(topic);
+    const int field = store_.acquire(topic, path);
+    if (field < 0)
+    {
+        status_->setText(QString("can not plot %1.%2").arg(topic, path));
+        return;
+    }
+    if (!type.isEmpty()) types_.insert(topic, type);
+
+    // already on this plot : drop the extra reference
+    if (!plot->addField(field)) store_.release(field);
+    else if (new_topic) emit topicNeeded(topic, types_.value(topic), true);
+}
+
+void rom_dynamics::ui::qt::RomFieldPlotPanel::releaseFields(const QList<int> &fields)
+{
+    for (int field : fields)
+    {
+        const QString topic = store_.topicOf(field).name;
+        store_.release(field);
+        if (!store_.hasTopic(topic)) emit topicNeeded(topic, types_.value(topic), false);
+    }
+}
+
+void rom_dynamics::ui::qt::RomFieldPlotPanel::refresh()
+{
+    if (!isVisible()) return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const double now = clock_.nsecsElapsed() * 1e-9;
+    int curves = 0;
+    for (RomFieldPlot *plot : std::as_const(plots_))
+    {
+        plot->refresh(now, WINDOW_SEC);
+        curves += plot->fields().size();
+    }
+
+    renderMs_ += (timer.nsecsElapsed() / 1e6 - renderMs_) * 0.05;
+    if (curves > 0)
+    {
+        status_->setText(QString("%1 curves, %2 topics  |  %3 samples  |  extract %4 us/msg  |  decimate + upload %5 ms/frame")
+                         .arg(curves).arg(store_.topics().size()).arg(samples_)
+                         .arg(extractUs_, 0, 'f', 1).arg(renderMs_, 0, 'f', 2));
+    }
+}
@@ -0,0 +1,193 @@
+#ifndef ROM_FIELD_PLOT_HPP
+#define ROM_FIELD_PLOT_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QJsonObject>
+#include <QtCharts/QChart>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include "decimation.hpp"
+#include "romChartView.hpp"
+
+namespace rom_dynamics::ui::qt {
+
+// drag payload of a numeric leaf : "topic\ntype\npath"
+inline constexpr const char *ROM_FIELD_MIME = "application/x-rom-field";
+
+//================================================================================
+// 1. columnar sample store
+//================================================================================
+// One time column per topic and one value column per field, all rings of CAPACITY
+// slots indexed by the topic's head, so every field of a topic shares the time
+// column. A field exists once however many plots show it ( reference counted ).
+// Each topic has one extractor : the field paths compiled into a trie, so a message
+// is walked once and shared prefixes ( twist.twist ) are looked up once.
+class RomFieldStore {
+public:
+    static constexpr int CAPACITY = 1 << 14;
+
+    struct Topic {
+        QString name;
+        QVector<double> t = QVector<double>(CAPACITY);
+        int head = 0;
+        int size = 0;
+        quint64 written = 0;
+        QList<int> fields;
+
+        int slot(int i) const { return (head - size + i + CAPACITY) % CAPACITY; }   // i = 0 : oldest
+    };
+
+    // "/odom.twist.twist.angular.z", "/imu.orientation_covariance[8]"
+    static bool splitPath(const QString &full, QString &topic, QString &path);
+
+    // returns the field id, -1 for an unparsable path
+    int acquire(const QString &topic, const QString &path);
+    void release(int field);
+
+    bool hasTopic(const QString &topic) const { return topics_.contains(topic); }
+    QStringList topics() const { return topics_.keys(); }
+
+    void append(const QString &topic, const QJsonObject &msg, double t);
+
+    const Topic &topicOf(int field) const { return *topics_.constFind(fields_[field].topic); }
+    const QVector<double> &values(int field) const { return fields_[field].values; }
+    QString name(int field) const { return fields_[field].topic + "." + fields_[field].path; }
+
+private:
+    struct Field {
+        QString topic;
+        QString path;
+        int refs = 0;
+        QVector<double> values;
+    };
+
+    // one trie per topic, node 0 is the message
+    struct Step {
+        QString key;            // empty : array element
+        int index = -1;
+        QList<int> children;
+        QList<int> fields;      // fields that end here
+    };
+    struct Extractor {
+        QVector<Step> steps;
+    };
+
+    static bool parseSteps(const QString &path, QList<QPair<QString, int>> &steps);
+    void rebuildExtractor(const QString &topic);
+    void extract(const Extractor &extractor, int step, const QJsonValue &value, int slot);
+
+    QHash<QString, Topic> topics_;
+    QHash<QString, Extractor> extractors_;
+    QHash<QString, int> by_name_;        // topic.path -> field
+    QVector<Field> fields_;             // released fields keep their slot ( refs == 0 )
+};
+
+//================================================================================
+// 2. one chart, fields are dropped onto it
+//================================================================================
+class RomFieldPlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    RomFieldPlot(RomFieldStore *store, QWidget *parent = nullptr);
+    ~RomFieldPlot() override = default;
+
+    bool addField(int field);
+    void clear();
+    QList<int> fields() const;
+
+    // now : store clock, seconds
+    void refresh(double now, double window_sec);
+
+signals:
+    void fieldDropped(const QString &topic, const QString &type, const QString &path);
+    void fieldsCleared(const QList<int> &fields);
+
+protected:
+    void dragEnterEvent(QDragEnterEvent *event) override;
+    void dropEvent(QDropEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    struct Curve {
+        int field = -1;
+        RomWindowMinMax lod;
+        quint64 consumed = 0;       // topic.written already in lod
+        QLineSeries *series = nullptr;
+        double y_min = 0.0;         // of the points last given to the series
+        double y_max = 0.0;
+    };
+
+    RomFieldStore *store_;
+    RomChartView *chart_view_;
+    QChart *chart_;
+    QValueAxis *axisX_;
+    QValueAxis *axisY_;
+    QList<Curve*> curves_;
+    QList<QPointF> scratch_;
+    double y_min_ = -1.0;
+    double y_max_ = 1.0;
+};
+
+//================================================================================
+// 3. panel : path entry + plots
+//================================================================================
+// Samples are stamped with the receive time, so topics with and without a header
+// share one time axis. Every REFRESH_MS each curve feeds only the samples that
+// arrived since the last frame into its min / max buckets ( bucket = window / plot
+// width ), the series gets about two points per pixel column.
+class RomFieldPlotPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_MS = 33;
+    static constexpr double WINDOW_SEC = 30.0;
+    static constexpr int PLOTS = 2;
+
+    explicit RomFieldPlotPanel(QWidget *parent = nullptr);
+    ~RomFieldPlotPanel() override = default;
+
+    bool hasTopic(const QString &topic) const { return store_.hasTopic(topic); }
+    QStringList topics() const { return store_.topics(); }
+
+    // topic as in /rosapi/topics ( absolute )
+    void onMessage(const QString &topic, const QJsonObject &msg);
+
+signals:
+    // first field of a topic added / last one removed; type is empty when typed in
+    void topicNeeded(const QString &topic, const QString &type, bool on);
+
+private:
+    void addPath(RomFieldPlot *plot, const QString &topic, const QString &type, const QString &path);
+    void releaseFields(const QList<int> &fields);
+    void refresh();
+
+    RomFieldStore store_;
+    QElapsedTimer clock_;
+    QLineEdit *pathEdit_;
+    QPushButton *clearBtn_;
+    QLabel *status_;
+    QList<RomFieldPlot*> plots_;
+    QHash<QString, QString> types_;     // topic -> type, from drops
+    QTimer frameTimer_;
+
+    quint64 samples_ = 0;
+    double extractUs_ = 0.0;    // EWMA per message
+    double renderMs_ = 0.0;     // EWMA per frame
+};
+
+}
+
+#endif // ROM_FIELD_PLOT_HPP
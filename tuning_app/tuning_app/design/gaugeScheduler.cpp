@@ -0,0 +1,96 @@
+#include "gaugeScheduler.hpp"
+
+#include <QWidget>
+#include <QWindow>
+#include <QScreen>
+#include <QVariant>
+#include <QtMath>
+
+rom_dynamics::ui::qt::GaugeUpdateScheduler::GaugeUpdateScheduler(QObject *parent)
+    : QObject(parent)
+{
+    frame_timer_.setTimerType(Qt::PreciseTimer);
+    setFrameRate(60.0);
+    connect(&frame_timer_, &QTimer::timeout, this, &GaugeUpdateScheduler::onFrame);
+}
+
+int rom_dynamics::ui::qt::GaugeUpdateScheduler::addGauge(QObject *target, const QByteArray &property, bool integral)
+{
+    Gauge gauge;
+    gauge.target = target;
+    gauge.property = property;
+    gauge.integral = integral;
+    gauges_.append(gauge);
+    return gauges_.size() - 1;
+}
+
+void rom_dynamics::ui::qt::GaugeUpdateScheduler::setTarget(int gauge, QObject *target)
+{
+    if (gauge < 0 || gauge >= gauges_.size()) return;
+    gauges_[gauge].target = target;
+    gauges_[gauge].has_shown = false;
+    gauges_[gauge].dirty = true;
+}
+
+void rom_dynamics::ui::qt::GaugeUpdateScheduler::setValue(int gauge, double value)
+{
+    if (gauge < 0 || gauge >= gauges_.size()) return;
+
+    Gauge &g = gauges_[gauge];
+    g.latest = value;
+    g.dirty = true;
+    ++values_written_;
+}
+
+void rom_dynamics::ui::qt::GaugeUpdateScheduler::setFrameRate(double hz)
+{
+    hz = qBound(10.0, hz, 240.0);
+    frame_timer_.setInterval(qMax(1, qFloor(1000.0 / hz)));
+}
+
+void rom_dynamics::ui::qt::GaugeUpdateScheduler::start()
+{
+    frame_timer_.start();
+}
+
+void rom_dynamics::ui::qt::GaugeUpdateScheduler::stop()
+{
+    frame_timer_.stop();
+}
+
+double rom_dynamics::ui::qt::GaugeUpdateScheduler::refreshRateFor(const QWidget *widget)
+{
+    const QWidget *top = widget ? widget->window() : nullptr;
+    const QWindow *handle = top ? top->windowHandle() : nullptr;
+    const QScreen *screen = handle ? handle->screen() : nullptr;
+    const double hz = screen ? screen->refreshRate() : 0.0;
+    return hz > 1.0 ? hz : 60.0;
+}
+
+void rom_dynamics::ui::qt::GaugeUpdateScheduler::onFrame()
+{
+    for (Gauge &g : gauges_)
+    {
+        if (!g.dirty) continue;
+        g.dirty = false;
+
+        if (!g.target) continue;
+
+        // unchanged on screen -> no property write, no canvas repaint
+        if (g.integral)
+        {
+            const int value = qRound(g.latest);
+            if (g.has_shown && value == qRound(g.shown)) continue;
+            g.target->setProperty(g.property.constData(), value);
+        }
+        else
+        {
+            if (g.has_shown && qFuzzyCompare(1.0 + g.latest, 1.0 + g.shown)) continue;
+            g.target->setProperty(g.property.constData(), g.latest);
+        }
+
+        g.shown = g.latest;
+        g.has_shown = true;
+        ++values_pushed_;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef ROM_GAUGE_SCHEDULER_HPP
+#define ROM_GAUGE_SCHEDULER_HPP
+
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QList>
+#include <QByteArray>
+
+namespace rom_dynamics::ui::qt {
+
+// Latest-value store between the decode path and the gauges.
+// setValue() only writes the store; once per display frame the scheduler pushes
+// the values that changed since the last frame. A 100 Hz topic therefore costs at
+// most one gauge repaint per frame instead of one per message.
+class GaugeUpdateScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GaugeUpdateScheduler(QObject *parent = nullptr);
+    ~GaugeUpdateScheduler() override = default;
+
+    // integral gauges ( rpm ) are pushed as int and skip sub-unit changes
+    int addGauge(QObject *target, const QByteArray &property = "speed", bool integral = false);
+    void setTarget(int gauge, QObject *target);
+
+    // decode path, any rate
+    void setValue(int gauge, double value);
+
+    // frame rate follows the screen refresh ( see refreshRateFor ), ~60 Hz when unknown
+    void setFrameRate(double hz);
+    void start();
+    void stop();
+    bool isRunning() const { return frame_timer_.isActive(); }
+
+    // screen refresh rate of the widget's window, 60 when it is not shown yet
+    static double refreshRateFor(const QWidget *widget);
+
+    quint64 valuesWritten() const { return values_written_; }
+    quint64 valuesPushed() const { return values_pushed_; }
+
+private slots:
+    void onFrame();
+
+private:
+    struct Gauge {
+        QPointer<QObject> target;
+        QByteArray property;
+        bool integral = false;
+        double latest = 0.0;
+        double shown = 0.0;
+        bool has_shown = false;
+        bool dirty = false;
+    };
+
+    QList<Gauge> gauges_;
+    QTimer frame_timer_;
+    quint64 values_written_ = 0;
+    quint64 values_pushed_ = 0;
+};
+}
+
+#endif
@@ -0,0 +1,306 @@
+#include "logView.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QDateTime>
+#include <QColor>
+#include <algorithm>
+
+using namespace rom_dynamics::ui::qt;
+using rom_dynamics::communication::LogStore;
+
+//================================================================================
+// 1. RomLogModel
+//================================================================================
+
+rom_dynamics::ui::qt::RomLogModel::RomLogModel(LogStore *store, QObject *parent)
+    : QAbstractTableModel(parent), store_(store)
+{
+    first_ = store_->firstId();
+    end_ = store_->endId();
+}
+
+void rom_dynamics::ui::qt::RomLogModel::setFilter(const LogStore::Filter &filter)
+{
+    beginResetModel();
+    filter_ = filter;
+    requery();
+    endResetModel();
+}
+
+void rom_dynamics::ui::qt::RomLogModel::requery()
+{
+    first_ = store_->firstId();
+    end_ = store_->endId();
+    all_ = filter_.isEmpty();
+    ids_.clear();
+    cachedId_ = ~quint64(0);
+
+    if (all_) return;
+    QElapsedTimer clock;
+    clock.start();
+    store_->query(filter_, first_, ids_);
+    queryMs_ = clock.nsecsElapsed() / 1e6;
+}
+
+bool rom_dynamics::ui::qt::RomLogModel::refresh()
+{
+    const quint64 first = store_->firstId();
+    const quint64 end = store_->endId();
+
+    if (first > end_)
+    {
+        // everything shown is gone ( clear, or the store moved on by more than it keeps )
+        beginResetModel();
+        requery();
+        endResetModel();
+        return end_ > first_;
+    }
+
+    if (first > first_)
+    {
+        const int dropped = all_ ? int(first - first_)
+                                 : int(std::lower_bound(ids_.cbegin(), ids_.cend(), first) - ids_.cbegin());
+        if (dropped > 0)
+        {
+            beginRemoveRows(QModelIndex(), 0, dropped - 1);
+            if (!all_) ids_.remove(0, dropped);
+            first_ = first;
+            endRemoveRows();
+        }
+        first_ = first;
+    }
+
+    if (end <= end_) return false;
+
+    if (all_)
+    {
+        const int rows = rowCount();
+        beginInsertRows(QModelIndex(), rows, rows + int(end - end_) - 1);
+        end_ = end;
+        endInsertRows();
+        return true;
+    }
+
+    QVector<quint64> fresh;
+    store_->query(filter_, end_, fresh);
+    end_ = end;
+    if (fresh.isEmpty()) return false;
+
+    const int rows = ids_.size();
+    beginInsertRows(QModelIndex(), rows, rows + fresh.size() - 1);
+    ids_ += fresh;
+    endInsertRows();
+    return true;
+}
+
+const LogStore::Entry *rom_dynamics::ui::qt::RomLogModel::entryAt(int row) const
+{
+    const quint64 id = idAt(row);
+    if (id != cachedId_)
+    {
+        cachedId_ = id;
+        cachedOk_ = store_->entry(id, cached_);
+    }
+    return cachedOk_ ? &cached_ : nullptr;
+}
+
+int rom_dynamics::ui::qt::RomLogModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) return 0;
+    return all_ ? int(end_ - first_) : ids_.size();
+}
+
+int rom_dynamics::ui::qt::RomLogModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : COLUMN_COUNT;
+}
+
+QVariant rom_dynamics::ui::qt::RomLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) return QVariant();
+    if (role != Qt::DisplayRole && role != Qt::ForegroundRole && role != Qt::ToolTipRole) return QVariant();
+
+    const LogStore::Entry *entry = entryAt(index.row());
+    if (!entry) return role == Qt::DisplayRole && index.column() == Message ? QVariant("( not readable )") : QVariant();
+
+    if (role == Qt::ForegroundRole)
+    {
+        static const QColor colors[LogStore::kLevels] = {
+            QColor("#8a8f98"), QColor("#c3c9d4"), QColor("orange"), QColor("#ff5555"), QColor("#ff55ff") };
+        return colors[entry->level];
+    }
+    if (role == Qt::ToolTipRole)
+        return index.column() == Message ? QVariant(entry->text) : QVariant();
+
+    switch (index.column())
+    {
+        case Time:
+            return QDateTime::fromMSecsSinceEpoch(entry->stamp_ns / 1000000).toString("HH:mm:ss.zzz");
+        case Level:
+            return QString(LogStore::levelName(entry->level));
+        case Node:
+            return entry->node < store_->nodeNames().size() ? store_->nodeNames().at(entry->node) : QString();
+        case Message:
+            return entry->text;
+        default:
+            return QVariant();
+    }
+}
+
+QVariant rom_dynamics::ui::qt::RomLogModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    static const char *titles[COLUMN_COUNT] = { "time", "level", "node", "message" };
+    return section >= 0 && section < COLUMN_COUNT ? QVariant(titles[section]) : QVariant();
+}
+
+//================================================================================
+// 2. RomLogView
+//================================================================================
+
+rom_dynamics::ui::qt::RomLogView::RomLogView(LogStore *store, QWidget *parent)
+    : QWidget(parent), store_(store)
+{
+    const QString btnStyle = "QPushButton { color: #c3c9d4; border-radius: 4px; border: 1px solid #c3c9d4; padding: 2px 10px; }"
+                             "QPushButton:hover { color: white; border: 1px solid orange; }";
+    const QString editStyle = "color: #c3c9d4; font: 11px; border: 1px solid #555; border-radius: 3px;";
+
+    levelBox_ = new QComboBox(this);
+    levelBox_->addItems({ "DEBUG +", "INFO +", "WARN +", "ERROR +", "FATAL" });
+    levelBox_->setStyleSheet(editStyle);
+    connect(levelBox_, &QComboBox::currentIndexChanged, this, &RomLogView::applyFilter);
+
+    nodeBox_ = new QComboBox(this);
+    nodeBox_->addItem("all nodes");
+    nodeBox_->setMinimumWidth(180);
+    nodeBox_->setStyleSheet(editStyle);
+    connect(nodeBox_, &QComboBox::currentIndexChanged, this, &RomLogView::applyFilter);
+
+    searchEdit_ = new QLineEdit(this);
+    searchEdit_->setPlaceholderText("search words");
+    searchEdit_->setStyleSheet(editStyle);
+    searchTimer_.setSingleShot(true);
+    searchTimer_.setInterval(SEARCH_DELAY_MS);
+    connect(&searchTimer_, &QTimer::timeout, this, &RomLogView::applyFilter);
+    connect(searchEdit_, &QLineEdit::textChanged, this, [this]() { searchTimer_.start(); });
+
+    followBox_ = new QCheckBox("follow", this);
+    followBox_->setChecked(true);
+    followBox_->setStyleSheet("color: #c3c9d4; font: 11px;");
+
+    clearBtn_ = new QPushButton("Clear", this);
+    clearBtn_->setStyleSheet(btnStyle);
+    connect(clearBtn_, &QPushButton::clicked, this, [this]() {
+        store_->clear();
+        refresh();
+    });
+
+    QHBoxLayout *top = new QHBoxLayout();
+    top->addWidget(levelBox_);
+    top->addWidget(nodeBox_);
+    top->addWidget(searchEdit_, 1);
+    top->addWidget(followBox_);
+    top->addWidget(clearBtn_);
+
+    model_ = new RomLogModel(store_, this);
+
+    // fixed row height and column widths : the view never measures rows it does not show
+    view_ = new QTableView(this);
+    view_->setModel(model_);
+    view_->verticalHeader()->setVisible(false);
+    view_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view_->verticalHeader()->setDefaultSectionSize(16);
+    view_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    view_->horizontalHeader()->setStretchLastSection(true);
+    view_->setColumnWidth(RomLogModel::Time, 90);
+    view_->setColumnWidth(RomLogModel::Level, 50);
+    view_->setColumnWidth(RomLogModel::Node, 160);
+    view_->setWordWrap(false);
+    view_->setShowGrid(false);
+    view_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view_->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view_->setStyleSheet("QTableView { color: #c3c9d4; font: 10px; border: 1px solid #444; }"
+                         "QHeaderView::section { color: #bdb7b7; background: #2e2e2e; border: 0px; font: 10px; }");
+    // scrolling up to read stops following, back at the bottom follows again
+    connect(view_->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+        followBox_->setChecked(value == view_->verticalScrollBar()->maximum());
+    });
+
+    status_ = new QLabel("/rosout", this);
+    status_->setStyleSheet("color: #03fc84; font: 10px;");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->addLayout(top);
+    layout->addWidget(view_, 1);
+    layout->addWidget(status_);
+    setLayout(layout);
+
+    refreshTimer_.setInterval(REFRESH_MS);
+    connect(&refreshTimer_, &QTimer::timeout, this, &RomLogView::refresh);
+}
+
+void rom_dynamics::ui::qt::RomLogView::setActive(bool active)
+{
+    if (!active)
+    {
+        refreshTimer_.stop();
+        return;
+    }
+    rateEnd_ = store_->endId();
+    rate_ = 0.0;
+    rateClock_.start();
+    refresh();
+    refreshTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomLogView::applyFilter()
+{
+    LogStore::Filter filter;
+    filter.min_level = levelBox_->currentIndex();
+    if (nodeBox_->currentIndex() > 0) filter.nodes.append(quint16(nodeBox_->currentIndex() - 1));
+    filter.text = searchEdit_->text();
+
+    model_->setFilter(filter);
+    if (followBox_->isChecked()) view_->scrollToBottom();
+    refresh();
+}
+
+void rom_dynamics::ui::qt::RomLogView::updateNodes()
+{
+    // node ids only grow, so the combo only appends
+    const QStringList &names = store_->nodeNames();
+    for (int i = nodeBox_->count() - 1; i < names.size(); ++i) nodeBox_->addItem(names[i]);
+}
+
+void rom_dynamics::ui::qt::RomLogView::refresh()
+{
+    updateNodes();
+
+    const bool follow = followBox_->isChecked();
+    if (model_->refresh() && follow) view_->scrollToBottom();
+
+    const qint64 elapsed = rateClock_.isValid() ? rateClock_.elapsed() : 0;
+    if (elapsed >= 1000)
+    {
+        const double rate = (store_->endId() - rateEnd_) * 1000.0 / elapsed;
+        rate_ = rate_ == 0.0 ? rate : 0.7 * rate_ + 0.3 * rate;
+        rateEnd_ = store_->endId();
+        rateClock_.restart();
+    }
+
+    const quint64 lines = store_->endId() - store_->firstId();
+    QString text = QString("%1 lines  ( %2 in memory %3 / %4 MB, %5 MB on disk )  |  %6 lines/s")
+                       .arg(lines)
+                       .arg(store_->residentLines())
+                       .arg(store_->memoryBytes() / 1048576.0, 0, 'f', 1)
+                       .arg(store_->memoryBudget() / 1048576.0, 0, 'f', 0)
+                       .arg(store_->diskBytes() / 1048576.0, 0, 'f', 1)
+                       .arg(rate_, 0, 'f', 0);
+    if (!model_->filter().isEmpty())
+        text += QString("  |  %1 match  ( %2 ms )").arg(model_->rowCount()).arg(model_->queryMs(), 0, 'f', 1);
+    status_->setText(text);
+}
@@ -0,0 +1,109 @@
+#ifndef ROM_LOG_VIEW_HPP
+#define ROM_LOG_VIEW_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include "../communication/log_store.hpp"
+
+namespace rom_dynamics::ui::qt {
+
+//================================================================================
+// 1. rows of a LogStore query
+//================================================================================
+// Unfiltered, a row is firstId() + row and nothing is kept per line; filtered, the model
+// holds the matching ids. Text is only made for the rows the view asks for, and refresh()
+// only queries the lines appended since the last call.
+class RomLogModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { Time, Level, Node, Message, COLUMN_COUNT };
+
+    RomLogModel(rom_dynamics::communication::LogStore *store, QObject *parent = nullptr);
+
+    void setFilter(const rom_dynamics::communication::LogStore::Filter &filter);
+    const rom_dynamics::communication::LogStore::Filter &filter() const { return filter_; }
+
+    // rows for lines appended / dropped since the last call, true when rows were added
+    bool refresh();
+
+    double queryMs() const { return queryMs_; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    quint64 idAt(int row) const { return all_ ? first_ + row : ids_[row]; }
+    const rom_dynamics::communication::LogStore::Entry *entryAt(int row) const;
+    void requery();
+
+    rom_dynamics::communication::LogStore *store_;
+    rom_dynamics::communication::LogStore::Filter filter_;
+    bool all_ = true;
+    QVector<quint64> ids_;
+    quint64 first_ = 0;         // store range the rows cover
+    quint64 end_ = 0;
+    double queryMs_ = 0.0;
+
+    // the view asks every column and role of a row in a row
+    mutable quint64 cachedId_ = ~quint64(0);
+    mutable bool cachedOk_ = false;
+    mutable rom_dynamics::communication::LogStore::Entry cached_;
+};
+
+//================================================================================
+// 2. log tab : filters + virtualized table
+//================================================================================
+class RomLogView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_MS = 100;
+    static constexpr int SEARCH_DELAY_MS = 150;
+
+    RomLogView(rom_dynamics::communication::LogStore *store, QWidget *parent = nullptr);
+    ~RomLogView() override = default;
+
+    // the table only follows the store while the tab is shown
+    void setActive(bool active);
+
+private:
+    void applyFilter();
+    void refresh();
+    void updateNodes();
+
+    rom_dynamics::communication::LogStore *store_;
+    RomLogModel *model_;
+    QTableView *view_;
+    QComboBox *levelBox_;
+    QComboBox *nodeBox_;
+    QLineEdit *searchEdit_;
+    QCheckBox *followBox_;
+    QPushButton *clearBtn_;
+    QLabel *status_;
+
+    QTimer refreshTimer_;
+    QTimer searchTimer_;
+    QElapsedTimer rateClock_;
+    quint64 rateEnd_ = 0;
+    double rate_ = 0.0;         // lines / s
+};
+
+}
+
+#endif // ROM_LOG_VIEW_HPP
@@ -0,0 +1,651 @@
+#include "messageInspector.hpp"
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QJsonDocument>
+#include <QColor>
+#include <QMimeData>
+#include <cmath>
+
+using namespace rom_dynamics::ui::qt;
+using rom_dynamics::communication::ServiceResult;
+
+//================================================================================
+// 1. RomMessageSchema
+//================================================================================
+
+bool rom_dynamics::ui::qt::RomMessageSchema::load(const QString &root_type, const QJsonObject &values, QString *error)
+{
+    types_.clear();
+    root_ = -1;
+
+    const QJsonArray defs = values.value("typedefs").toArray();
+    QHash<QString, int> by_name;
+    for (const QJsonValue &def : defs)
+    {
+        Type type;
+        type.name = normalize(def.toObject().value("type").toString());
+        by_name.insert(type.name, types_.size());
+        types_.append(type);
+    }
+
+    for (int i = 0; i < defs.size(); ++i)
+    {
+        const QJsonObject def = defs[i].toObject();
+        const QJsonArray names = def.value("fieldnames").toArray();
+        const QJsonArray field_types = def.value("fieldtypes").toArray();
+        const QJsonArray lengths = def.value("fieldarraylen").toArray();
+
+        for (int j = 0; j < names.size(); ++j)
+        {
+            Field field;
+            field.name = names[j].toString();
+            field.type = field_types.at(j).toString();
+            field.array_len = lengths.at(j).toInt(-1);
+
+            const QString base = normalize(field.type);
+            auto it = by_name.constFind(base);
+            if (it != by_name.constEnd())
+            {
+                field.type_index = *it;
+                field.kind = (base == "builtin_interfaces/Time" || base == "builtin_interfaces/Duration") ? Stamp : Message;
+            }
+            else
+            {
+                field.kind = primitiveKind(field.type);
+                if (field.array_len != -1 && (base == "uint8" || base == "byte" || base == "char" || base == "octet")) field.kind = Bytes;
+            }
+            types_[i].fields.append(field);
+        }
+    }
+
+    root_ = by_name.value(normalize(root_type), -1);
+    if (root_ < 0)
+    {
+        if (error) *error = QString("%1 not in the definition").arg(root_type);
+        types_.clear();
+        return false;
+    }
+    return true;
+}
+
+QString rom_dynamics::ui::qt::RomMessageSchema::normalize(const QString &type)
+{
+    QString out = type.section('[', 0, 0).trimmed();
+    out.replace("/msg/", "/");
+    return out;
+}
+
+rom_dynamics::ui::qt::RomMessageSchema::Kind rom_dynamics::ui::qt::RomMessageSchema::primitiveKind(const QString &type)
+{
+    const QString base = normalize(type);
+    if (base == "bool" || base == "boolean") return Bool;
+    if (base == "float32" || base == "float64" || base == "float" || base == "double") return Float;
+    if (base.startsWith("int") || base.startsWith("uint") || base == "byte" || base == "char" || base == "octet") return Integer;
+    if (base.startsWith("string") || base.startsWith("wstring")) return String;
+    return Dynamic;
+}
+
+//================================================================================
+// 2. RomMessageModel
+//================================================================================
+
+rom_dynamics::ui::qt::RomMessageModel::RomMessageModel(QObject *parent)
+    : QAbstractItemModel(parent)
+{
+    setSchema(RomMessageSchema());
+}
+
+void rom_dynamics::ui::qt::RomMessageModel::setSchema(const RomMessageSchema &schema)
+{
+    beginResetModel();
+    schema_ = schema;
+    msg_ = QJsonObject();
+    nodes_.clear();
+
+    Node root;
+    root.kind = schema_.isEmpty() ? RomMessageSchema::Dynamic : RomMessageSchema::Message;
+    root.type = schema_.root();
+    root.expanded = true;
+    nodes_.append(root);
+    endResetModel();
+}
+
+void rom_dynamics::ui::qt::RomMessageModel::setMessage(const QJsonObject &msg)
+{
+    msg_ = msg;
+
+    QVector<int> changed;
+    update(0, msg_, changed);
+    for (int node : std::as_const(changed))
+    {
+        if (node == 0) continue;
+        const QModelIndex index = indexOf(node, Value);
+        emit dataChanged(index, index, { Qt::DisplayRole });
+    }
+}
+
+void rom_dynamics::ui::qt::RomMessageModel::setExpanded(const QModelIndex &index, bool expanded)
+{
+    const int node = nodeOf(index);
+    nodes_[node].expanded = expanded;
+    if (!expanded) return;
+
+    // rows of a collapsed node were not kept up to date
+    QVector<int> changed;
+    update(node, valueOf(node), changed);
+    for (int n : std::as_const(changed))
+    {
+        if (n == 0) continue;
+        const QModelIndex changed_index = indexOf(n, Value);
+        emit dataChanged(changed_index, changed_index, { Qt::DisplayRole });
+    }
+}
+
+QModelIndex rom_dynamics::ui::qt::RomMessageModel::index(int row, int column, const QModelIndex &parent) const
+{
+    const int node = nodeOf(parent);
+    if (row < 0 || row >= nodes_[node].shown || column < 0 || column >= COLUMN_COUNT) return QModelIndex();
+    return createIndex(row, column, quintptr(nodes_[node].children[row]));
+}
+
+QModelIndex rom_dynamics::ui::qt::RomMessageModel::parent(const QModelIndex &child) const
+{
+    const int node = nodeOf(child);
+    if (node == 0) return QModelIndex();
+    return indexOf(nodes_[node].parent);
+}
+
+int rom_dynamics::ui::qt::RomMessageModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0) return 0;
+    return nodes_[nodeOf(parent)].shown;
+}
+
+int rom_dynamics::ui::qt::RomMessageModel::columnCount(const QModelIndex &) const
+{
+    return COLUMN_COUNT;
+}
+
+bool rom_dynamics::ui::qt::RomMessageModel::hasChildren(const QModelIndex &parent) const
+{
+    if (parent.column() > 0) return false;
+    const Node &node = nodes_[nodeOf(parent)];
+    return node.shown > 0 || mayHaveChildren(node);
+}
+
+bool rom_dynamics::ui::qt::RomMessageModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.column() > 0) return false;
+    const Node &node = nodes_[nodeOf(parent)];
+    return !node.fetched && mayHaveChildren(node);
+}
+
+void rom_dynamics::ui::qt::RomMessageModel::fetchMore(const QModelIndex &parent)
+{
+    const int node = nodeOf(parent);
+    if (nodes_[node].fetched) return;
+
+    const QJsonValue value = valueOf(node);
+    materialize(node, value, nodes_[node].array ? qMin(nodes_[node].length, int(ARRAY_ROWS)) : 0);
+}
+
+QVariant rom_dynamics::ui::qt::RomMessageModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+    const Node &node = nodes_[nodeOf(index)];
+
+    if (role == Qt::DisplayRole)
+    {
+        switch (index.column())
+        {
+            case Name:      return node.key.isEmpty() ? QString("[%1]").arg(node.index) : node.key;
+            case Value:     return node.text;
+            case TypeName:  return node.type_name;
+        }
+    }
+    else if (role == Qt::ForegroundRole && index.column() == TypeName)
+    {
+        return QColor("#8a8f99");
+    }
+    return QVariant();
+}
+
+QVariant rom_dynamics::ui::qt::RomMessageModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section)
+    {
+        case Name:      return QString("field");
+        case Value:     return QString("value");
+        case TypeName:  return QString("type");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags rom_dynamics::ui::qt::RomMessageModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    Qt::ItemFlags flags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+
+    const Node &node = nodes_[nodeOf(index)];
+    bool numeric = !node.array && (node.kind == RomMessageSchema::Bool || node.kind == RomMessageSchema::Integer
+                                   || node.kind == RomMessageSchema::Float);
+    if (!numeric && node.kind == RomMessageSchema::Dynamic && !node.array) node.text.toDouble(&numeric);
+    if (numeric) flags |= Qt::ItemIsDragEnabled;
+    return flags;
+}
+
+QStringList rom_dynamics::ui::qt::RomMessageModel::mimeTypes() const
+{
+    return { ROM_FIELD_MIME, "text/plain" };
+}
+
+QMimeData *rom_dynamics::ui::qt::RomMessageModel::mimeData(const QModelIndexList &indexes) const
+{
+    if (indexes.isEmpty() || topic_.isEmpty()) return nullptr;
+
+    const QString path = pathOf(indexes.first());
+    QMimeData *mime = new QMimeData();
+    mime->setData(ROM_FIELD_MIME, QString("%1\n%2\n%3").arg(topic_, type_, path).toUtf8());
+    mime->setText(topic_ + "." + path);
+    return mime;
+}
+
+QString rom_dynamics::ui::qt::RomMessageModel::pathOf(const QModelIndex &index) const
+{
+    QString path;
+    for (int n = nodeOf(index); n > 0; n = nodes_[n].parent)
+    {
+        const Node &node = nodes_[n];
+        const QString step = node.key.isEmpty() ? QString("[%1]").arg(node.index) : node.key;
+        // transforms[0].transform.x : a key always follows after a '.'
+        path.prepend(path.isEmpty() || path.startsWith('[') ? step : step + ".");
+    }
+    return path;
+}
+
+QModelIndex rom_dynamics::ui::qt::RomMessageModel::indexOf(int node, int column) const
+{
+    if (node <= 0) return QModelIndex();
+    return createIndex(nodes_[node].row, column, quintptr(node));
+}
+
+QJsonValue rom_dynamics::ui::qt::RomMessageModel::valueOf(int node) const
+{
+    QVector<int> path;
+    for (int n = node; n > 0; n = nodes_[n].parent) path.prepend(n);
+
+    QJsonValue value = msg_;
+    for (int n : std::as_const(path))
+    {
+        const Node &step = nodes_[n];
+        value = step.key.isEmpty() ? value.toArray().at(step.index) : value.toObject().value(step.key);
+    }
+    return value;
+}
+
+bool rom_dynamics::ui::qt::RomMessageModel::mayHaveChildren(const Node &node) const
+{
+    if (node.kind == RomMessageSchema::Bytes) return false;
+    if (node.array || node.kind == RomMessageSchema::Dynamic) return node.length > 0;
+    if (node.kind == RomMessageSchema::Message || node.kind == RomMessageSchema::Stamp)
+    {
+        return node.type >= 0 && !schema_.type(node.type).fields.isEmpty();
+    }
+    return false;
+}
+
+int rom_dynamics::ui::qt::RomMessageModel::appendChild(int parent, const Node &child)
+{
+    const int id = nodes_.size();
+    nodes_.append(child);
+    nodes_[id].parent = parent;
+    nodes_[id].row = nodes_[parent].children.size();
+    nodes_[parent].children.append(id);
+    return id;
+}
+
+void rom_dynamics::ui::qt::RomMessageModel::materialize(int node, const QJsonValue &value, int count)
+{
+    nodes_[node].fetched = true;
+
+    // array elements up to count that do not exist yet, fields / keys all at once
+    QVector<Node> children;
+    const Node &parent = nodes_[node];
+    if (parent.array)
+    {
+        for (int i = parent.children.size(); i < count; ++i)
+        {
+            Node child;
+            child.index = i;
+            child.kind = parent.kind;
+            child.type = parent.type;
+            child.type_name = parent.type_name.section('[', 0, 0);
+            children.append(child);
+        }
+    }
+    else if ((parent.kind == RomMessageSchema::Message || parent.kind == RomMessageSchema::Stamp) && parent.type >= 0)
+    {
+        for (const RomMessageSchema::Field &field : schema_.type(parent.type).fields)
+        {
+            Node child;
+            child.key = field.name;
+            child.kind = field.kind;
+            child.type = field.type_index;
+            child.array = field.array_len != -1 && field.kind != RomMessageSchema::Bytes;
+            child.type_name = field.type;
+            if (field.array_len > 0) child.type_name += QString("[%1]").arg(field.array_len);
+            else if (field.array_len == 0) child.type_name += "[]";
+            children.append(child);
+        }
+    }
+    else if (parent.kind == RomMessageSchema::Dynamic && value.isObject())
+    {
+        const QStringList keys = value.toObject().keys();
+        for (const QString &key : keys)
+        {
+            Node child;
+            child.key = key;
+            children.append(child);
+        }
+    }
+
+    // arrays : rows [ shown, count ), some may exist from a longer message
+    const int first = nodes_[node].shown;
+    const int last = nodes_[node].array ? count - 1 : first + int(children.size()) - 1;
+    if (last >= first)
+    {
+        beginInsertRows(indexOf(node), first, last);
+        for (const Node &child : std::as_const(children)) appendChild(node, child);
+        nodes_[node].shown = last + 1;
+        endInsertRows();
+    }
+
+    // text of the new rows, not signalled : the view asks for it
+    QVector<int> unused;
+    const QJsonArray array = value.toArray();
+    const QJsonObject object = value.toObject();
+    for (int i = first; i < nodes_[node].shown; ++i)
+    {
+        const int child = nodes_[node].children[i];
+        const QJsonValue child_value = nodes_[child].key.isEmpty() ? array.at(nodes_[child].index) : object.value(nodes_[child].key);
+        update(child, child_value, unused);
+    }
+}
+
+void rom_dynamics::ui::qt::RomMessageModel::update(int node, const QJsonValue &value, QVector<int> &changed)
+{
+    {
+        Node &n = nodes_[node];
+        if (n.kind == RomMessageSchema::Dynamic) n.array = value.isArray();
+        n.length = containerLength(n, value);
+
+        const QString text = render(n, value);
+        if (text != n.text)
+        {
+            n.text = text;
+            changed.append(node);
+        }
+        if (!n.expanded) return;
+    }
+
+    if (!nodes_[node].fetched)
+    {
+        if (mayHaveChildren(nodes_[node])) materialize(node, value, qMin(nodes_[node].length, int(ARRAY_ROWS)));
+        return;
+    }
+
+    // expanded array : follow the length of this message
+    if (nodes_[node].array)
+    {
+        const int target = qMin(nodes_[node].length, int(ARRAY_ROWS));
+        const int shown = nodes_[node].shown;
+        if (target > shown) materialize(node, value, target);
+        else if (target < shown)
+        {
+            beginRemoveRows(indexOf(node), target, shown - 1);
+            nodes_[node].shown = target;
+            endRemoveRows();
+        }
+    }
+
+    const QJsonArray array = value.toArray();
+    const QJsonObject object = value.toObject();
+    for (int i = 0; i < nodes_[node].shown; ++i)
+    {
+        const int child = nodes_[node].children[i];
+        const QJsonValue child_value = nodes_[child].key.isEmpty() ? array.at(nodes_[child].index) : object.value(nodes_[child].key);
+        update(child, child_value, changed);
+    }
+}
+
+int rom_dynamics::ui::qt::RomMessageModel::containerLength(const Node &node, const QJsonValue &value) const
+{
+    if (node.kind == RomMessageSchema::Bytes) return 0;
+    if (value.isArray()) return value.toArray().size();
+    if (node.kind == RomMessageSchema::Dynamic && value.isObject()) return value.toObject().size();
+    return 0;
+}
+
+QString rom_dynamics::ui::qt::RomMessageModel::render(const Node &node, const QJsonValue &value) const
+{
+    if (value.isUndefined() || value.isNull()) return QString();
+
+    auto scalar = [](RomMessageSchema::Kind kind, const QJsonValue &v) -> QString {
+        if (v.isBool()) return v.toBool() ? "true" : "false";
+        if (v.isString())
+        {
+            const QString s = v.toString();
+            return "\"" + (s.size() > 80 ? s.left(77) + "..." : s) + "\"";
+        }
+        if (v.isDouble())
+        {
+            const double d = v.toDouble();
+            if (kind == RomMessageSchema::Integer || (kind == RomMessageSchema::Dynamic && d == std::floor(d) && std::fabs(d) < 1e15))
+            {
+                return QString::number(qint64(d));
+            }
+            return QString::number(d, 'g', 7);
+        }
+        return QString();
+    };
+
+    switch (node.kind)
+    {
+        case RomMessageSchema::Bytes:
+            if (value.isString())
+            {
+                const QString b64 = value.toString();
+                const int padding = b64.endsWith("==") ? 2 : b64.endsWith('=') ? 1 : 0;
+                return QString("%1 bytes").arg(b64.size() / 4 * 3 - padding);
+            }
+            return QString("%1 bytes").arg(value.toArray().size());
+
+        case RomMessageSchema::Stamp:
+            if (node.array) break;
+            {
+                const QJsonObject stamp = value.toObject();
+                return QString("%1.%2").arg(qint64(stamp.value("sec").toDouble()))
+                                       .arg(qint64(stamp.value("nanosec").toDouble()), 9, 10, QChar('0'));
+            }
+
+        case RomMessageSchema::Message:
+            if (node.array) break;
+            return QString();
+
+        default:
+            break;
+    }
+
+    if (value.isArray())
+    {
+        const QJsonArray array = value.toArray();
+        const bool primitive = node.kind != RomMessageSchema::Message && node.kind != RomMessageSchema::Stamp;
+        if (!primitive || array.size() > INLINE_ARRAY) return QString("[%1]").arg(array.size());
+
+        QStringList items;
+        for (const QJsonValue &item : array)
+        {
+            if (item.isArray() || item.isObject()) return QString("[%1]").arg(array.size());
+            items.append(scalar(node.kind, item));
+        }
+        return "[" + items.join(", ") + "]";
+    }
+    if (value.isObject()) return QString();
+    return scalar(node.kind, value);
+}
+
+//================================================================================
+// 3. RomMessageInspector
+//================================================================================
+
+rom_dynamics::ui::qt::RomMessageInspector::RomMessageInspector(QWidget *parent)
+    : QWidget(parent)
+{
+    title_ = new QLabel("double click a topic to inspect its messages", this);
+    title_->setStyleSheet("color: #bdb7b7; font-size: 10px;");
+
+    model_ = new RomMessageModel(this);
+
+    view_ = new QTreeView(this);
+    view_->setModel(model_);
+    view_->setUniformRowHeights(true);
+    view_->setSelectionMode(QAbstractItemView::SingleSelection);
+    view_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view_->setDragEnabled(true);
+    view_->setDragDropMode(QAbstractItemView::DragOnly);
+    view_->header()->setStretchLastSection(true);
+    view_->setColumnWidth(RomMessageModel::Name, 220);
+    view_->setColumnWidth(RomMessageModel::Value, 300);
+    view_->setStyleSheet("QTreeView { color: #c3c9d4; font: 10px; border: 1px solid #444; }"
+                         "QHeaderView::section { color: #bdb7b7; background: #2e2e2e; border: 0px; font: 10px; }");
+    connect(view_, &QTreeView::expanded, this, [this](const QModelIndex &index) { model_->setExpanded(index, true); });
+    connect(view_, &QTreeView::collapsed, this, [this](const QModelIndex &index) { model_->setExpanded(index, false); });
+
+    status_ = new QLabel(this);
+    status_->setStyleSheet("color: #03fc84; font: 10px;");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 0, 8, 8);
+    layout->addWidget(title_);
+    layout->addWidget(view_, 1);
+    layout->addWidget(status_);
+    setLayout(layout);
+
+    sinceParse_.start();
+    frameTimer_.setInterval(REFRESH_MS);
+    connect(&frameTimer_, &QTimer::timeout, this, &RomMessageInspector::onFrameTimer);
+    frameTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomMessageInspector::setServiceCaller(rom_dynamics::communication::ServiceCaller *caller)
+{
+    caller_ = caller;
+}
+
+void rom_dynamics::ui::qt::RomMessageInspector::inspect(const QString &topic, const QString &type)
+{
+    if (topic == topic_ && type == type_) return;
+
+    topic_ = topic;
+    type_ = type;
+    schemaReady_ = false;
+    hasPending_ = false;
+    pendingFrame_.clear();
+    pendingMsg_ = QJsonObject();
+    received_ = 0;
+    shown_ = 0;
+    parseMs_ = 0.0;
+    const int generation = ++generation_;
+
+    title_->setText(QString("%1  ( %2 )  -  drag a numeric field onto a plot").arg(topic, type));
+    model_->setSchema(RomMessageSchema());
+    model_->setTopic(topic, type);
+
+    const QString key = RomMessageSchema::normalize(type);
+    auto cached = schemas_.constFind(key);
+    if (cached != schemas_.constEnd())
+    {
+        applySchema(*cached, "definition cached");
+        return;
+    }
+    if (!caller_)
+    {
+        applySchema(RomMessageSchema(), "not connected, JSON shape");
+        return;
+    }
+    status_->setText(QString("/rosapi/message_details %1 ...").arg(type));
+
+    QJsonObject args;
+    args["type"] = type;
+    QPointer<RomMessageInspector> self(this);
+    caller_->call("/rosapi/message_details", args, [self, generation, key, type](const ServiceResult &result) {
+        if (!self || generation != self->generation_) return;
+
+        RomMessageSchema schema;
+        QString error = result.error;
+        if (result.ok && schema.load(type, result.values, &error))
+        {
+            self->schemas_.insert(key, schema);
+            self->applySchema(schema, QString("definition %1 ms").arg(result.rtt_ms));
+        }
+        else
+        {
+            self->applySchema(RomMessageSchema(), QString("no definition ( %1 ), JSON shape").arg(error));
+        }
+    });
+}
+
+void rom_dynamics::ui::qt::RomMessageInspector::setFrame(const QByteArray &frame)
+{
+    pendingFrame_ = frame;
+    pendingMsg_ = QJsonObject();
+    hasPending_ = true;
+    ++received_;
+}
+
+void rom_dynamics::ui::qt::RomMessageInspector::setMessage(const QJsonObject &msg)
+{
+    pendingFrame_.clear();
+    pendingMsg_ = msg;
+    hasPending_ = true;
+    ++received_;
+}
+
+void rom_dynamics::ui::qt::RomMessageInspector::applySchema(const RomMessageSchema &schema, const QString &note)
+{
+    model_->setSchema(schema);
+    schemaReady_ = true;
+    schemaNote_ = note;
+    status_->setText(note);
+}
+
+void rom_dynamics::ui::qt::RomMessageInspector::onFrameTimer()
+{
+    if (!hasPending_ || !schemaReady_) return;
+    if (sinceParse_.elapsed() < qMax(double(REFRESH_MS), PARSE_BUDGET * parseMs_)) return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QJsonObject msg = pendingMsg_;
+    if (!pendingFrame_.isEmpty())
+    {
+        QJsonParseError err{};
+        const QJsonDocument doc = QJsonDocument::fromJson(pendingFrame_, &err);
+        if (err.error == QJsonParseError::NoError) msg = doc.object().value("msg").toObject();
+    }
+    hasPending_ = false;
+    pendingFrame_.clear();
+    pendingMsg_ = QJsonObject();
+
+    model_->setMessage(msg);
+
+    parseMs_ = timer.nsecsElapsed() / 1e6;
+    sinceParse_.restart();
+    ++shown_;
+
+    status_->setText(QString("%1 received, %2 shown  |  decode + update %3 ms  |  %4 rows  |  %5")
+                     .arg(received_).arg(shown_).arg(parseMs_, 0, 'f', 2)
+                     .arg(model_->nodeCount()).arg(schemaNote_));
+}
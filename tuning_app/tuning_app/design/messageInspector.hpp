@@ -0,0 +1,197 @@
+#ifndef ROM_MESSAGE_INSPECTOR_HPP
+#define ROM_MESSAGE_INSPECTOR_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QAbstractItemModel>
+#include <QTreeView>
+#include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QPointer>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include "../communication/service_caller.hpp"
+#include "fieldPlot.hpp"
+
+namespace rom_dynamics::ui::qt {
+
+//================================================================================
+// 1. message definition ( /rosapi/message_details ), compiled once per type
+//================================================================================
+// Field types are resolved to a Kind and, for nested messages, to the index of
+// their Type, so rendering a value never looks at a type string again.
+class RomMessageSchema {
+public:
+    enum Kind { Bool, Integer, Float, String, Bytes, Stamp, Message, Dynamic };
+
+    struct Field {
+        QString name;
+        QString type;           // as rosapi reports it, for the type column
+        Kind kind = Dynamic;
+        int array_len = -1;     // -1 : not an array, 0 : unbounded, n : fixed
+        int type_index = -1;    // Message / Stamp : index into types()
+    };
+
+    struct Type {
+        QString name;
+        QVector<Field> fields;
+    };
+
+    // values of the message_details response; false when the root type is missing
+    bool load(const QString &root_type, const QJsonObject &values, QString *error = nullptr);
+
+    bool isEmpty() const { return types_.isEmpty(); }
+    int root() const { return root_; }
+    const Type &type(int index) const { return types_[index]; }
+
+    // "nav_msgs/msg/Odometry" and "nav_msgs/Odometry" are the same type
+    static QString normalize(const QString &type);
+    static Kind primitiveKind(const QString &type);
+
+private:
+    QVector<Type> types_;
+    int root_ = -1;
+};
+
+//================================================================================
+// 2. tree model over the latest message
+//================================================================================
+// Rows exist only for nodes whose parent was expanded ( fetchMore ). A new message
+// walks the materialized rows of expanded nodes only, re-renders their value text
+// and signals the rows whose text changed; the rest of the message is never
+// touched. Arrays expose at most ARRAY_ROWS elements, uint8[] ( base64 on rosbridge )
+// stays a leaf.
+class RomMessageModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    static constexpr int ARRAY_ROWS = 100;
+    static constexpr int INLINE_ARRAY = 6;      // short primitive arrays are shown inline
+
+    enum Column { Name, Value, TypeName, COLUMN_COUNT };
+
+    explicit RomMessageModel(QObject *parent = nullptr);
+
+    // schema may be empty : the tree then follows the JSON shape of the message
+    void setSchema(const RomMessageSchema &schema);
+    void setMessage(const QJsonObject &msg);
+    void setExpanded(const QModelIndex &index, bool expanded);
+
+    // numeric leaves can be dragged as "topic\ntype\npath" ( ROM_FIELD_MIME )
+    void setTopic(const QString &topic, const QString &type) { topic_ = topic; type_ = type; }
+    QString pathOf(const QModelIndex &index) const;
+
+    int nodeCount() const { return nodes_.size() - 1; }
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QStringList mimeTypes() const override;
+    QMimeData *mimeData(const QModelIndexList &indexes) const override;
+
+private:
+    struct Node {
+        int parent = -1;
+        int row = 0;
+        QString key;                // field name / object key, empty for array elements
+        int index = -1;             // array element index
+        RomMessageSchema::Kind kind = RomMessageSchema::Dynamic;
+        int type = -1;              // schema type of a Message / Stamp
+        bool array = false;         // children are the elements
+        QString type_name;
+        bool fetched = false;
+        bool expanded = false;
+        int length = 0;             // children available in the last message
+        int shown = 0;              // rows given to the view
+        QVector<int> children;
+        QString text;
+    };
+
+    int nodeOf(const QModelIndex &index) const { return index.isValid() ? int(index.internalId()) : 0; }
+    QModelIndex indexOf(int node, int column = 0) const;
+    QJsonValue valueOf(int node) const;
+    bool mayHaveChildren(const Node &node) const;
+    int appendChild(int parent, const Node &child);
+    void materialize(int node, const QJsonValue &value, int count);
+    void update(int node, const QJsonValue &value, QVector<int> &changed);
+    QString render(const Node &node, const QJsonValue &value) const;
+    int containerLength(const Node &node, const QJsonValue &value) const;
+
+    RomMessageSchema schema_;
+    QString topic_;
+    QString type_;
+    QJsonObject msg_;
+    QVector<Node> nodes_;           // [0] is the invisible root
+};
+
+//================================================================================
+// 3. topic tab inspector
+//================================================================================
+// Frames are only kept; the newest one is decoded on the frame timer, and never
+// more often than every PARSE_BUDGET times its own decode time, so a PointCloud2
+// at 30 Hz does not turn into 30 JSON decodes per second on the GUI thread.
+class RomMessageInspector : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int REFRESH_MS = 33;
+    static constexpr int PARSE_BUDGET = 4;
+
+    explicit RomMessageInspector(QWidget *parent = nullptr);
+    ~RomMessageInspector() override = default;
+
+    void setServiceCaller(rom_dynamics::communication::ServiceCaller *caller);
+
+    // topic as in /rosapi/topics ( absolute )
+    void inspect(const QString &topic, const QString &type);
+    const QString &topic() const { return topic_; }
+
+    // live raw rosbridge frame / decoded message ( replay, non raw topics )
+    void setFrame(const QByteArray &frame);
+    void setMessage(const QJsonObject &msg);
+
+private:
+    void onFrameTimer();
+    void applySchema(const RomMessageSchema &schema, const QString &note);
+
+    QPointer<rom_dynamics::communication::ServiceCaller> caller_;
+    QHash<QString, RomMessageSchema> schemas_;     // normalized type -> definition
+
+    QString topic_;
+    QString type_;
+    bool schemaReady_ = false;
+    int generation_ = 0;
+
+    RomMessageModel *model_;
+    QTreeView *view_;
+    QLabel *title_;
+    QLabel *status_;
+    QString schemaNote_;
+
+    QByteArray pendingFrame_;
+    QJsonObject pendingMsg_;
+    bool hasPending_ = false;
+    QTimer frameTimer_;
+    QElapsedTimer sinceParse_;
+    double parseMs_ = 0.0;
+    quint64 received_ = 0;
+    quint64 shown_ = 0;
+};
+
+}
+
+#endif // ROM_MESSAGE_INSPECTOR_HPP
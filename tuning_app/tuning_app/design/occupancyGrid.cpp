@@ -0,0 +1,350 @@
+#include "occupancyGrid.hpp"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+using namespace rom_dynamics::ui::qt;
+
+//================================================================================
+// 1. OccupancyGridDecoder ( worker thread )
+//================================================================================
+
+rom_dynamics::ui::qt::OccupancyGridDecoder::OccupancyGridDecoder(QObject *parent)
+    : QObject(parent)
+    , palette_(OccupancyGridSource::mapPalette())
+{
+}
+
+void rom_dynamics::ui::qt::OccupancyGridDecoder::enqueue(const Job &job)
+{
+    QMutexLocker lock(&mutex_);
+
+    // a full grid replaces everything before it, a slow decode never builds a backlog
+    if (!job.update) jobs_.clear();
+    jobs_.append(job);
+
+    if (!scheduled_)
+    {
+        scheduled_ = true;
+        QMetaObject::invokeMethod(this, &OccupancyGridDecoder::process, Qt::QueuedConnection);
+    }
+}
+
+void rom_dynamics::ui::qt::OccupancyGridDecoder::setPalette(const QVector<QRgb> &palette)
+{
+    if (palette.size() != 256) return;
+    QMutexLocker lock(&mutex_);
+    palette_ = palette;
+}
+
+void rom_dynamics::ui::qt::OccupancyGridDecoder::process()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            QMutexLocker lock(&mutex_);
+            if (jobs_.isEmpty())
+            {
+                scheduled_ = false;
+                return;
+            }
+            job = jobs_.takeFirst();
+        }
+        apply(job);
+    }
+}
+
+void rom_dynamics::ui::qt::OccupancyGridDecoder::apply(const Job &job)
+{
+    QElapsedTimer clock;
+    clock.start();
+
+    QJsonObject msg = job.msg;
+    QByteArray cells;
+    const bool ok = job.frame.isEmpty() ? parseMessage(msg, cells) : parseFrame(job.frame, msg, cells);
+    if (!ok)
+    {
+        qWarning() << "occupancy grid : could not parse message";
+        return;
+    }
+    const double parse_ms = clock.nsecsElapsed() / 1e6;
+    clock.restart();
+
+    QList<int> dirty;
+    if (!job.update)
+    {
+        const QJsonObject info = msg.value("info").toObject();
+        const QJsonObject origin = info.value("origin").toObject().value("position").toObject();
+
+        RomGridInfo grid;
+        grid.resolution = info.value("resolution").toDouble();
+        grid.width = info.value("width").toInt();
+        grid.height = info.value("height").toInt();
+        grid.origin_x = origin.value("x").toDouble();
+        grid.origin_y = origin.value("y").toDouble();
+        applyGrid(grid, cells, dirty);
+    }
+    else
+    {
+        applyUpdate(msg.value("x").toInt(), msg.value("y").toInt(),
+                    msg.value("width").toInt(), msg.value("height").toInt(), cells, dirty);
+    }
+
+    QVector<QRgb> palette;
+    {
+        QMutexLocker lock(&mutex_);
+        palette = palette_;
+    }
+
+    QList<RomGridTile> tiles;
+    tiles.reserve(dirty.size());
+    for (int tile : std::as_const(dirty)) tiles.append(renderTile(tile, palette));
+    const double tile_ms = clock.nsecsElapsed() / 1e6;
+
+    if (!tiles.isEmpty()) emit tilesReady(tiles);
+    emit decoded(tiles.size(), parse_ms, tile_ms);
+}
+
+void rom_dynamics::ui::qt::OccupancyGridDecoder::applyGrid(const RomGridInfo &info, const QByteArray &cells, QList<int> &dirty)
+{
+    if (!info.isValid() || cells.size() != qsizetype(info.width) * info.height)
+    {
+        qWarning() << "occupancy grid : data size" << cells.size() << "does not match" << info.width << "x" << info.height;
+        return;
+    }
+
+    const bool reset = info != info_ || cells_.isEmpty();
+    if (reset)
+    {
+        info_ = info;
+        cells_ = cells;
+        emit gridReset(info_);
+        for (int t = 0; t < tilesX() * tilesY(); ++t) dirty.append(t);
+        return;
+    }
+
+    // same layout : only tiles with at least one changed cell
+    const int tiles_x = tilesX();
+    for (int ty = 0; ty < tilesY(); ++ty)
+    {
+        const int row0 = ty * TILE;
+        const int rows = qMin(TILE, info_.height - row0);
+        for (int tx = 0; tx < tiles_x; ++tx)
+        {
+            const int col0 = tx * TILE;
+            const int cols = qMin(TILE, info_.width - col0);
+            for (int r = row0; r < row0 + rows; ++r)
+            {
+                const qsizetype offset = qsizetype(r) * info_.width + col0;
+                if (std::memcmp(cells_.constData() + offset, cells.constData() + offset, cols) != 0)
+                {
+                    dirty.append(ty * tiles_x + tx);
+                    break;
+                }
+            }
+        }
+    }
+    cells_ = cells;
+}
+
+void rom_dynamics::ui::qt::OccupancyGridDecoder::applyUpdate(int x, int y, int w, int h, const QByteArray &cells, QList<int> &dirty)
+{
+    if (!info_.isValid() || w <= 0 || h <= 0 || cells.size() != qsizetype(w) * h) return;
+
+    // clip to the grid
+    const int x0 = qMax(0, x), y0 = qMax(0, y);
+    const int x1 = qMin(info_.width, x + w), y1 = qMin(info_.height, y + h);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    char *dst = cells_.data();
+    for (int r = y0; r < y1; ++r)
+    {
+        std::memcpy(dst + qsizetype(r) * info_.width + x0, cells.constData() + qsizetype(r - y) * w + (x0 - x), x1 - x0);
+    }
+
+    const int tiles_x = tilesX();
+    for (int ty = y0 / TILE; ty <= (y1 - 1) / TILE; ++ty)
+    {
+        for (int tx = x0 / TILE; tx <= (x1 - 1) / TILE; ++tx) dirty.append(ty * tiles_x + tx);
+    }
+}
+
+RomGridTile rom_dynamics::ui::qt::OccupancyGridDecoder::renderTile(int tile_index, const QVector<QRgb> &palette) const
+{
+    RomGridTile tile;
+    tile.col0 = (tile_index % tilesX()) * TILE;
+    tile.row0 = (tile_index / tilesX()) * TILE;
+    tile.cols = qMin(TILE, info_.width - tile.col0);
+    tile.rows = qMin(TILE, info_.height - tile.row0);
+    tile.image = QImage(tile.cols, tile.rows, QImage::Format_ARGB32_Premultiplied);
+
+    const uchar *cells = reinterpret_cast<const uchar*>(cells_.constData());
+    const QRgb *lut = palette.constData();
+    for (int r = 0; r < tile.rows; ++r)
+    {
+        // grid rows grow upwards, image rows downwards
+        const uchar *src = cells + qsizetype(tile.row0 + tile.rows - 1 - r) * info_.width + tile.col0;
+        QRgb *dst = reinterpret_cast<QRgb*>(tile.image.scanLine(r));
+        // 4 independent loads per step, the gather is what bounds this loop
+        int c = 0;
+        for (; c + 4 <= tile.cols; c += 4)
+        {
+            const QRgb p0 = lut[src[c]], p1 = lut[src[c + 1]], p2 = lut[src[c + 2]], p3 = lut[src[c + 3]];
+            dst[c] = p0; dst[c + 1] = p1; dst[c + 2] = p2; dst[c + 3] = p3;
+        }
+        for (; c < tile.cols; ++c) dst[c] = lut[src[c]];
+    }
+    return tile;
+}
+
+bool rom_dynamics::ui::qt::OccupancyGridDecoder::parseFrame(const QByteArray &frame, QJsonObject &msg, QByteArray &cells)
+{
+    // "data" : [ ... ] is parsed by hand, the rest ( header, info, x / y ... ) by QJsonDocument
+    const char *begin = frame.constData();
+    const char *end = begin + frame.size();
+
+    qsizetype key = frame.indexOf("\"data\"");
+    const char *p = nullptr;
+    while (key >= 0)
+    {
+        p = begin + key + 6;
+        while (p < end && (*p == ' ' || *p == ':')) ++p;
+        if (p < end && *p == '[') break;
+        key = frame.indexOf("\"data\"", key + 6);
+    }
+    if (key < 0) return false;
+
+    const char *open = p++;
+    cells.resize(qMax<qsizetype>(16, (end - p) / 2));
+    char *out = cells.data();
+    qsizetype n = 0;
+
+    while (p < end && *p != ']')
+    {
+        if (*p != '-' && (*p < '0' || *p > '9')) { ++p; continue; }   // separators, whitespace
+
+        const bool negative = *p == '-';
+        if (negative) ++p;
+        int value = 0;
+        while (p < end && *p >= '0' && *p <= '9') value = value * 10 + (*p++ - '0');
+
+        if (n == cells.size()) { cells.resize(n * 2); out = cells.data(); }
+        out[n++] = char(negative ? -value : value);
+    }
+    if (p >= end) return false;
+    cells.resize(n);
+
+    QByteArray rest;
+    rest.reserve((open - begin) + 2 + (end - p));
+    rest.append(begin, open - begin + 1);
+    rest.append(p, end - p);
+
+    QJsonParseError err{};
+    const QJsonDocument doc = QJsonDocument::fromJson(rest, &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) return false;
+
+    const QJsonObject root = doc.object();
+    msg = root.contains("msg") ? root.value("msg").toObject() : root;
+    return true;
+}
+
+bool rom_dynamics::ui::qt::OccupancyGridDecoder::parseMessage(const QJsonObject &msg, QByteArray &cells)
+{
+    const QJsonArray data = msg.value("data").toArray();
+    cells.resize(data.size());
+    char *out = cells.data();
+    for (qsizetype i = 0; i < data.size(); ++i) out[i] = char(data.at(i).toInt());
+    return !msg.isEmpty();
+}
+
+//================================================================================
+// 2. OccupancyGridSource ( ui thread )
+//================================================================================
+
+rom_dynamics::ui::qt::OccupancyGridSource::OccupancyGridSource(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<RomGridInfo>();
+    qRegisterMetaType<QList<RomGridTile>>();
+
+    decoder_ = new OccupancyGridDecoder();
+    decoder_->moveToThread(&thread_);
+    thread_.setObjectName("rom grid decode");
+    connect(&thread_, &QThread::finished, decoder_, &QObject::deleteLater);
+
+    // queued : emitted from the worker
+    connect(decoder_, &OccupancyGridDecoder::gridReset, this, &OccupancyGridSource::gridReset);
+    connect(decoder_, &OccupancyGridDecoder::tilesReady, this, &OccupancyGridSource::tilesReady);
+    connect(decoder_, &OccupancyGridDecoder::decoded, this, &OccupancyGridSource::decoded);
+
+    thread_.start();
+}
+
+rom_dynamics::ui::qt::OccupancyGridSource::~OccupancyGridSource()
+{
+    thread_.quit();
+    thread_.wait();
+}
+
+QVector<QRgb> rom_dynamics::ui::qt::OccupancyGridSource::mapPalette()
+{
+    QVector<QRgb> palette(256);
+    for (int v = 0; v < 256; ++v)
+    {
+        const int value = v < 128 ? v : v - 256;     // cells are int8
+        if (value < 0 || value > 100) palette[v] = qRgb(0x50, 0x50, 0x50);   // unknown
+        else
+        {
+            const int g = 0xf0 - value * 0xf0 / 100;     // 0 free -> light, 100 occupied -> black
+            palette[v] = qRgb(g, g, g);
+        }
+    }
+    return palette;
+}
+
+QVector<QRgb> rom_dynamics::ui::qt::OccupancyGridSource::costmapPalette()
+{
+    QVector<QRgb> palette(256);
+    for (int v = 0; v < 256; ++v)
+    {
+        const int value = v < 128 ? v : v - 256;
+        QRgb color;
+        if (value == 0) color = qRgba(0, 0, 0, 0);                              // free
+        else if (value == 100) color = qRgba(0xff, 0x00, 0xff, 0xe0);           // lethal
+        else if (value == 99) color = qRgba(0x00, 0xff, 0xff, 0xc0);            // inscribed
+        else if (value > 0 && value < 99)
+        {
+            const int red = value * 0xff / 98;
+            color = qRgba(red, 0x20, 0xff - red, 0x60 + value);
+        }
+        else color = qRgba(0x70, 0x89, 0x86, 0x30);                             // unknown
+        palette[v] = qPremultiply(color);
+    }
+    return palette;
+}
+
+void rom_dynamics::ui::qt::OccupancyGridSource::setPalette(const QVector<QRgb> &palette)
+{
+    decoder_->setPalette(palette);
+}
+
+void rom_dynamics::ui::qt::OccupancyGridSource::submitFrame(const QByteArray &frame, bool update)
+{
+    OccupancyGridDecoder::Job job;
+    job.update = update;
+    job.frame = frame;
+    decoder_->enqueue(job);
+}
+
+void rom_dynamics::ui::qt::OccupancyGridSource::submitMessage(const QJsonObject &msg, bool update)
+{
+    OccupancyGridDecoder::Job job;
+    job.update = update;
+    job.msg = msg;
+    decoder_->enqueue(job);
+}
@@ -0,0 +1,129 @@
+#ifndef ROM_OCCUPANCY_GRID_HPP
+#define ROM_OCCUPANCY_GRID_HPP
+
+#pragma once
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QImage>
+#include <QList>
+#include <QVector>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QMetaType>
+
+namespace rom_dynamics::ui::qt {
+
+// nav_msgs/MapMetaData, the part that decides the tile layout
+struct RomGridInfo {
+    double resolution = 0.05;   // m / cell
+    double origin_x = 0.0;      // m, cell ( 0, 0 ) corner
+    double origin_y = 0.0;
+    int width = 0;              // cells
+    int height = 0;
+
+    bool isValid() const { return width > 0 && height > 0 && resolution > 0.0; }
+    bool operator==(const RomGridInfo &o) const
+    {
+        return resolution == o.resolution && origin_x == o.origin_x && origin_y == o.origin_y
+               && width == o.width && height == o.height;
+    }
+    bool operator!=(const RomGridInfo &o) const { return !(*this == o); }
+};
+
+// One tile of cells, already colored. image row 0 is the top ( highest grid row ) of the tile.
+struct RomGridTile {
+    int col0 = 0;
+    int row0 = 0;
+    int cols = 0;
+    int rows = 0;
+    QImage image;
+};
+
+// Worker side of OccupancyGridSource: keeps the cells, applies full grids and
+// OccupancyGridUpdate patches, and colors only the tiles whose cells changed.
+class OccupancyGridDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int TILE = 256;    // cells per tile side
+
+    struct Job {
+        bool update = false;    // map_msgs/OccupancyGridUpdate instead of a full grid
+        QByteArray frame;       // raw rosbridge frame, or
+        QJsonObject msg;        // already decoded msg ( replay )
+    };
+
+    explicit OccupancyGridDecoder(QObject *parent = nullptr);
+
+    // any thread. A full grid drops every job still queued in front of it.
+    void enqueue(const Job &job);
+    void setPalette(const QVector<QRgb> &palette);
+
+    // frame -> msg fields without "data" + the data array as int8 cells, no QJsonArray on the way
+    static bool parseFrame(const QByteArray &frame, QJsonObject &msg, QByteArray &cells);
+    static bool parseMessage(const QJsonObject &msg, QByteArray &cells);
+
+signals:
+    void gridReset(const rom_dynamics::ui::qt::RomGridInfo &info);
+    void tilesReady(const QList<rom_dynamics::ui::qt::RomGridTile> &tiles);
+    void decoded(int tiles, double parse_ms, double tile_ms);
+
+private:
+    void process();
+    void apply(const Job &job);
+    void applyGrid(const RomGridInfo &info, const QByteArray &cells, QList<int> &dirty);
+    void applyUpdate(int x, int y, int w, int h, const QByteArray &cells, QList<int> &dirty);
+    RomGridTile renderTile(int tile_index, const QVector<QRgb> &palette) const;
+
+    int tilesX() const { return (info_.width + TILE - 1) / TILE; }
+    int tilesY() const { return (info_.height + TILE - 1) / TILE; }
+
+    QMutex mutex_;
+    QList<Job> jobs_;
+    bool scheduled_ = false;
+    QVector<QRgb> palette_;     // indexed by the cell value as uint8 ( -1 -> 255 )
+
+    // worker thread only
+    RomGridInfo info_;
+    QByteArray cells_;
+};
+
+// One OccupancyGrid topic ( + its updates topic ) decoded on its own thread.
+// Lives on the ui thread; tiles come back through tilesReady.
+class OccupancyGridSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit OccupancyGridSource(QObject *parent = nullptr);
+    ~OccupancyGridSource() override;
+
+    // ros map colors : free light, occupied black, unknown gray
+    static QVector<QRgb> mapPalette();
+    // nav2 costmap colors ( cost scaled to 0..100 ) : free clear, cost blue -> red,
+    // inscribed cyan, lethal magenta, unknown faint; premultiplied so it overlays the map
+    static QVector<QRgb> costmapPalette();
+
+    void setPalette(const QVector<QRgb> &palette);
+
+    void submitFrame(const QByteArray &frame, bool update = false);
+    void submitMessage(const QJsonObject &msg, bool update = false);
+
+signals:
+    void gridReset(const rom_dynamics::ui::qt::RomGridInfo &info);
+    void tilesReady(const QList<rom_dynamics::ui::qt::RomGridTile> &tiles);
+    void decoded(int tiles, double parse_ms, double tile_ms);
+
+private:
+    QThread thread_;
+    OccupancyGridDecoder *decoder_ = nullptr;
+};
+}
+
+Q_DECLARE_METATYPE(rom_dynamics::ui::qt::RomGridInfo)
+Q_DECLARE_METATYPE(rom_dynamics::ui::qt::RomGridTile)
+
+#endif
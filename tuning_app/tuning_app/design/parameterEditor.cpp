@@ -0,0 +1,490 @@
+#include "parameterEditor.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QCheckBox>
+#include <QDoubleSpinBox>
+#include <QSignalBlocker>
+#include <algorithm>
+#include <cmath>
+
+using namespace rom_dynamics::ui::qt;
+using rom_dynamics::communication::ServiceResult;
+
+//================================================================================
+// 1. RomParameterEditor
+//================================================================================
+
+rom_dynamics::ui::qt::RomParameterEditor::RomParameterEditor(QWidget *parent)
+    : QWidget(parent)
+{
+    const QString btnStyle = "QPushButton { color: #c3c9d4; border-radius: 4px; border: 1px solid #c3c9d4; padding: 2px 10px; }"
+                             "QPushButton:hover { color: white; border: 1px solid orange; }";
+    const QString editStyle = "color: #c3c9d4; font: 11px; border: 1px solid #555; border-radius: 3px;";
+
+    nodeCombo_ = new QComboBox(this);
+    nodeCombo_->setEditable(true);
+    nodeCombo_->setMinimumWidth(260);
+    nodeCombo_->setStyleSheet(editStyle);
+
+    loadBtn_ = new QPushButton("Load", this);
+    loadBtn_->setStyleSheet(btnStyle);
+    connect(loadBtn_, &QPushButton::clicked, this, [this]() { loadNode(nodeCombo_->currentText().trimmed()); });
+
+    filterEdit_ = new QLineEdit(this);
+    filterEdit_->setPlaceholderText("filter");
+    filterEdit_->setStyleSheet(editStyle);
+    connect(filterEdit_, &QLineEdit::textChanged, this, &RomParameterEditor::applyFilter);
+
+    QHBoxLayout *top = new QHBoxLayout();
+    top->addWidget(nodeCombo_);
+    top->addWidget(loadBtn_);
+    top->addWidget(filterEdit_, 1);
+
+    rowsWidget_ = new QWidget();
+    rowsLayout_ = new QGridLayout(rowsWidget_);
+    rowsLayout_->setContentsMargins(4, 4, 4, 4);
+    rowsLayout_->setHorizontalSpacing(8);
+    rowsLayout_->setVerticalSpacing(2);
+    rowsLayout_->setAlignment(Qt::AlignTop);
+
+    scroll_ = new QScrollArea(this);
+    scroll_->setWidgetResizable(true);
+    scroll_->setWidget(rowsWidget_);
+    scroll_->setStyleSheet("QScrollArea { border: 1px solid #444; }");
+
+    status_ = new QLabel("select a node and load its parameters", this);
+    status_->setStyleSheet("color: #03fc84; font: 10px;");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->addLayout(top);
+    layout->addWidget(scroll_, 1);
+    layout->addWidget(status_);
+    setLayout(layout);
+
+    batchTimer_.setSingleShot(true);
+    batchTimer_.setInterval(BATCH_MS);
+    connect(&batchTimer_, &QTimer::timeout, this, &RomParameterEditor::flush);
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::setServiceCaller(rom_dynamics::communication::ServiceCaller *caller)
+{
+    caller_ = caller;
+    setInFlight_ = false;   // answers of the previous client never come
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::setNodes(const QStringList &nodes)
+{
+    nodeCombo_->clear();
+    nodeCombo_->addItems(nodes);
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::loadNode(const QString &node)
+{
+    if (node.isEmpty()) return;
+
+    node_ = node;
+    clearRows();
+    pending_.clear();
+    const int generation = ++loadGeneration_;
+
+    if (!caller_)
+    {
+        status_->setText("not connected");
+        return;
+    }
+    status_->setText(QString("loading %1 ...").arg(node));
+
+    QPointer<RomParameterEditor> self(this);
+    QJsonObject list_args;
+    list_args["prefixes"] = QJsonArray();
+    list_args["depth"] = 0;
+    caller_->call(node + "/list_parameters", list_args, [self, generation, node](const ServiceResult &listed) {
+        if (!self || generation != self->loadGeneration_) return;
+        if (!listed.ok || !self->caller_)
+        {
+            self->status_->setText(QString("%1/list_parameters : %2").arg(node, listed.error));
+            return;
+        }
+
+        const QJsonArray names = listed.values.value("result").toObject().value("names").toArray();
+        QJsonObject get_args;
+        get_args["names"] = names;
+        self->caller_->call(node + "/get_parameters", get_args, [self, generation, node, names, listed](const ServiceResult &got) {
+            if (!self || generation != self->loadGeneration_) return;
+            if (!got.ok)
+            {
+                self->status_->setText(QString("%1/get_parameters : %2").arg(node, got.error));
+                return;
+            }
+
+            const QJsonArray values = got.values.value("values").toArray();
+            QList<int> order;
+            for (int i = 0; i < qMin(names.size(), values.size()); ++i) order.append(i);
+            std::sort(order.begin(), order.end(), [&names](int a, int b) { return names[a].toString() < names[b].toString(); });
+            for (int i : std::as_const(order)) self->addRow(names[i].toString(), values[i].toObject());
+
+            self->status_->setText(QString("%1 : %2 parameters  ( list %3 ms, get %4 ms )")
+                                   .arg(node).arg(order.size()).arg(listed.rtt_ms).arg(got.rtt_ms));
+        });
+    });
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::clearRows()
+{
+    for (const Row &row : std::as_const(rows_))
+    {
+        delete row.label;
+        delete row.editor;
+        delete row.slider;
+    }
+    rows_.clear();
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::addRow(const QString &name, const QJsonObject &value)
+{
+    Row row;
+    row.name = name;
+    row.type = value.value("type").toInt();
+    row.accepted = value;
+    row.label = new QLabel(name, rowsWidget_);
+    row.label->setStyleSheet("color: #bdb7b7; font: 11px;");
+
+    const QString editStyle = "color: #c3c9d4; font: 11px;";
+    const int index = rows_.size();
+
+    // slider position <-> value over [lo, hi]
+    auto toSlider = [](double v, double lo, double hi) {
+        return int(std::lround(qBound(0.0, (v - lo) / (hi - lo), 1.0) * SLIDER_STEPS));
+    };
+    auto fromSlider = [](int pos, double lo, double hi) {
+        return lo + (hi - lo) * pos / double(SLIDER_STEPS);
+    };
+
+    switch (row.type)
+    {
+    case Bool:
+    {
+        QCheckBox *box = new QCheckBox(rowsWidget_);
+        box->setChecked(value.value("bool_value").toBool());
+        connect(box, &QCheckBox::toggled, this, [this, name](bool checked) {
+            queueChange(name, makeValue(Bool, checked));
+        });
+        row.editor = box;
+        break;
+    }
+    case Integer:
+    case Double:
+    {
+        const bool is_int = row.type == Integer;
+        const double v = is_int ? double(value.value("integer_value").toInteger()) : value.value("double_value").toDouble();
+        const double span = is_int ? qMax(10.0, std::abs(v)) : (v == 0.0 ? 1.0 : std::abs(v));
+        row.lo = v - span;
+        row.hi = v + span;
+
+        row.slider = new QSlider(Qt::Horizontal, rowsWidget_);
+        row.slider->setRange(0, SLIDER_STEPS);
+        row.slider->setValue(toSlider(v, row.lo, row.hi));
+        row.slider->setMinimumWidth(160);
+
+        if (is_int)
+        {
+            // int64 parameters : a QSpinBox stops at int, a double is exact up to 2^53
+            QDoubleSpinBox *spin = new QDoubleSpinBox(rowsWidget_);
+            spin->setDecimals(0);
+            spin->setRange(-INT64_SPIN_LIMIT, INT64_SPIN_LIMIT);
+            spin->setValue(v);
+            spin->setStyleSheet(editStyle);
+            connect(spin, &QDoubleSpinBox::valueChanged, this, [this, index, toSlider](double x) {
+                const Row &r = rows_.at(index);
+                const QSignalBlocker block(r.slider);
+                r.slider->setValue(toSlider(x, r.lo, r.hi));
+                queueChange(r.name, makeValue(Integer, qint64(std::llround(x))));
+            });
+            connect(row.slider, &QSlider::valueChanged, this, [this, index, spin, fromSlider](int pos) {
+                const Row &r = rows_.at(index);
+                const qint64 x = std::llround(qBound(-INT64_SPIN_LIMIT, fromSlider(pos, r.lo, r.hi), INT64_SPIN_LIMIT));
+                const QSignalBlocker block(spin);
+                spin->setValue(double(x));
+                queueChange(r.name, makeValue(Integer, x));
+            });
+            row.editor = spin;
+        }
+        else
+        {
+            QDoubleSpinBox *spin = new QDoubleSpinBox(rowsWidget_);
+            spin->setDecimals(6);
+            spin->setRange(-1e12, 1e12);
+            spin->setSingleStep(span / 100.0);
+            spin->setValue(v);
+            spin->setStyleSheet(editStyle);
+            connect(spin, &QDoubleSpinBox::valueChanged, this, [this, index, toSlider](double x) {
+                const Row &r = rows_.at(index);
+                const QSignalBlocker block(r.slider);
+                r.slider->setValue(toSlider(x, r.lo, r.hi));
+                queueChange(r.name, makeValue(Double, x));
+            });
+            connect(row.slider, &QSlider::valueChanged, this, [this, index, spin, fromSlider](int pos) {
+                const Row &r = rows_.at(index);
+                const double x = fromSlider(pos, r.lo, r.hi);
+                const QSignalBlocker block(spin);
+                spin->setValue(x);
+                queueChange(r.name, makeValue(Double, x));
+            });
+            row.editor = spin;
+        }
+        break;
+    }
+    case String:
+    case ByteArray:
+    case BoolArray:
+    case IntegerArray:
+    case DoubleArray:
+    case StringArray:
+    {
+        // arrays ( process_noise_covariance ... ) as comma separated text, sent on enter / focus out
+        QLineEdit *edit = new QLineEdit(rowsWidget_);
+        edit->setText(row.type == String ? value.value("string_value").toString() : arrayText(row.type, value));
+        edit->setCursorPosition(0);
+        edit->setStyleSheet(editStyle);
+        const int type = row.type;
+        connect(edit, &QLineEdit::editingFinished, this, [this, index, edit, type]() {
+            if (!edit->isModified()) return;
+            edit->setModified(false);
+            const Row &r = rows_.at(index);
+            if (type == String)
+            {
+                queueChange(r.name, makeValue(String, edit->text()));
+                return;
+            }
+            bool ok = false;
+            const QJsonArray array = parseArray(type, edit->text(), ok);
+            if (!ok)
+            {
+                r.label->setStyleSheet("color: #ff5050; font: 11px;");
+                r.label->setToolTip("could not parse the values");
+                return;
+            }
+            queueChange(r.name, makeValue(type, array));
+        });
+        row.editor = edit;
+        break;
+    }
+    default:
+        row.editor = new QLabel("not set", rowsWidget_);
+        row.editor->setStyleSheet("color: #777; font: 11px;");
+        break;
+    }
+
+    rowsLayout_->addWidget(row.label, index, 0);
+    rowsLayout_->addWidget(row.editor, index, 1, 1, row.slider ? 1 : 2);
+    if (row.slider) rowsLayout_->addWidget(row.slider, index, 2);
+    rows_.append(row);
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::applyFilter()
+{
+    const QString filter = filterEdit_->text().trimmed();
+    for (const Row &row : std::as_const(rows_))
+    {
+        const bool visible = filter.isEmpty() || row.name.contains(filter, Qt::CaseInsensitive);
+        row.label->setVisible(visible);
+        row.editor->setVisible(visible);
+        if (row.slider) row.slider->setVisible(visible);
+    }
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::queueChange(const QString &name, const QJsonObject &value)
+{
+    // the newest value of a parameter wins, the timer is not restarted by later changes
+    pending_.insert(name, value);
+    if (!batchTimer_.isActive()) batchTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::flush()
+{
+    if (setInFlight_ || pending_.isEmpty()) return;
+    if (!caller_)
+    {
+        status_->setText("not connected, changes not sent");
+        return;
+    }
+
+    QJsonArray parameters;
+    QStringList names;
+    QList<QJsonObject> values;
+    for (auto it = pending_.constBegin(); it != pending_.constEnd(); ++it)
+    {
+        QJsonObject parameter;
+        parameter["name"] = it.key();
+        parameter["value"] = it.value();
+        parameters.append(parameter);
+        names.append(it.key());
+        values.append(it.value());
+    }
+    pending_.clear();
+
+    QJsonObject args;
+    args["parameters"] = parameters;
+    setInFlight_ = true;
+
+    QPointer<RomParameterEditor> self(this);
+    caller_->call(node_ + "/set_parameters", args, [self, names, values](const ServiceResult &result) {
+        if (self) self->onSetFinished(result, names, values);
+    });
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::onSetFinished(const ServiceResult &result, const QStringList &names,
+                                                             const QList<QJsonObject> &values)
+{
+    setInFlight_ = false;
+
+    if (result.rtt_ms >= 0)
+    {
+        ++rttCount_;
+        rttAvgMs_ += (result.rtt_ms - rttAvgMs_) / qMin(rttCount_, 20);
+    }
+
+    // rcl_interfaces/SetParametersResult per parameter, in request order
+    const QJsonArray results = result.values.value("results").toArray();
+    QStringList rejected;
+    for (int i = 0; i < names.size(); ++i)
+    {
+        const QJsonObject r = results.at(i).toObject();
+        const bool ok = result.ok && r.value("successful").toBool();
+        if (!ok) rejected.append(QString("%1 ( %2 )").arg(names[i], result.ok ? r.value("reason").toString() : result.error));
+
+        for (Row &row : rows_)
+        {
+            if (row.name != names[i]) continue;
+            row.label->setStyleSheet(ok ? "color: #bdb7b7; font: 11px;" : "color: #ff5050; font: 11px;");
+            row.label->setToolTip(ok ? QString() : (result.ok ? r.value("reason").toString() : result.error));
+
+            // the editor shows what the node holds, unless a newer change is already queued
+            if (ok) row.accepted = values[i];
+            else if (!pending_.contains(row.name)) showValue(row, row.accepted);
+            break;
+        }
+    }
+
+    QString text = QString("set %1 parameter%2  rtt %3 ms  ( avg %4 ms )")
+                       .arg(names.size()).arg(names.size() == 1 ? "" : "s")
+                       .arg(result.rtt_ms).arg(rttAvgMs_, 0, 'f', 1);
+    if (!rejected.isEmpty()) text += "  rejected : " + rejected.join(", ");
+    status_->setText(text);
+    status_->setStyleSheet(rejected.isEmpty() ? "color: #03fc84; font: 10px;" : "color: #ff5050; font: 10px;");
+
+    // changes made while this call was on the wire
+    if (!pending_.isEmpty() && !batchTimer_.isActive()) flush();
+}
+
+void rom_dynamics::ui::qt::RomParameterEditor::showValue(const Row &row, const QJsonObject &value)
+{
+    // no signals : putting a value back is not a change to send
+    const QSignalBlocker block_editor(row.editor);
+    switch (row.type)
+    {
+    case Bool:
+        static_cast<QCheckBox*>(row.editor)->setChecked(value.value("bool_value").toBool());
+        break;
+    case Integer:
+    case Double:
+    {
+        const double v = row.type == Integer ? double(value.value("integer_value").toInteger())
+                                             : value.value("double_value").toDouble();
+        static_cast<QDoubleSpinBox*>(row.editor)->setValue(v);
+        const QSignalBlocker block_slider(row.slider);
+        row.slider->setValue(int(std::lround(qBound(0.0, (v - row.lo) / (row.hi - row.lo), 1.0) * SLIDER_STEPS)));
+        break;
+    }
+    case String:
+    case ByteArray:
+    case BoolArray:
+    case IntegerArray:
+    case DoubleArray:
+    case StringArray:
+    {
+        QLineEdit *edit = static_cast<QLineEdit*>(row.editor);
+        edit->setText(row.type == String ? value.value("string_value").toString() : arrayText(row.type, value));
+        edit->setCursorPosition(0);
+        edit->setModified(false);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+QString rom_dynamics::ui::qt::RomParameterEditor::valueKey(int type)
+{
+    switch (type)
+    {
+    case Bool:          return "bool_value";
+    case Integer:       return "integer_value";
+    case Double:        return "double_value";
+    case String:        return "string_value";
+    case ByteArray:     return "byte_array_value";
+    case BoolArray:     return "bool_array_value";
+    case IntegerArray:  return "integer_array_value";
+    case DoubleArray:   return "double_array_value";
+    case StringArray:   return "string_array_value";
+    default:            return QString();
+    }
+}
+
+QJsonObject rom_dynamics::ui::qt::RomParameterEditor::makeValue(int type, const QJsonValue &value)
+{
+    QJsonObject parameter_value;
+    parameter_value["type"] = type;
+    parameter_value[valueKey(type)] = value;
+    return parameter_value;
+}
+
+QString rom_dynamics::ui::qt::RomParameterEditor::arrayText(int type, const QJsonObject &value)
+{
+    QStringList items;
+    for (const QJsonValue &item : value.value(valueKey(type)).toArray())
+    {
+        if (item.isBool()) items.append(item.toBool() ? "true" : "false");
+        else if (item.isString()) items.append(item.toString());
+        else items.append(QString::number(item.toDouble(), 'g', 10));
+    }
+    return items.join(", ");
+}
+
+QJsonArray rom_dynamics::ui::qt::RomParameterEditor::parseArray(int type, const QString &text, bool &ok)
+{
+    QJsonArray array;
+    ok = true;
+    const QStringList items = text.split(',', Qt::SkipEmptyParts);
+    for (const QString &raw : items)
+    {
+        const QString item = raw.trimmed();
+        bool item_ok = true;
+        switch (type)
+        {
+        case BoolArray:
+            item_ok = item == "true" || item == "false" || item == "1" || item == "0";
+            array.append(item == "true" || item == "1");
+            break;
+        case ByteArray:
+        {
+            const int b = item.toInt(&item_ok);
+            item_ok = item_ok && b >= 0 && b <= 255;
+            array.append(b);
+            break;
+        }
+        case IntegerArray:
+            array.append(item.toLongLong(&item_ok));
+            break;
+        case DoubleArray:
+            array.append(item.toDouble(&item_ok));
+            break;
+        default:
+            array.append(item);
+            break;
+        }
+        ok = ok && item_ok;
+    }
+    return array;
+}
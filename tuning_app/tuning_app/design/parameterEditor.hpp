@@ -0,0 +1,100 @@
+#ifndef ROM_PARAMETER_EDITOR_HPP
+#define ROM_PARAMETER_EDITOR_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QScrollArea>
+#include <QGridLayout>
+#include <QSlider>
+#include <QTimer>
+#include <QHash>
+#include <QPointer>
+#include <QJsonObject>
+#include <QJsonArray>
+#include "../communication/service_caller.hpp"
+
+namespace rom_dynamics::ui::qt {
+
+// Live ROS 2 parameters of one node ( list_parameters + get_parameters ), editable.
+// Every change is collected for BATCH_MS and then sent with the other pending changes
+// as one set_parameters call; a slider drag produces a few calls, not one per pixel.
+// Only one set_parameters per node is on the wire, changes made meanwhile go out
+// with the next call. The status line shows the round trip of each call.
+class RomParameterEditor : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int BATCH_MS = 120;
+    static constexpr int SLIDER_STEPS = 1000;
+    static constexpr double INT64_SPIN_LIMIT = 9.2e18;     // just inside int64, llround stays defined
+
+    explicit RomParameterEditor(QWidget *parent = nullptr);
+    ~RomParameterEditor() override = default;
+
+    void setServiceCaller(rom_dynamics::communication::ServiceCaller *caller);
+    void setNodes(const QStringList &nodes);
+
+    // list + get, replaces every row
+    void loadNode(const QString &node);
+
+    // rcl_interfaces/ParameterType
+    enum Type { NotSet = 0, Bool = 1, Integer = 2, Double = 3, String = 4, ByteArray = 5,
+                BoolArray = 6, IntegerArray = 7, DoubleArray = 8, StringArray = 9 };
+
+private:
+    struct Row {
+        QString name;
+        int type = NotSet;
+        QLabel *label = nullptr;
+        QWidget *editor = nullptr;      // QCheckBox / QDoubleSpinBox / QLineEdit
+        QSlider *slider = nullptr;      // numeric only, over [lo, hi] around the loaded value
+        double lo = 0.0;
+        double hi = 1.0;
+        QJsonObject accepted;           // ParameterValue the node last took, shown again on a reject
+    };
+
+    void clearRows();
+    void addRow(const QString &name, const QJsonObject &value);
+    void queueChange(const QString &name, const QJsonObject &value);
+    void flush();
+    void onSetFinished(const rom_dynamics::communication::ServiceResult &result, const QStringList &names,
+                       const QList<QJsonObject> &values);
+    void showValue(const Row &row, const QJsonObject &value);
+    void applyFilter();
+
+    static QString valueKey(int type);     // "double_value", "double_array_value", ...
+    static QJsonObject makeValue(int type, const QJsonValue &value);
+    static QJsonArray parseArray(int type, const QString &text, bool &ok);
+    static QString arrayText(int type, const QJsonObject &value);
+
+    QPointer<rom_dynamics::communication::ServiceCaller> caller_;
+    QString node_;
+
+    QComboBox *nodeCombo_;
+    QPushButton *loadBtn_;
+    QLineEdit *filterEdit_;
+    QScrollArea *scroll_;
+    QWidget *rowsWidget_;
+    QGridLayout *rowsLayout_;
+    QLabel *status_;
+
+    QList<Row> rows_;
+    QHash<QString, QJsonObject> pending_;   // name -> ParameterValue
+    QTimer batchTimer_;
+    bool setInFlight_ = false;
+    int loadGeneration_ = 0;                // answers of an older loadNode() are dropped
+
+    // round trip of set_parameters
+    double rttAvgMs_ = 0.0;
+    int rttCount_ = 0;
+};
+
+}
+
+#endif // ROM_PARAMETER_EDITOR_HPP
@@ -0,0 +1,269 @@
+#ifndef ROM_PATH_TRACKING_HPP
+#define ROM_PATH_TRACKING_HPP
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QPointF>
+#include <QtMath>
+#include <cmath>
+#include <limits>
+
+namespace rom_dynamics::ui::qt {
+
+// planar pose, world meters / rad
+struct RomPose2D {
+    double x = 0.0;
+    double y = 0.0;
+    double yaw = 0.0;
+};
+
+inline double romWrapAngle(double a)
+{
+    return std::atan2(std::sin(a), std::cos(a));
+}
+
+//================================================================================
+// 1. nav_msgs/Path segments in a uniform grid
+//================================================================================
+// A nearest segment query looks at the cells around the point, ring by ring, and
+// stops as soon as no farther ring can hold anything closer; the cost depends on
+// the local segment density, not on the plan length.
+// setPath() keeps the segments the new plan shares with the old one at its start
+// and at its end ( replanning from the robot usually changes only the head ) and
+// only moves the changed middle in and out of the grid.
+class RomPathIndex {
+public:
+    struct Nearest {
+        QPointF point;              // closest point on the path
+        double distance = 0.0;
+        double signed_distance = 0.0;   // > 0 : query point left of the path direction
+        double heading = 0.0;       // direction of the closest segment, rad
+        int segment = -1;           // index into the current plan
+    };
+
+    explicit RomPathIndex(double cell = 0.5) : cell_(cell) {}
+
+    // returns the number of segments that had to be ( re )inserted
+    int setPath(const QVector<QPointF> &poses)
+    {
+        const int old_n = order_.size();
+        const int new_n = qMax(0, int(poses.size()) - 1);
+
+        // shared head / tail, compared pose by pose
+        int head = 0;
+        while (head < old_n && head < new_n && poses_[head] == poses[head] && poses_[head + 1] == poses[head + 1]) ++head;
+        int tail = 0;
+        while (tail < old_n - head && tail < new_n - head
+               && poses_[poses_.size() - 1 - tail] == poses[poses.size() - 1 - tail]
+               && poses_[poses_.size() - 2 - tail] == poses[poses.size() - 2 - tail]) ++tail;
+
+        for (int i = head; i < old_n - tail; ++i) removeSegment(order_[i]);
+
+        QVector<int> order;
+        order.reserve(new_n);
+        for (int i = 0; i < head; ++i) order.append(order_[i]);
+        for (int i = head; i < new_n - tail; ++i) order.append(addSegment(poses[i], poses[i + 1]));
+        for (int i = old_n - tail; i < old_n; ++i) order.append(order_[i]);
+
+        order_ = order;
+        poses_ = poses;
+        for (int i = 0; i < order_.size(); ++i) segments_[order_[i]].index = i;
+        return new_n - head - tail;
+    }
+
+    void clear() { setPath({}); }
+
+    const QVector<QPointF> &path() const { return poses_; }
+    int segmentCount() const { return order_.size(); }
+
+    bool nearest(const QPointF &p, Nearest &out) const
+    {
+        if (order_.isEmpty()) return false;
+
+        const int cx = cellOf(p.x());
+        const int cy = cellOf(p.y());
+        // every occupied cell lies within this many rings
+        const int max_ring = qMax(qMax(qAbs(cx - min_cx_), qAbs(cx - max_cx_)), qMax(qAbs(cy - min_cy_), qAbs(cy - max_cy_)));
+
+        double best = std::numeric_limits<double>::max();
+        const Segment *best_segment = nullptr;
+        double best_t = 0.0;
+        for (int ring = 0; ring <= max_ring; ++ring)
+        {
+            for (int y = cy - ring; y <= cy + ring; ++y)
+            {
+                // inner rows only need the two border cells
+                const bool edge_row = (y == cy - ring || y == cy + ring);
+                const int step = edge_row ? 1 : qMax(1, 2 * ring);
+                for (int x = cx - ring; x <= cx + ring; x += step)
+                {
+                    auto it = cells_.constFind(key(x, y));
+                    if (it == cells_.constEnd()) continue;
+                    for (int id : *it)
+                    {
+                        const Segment &s = *segments_.constFind(id);
+                        double t = 0.0;
+                        const double d = distanceSquared(p, s, t);
+                        if (d < best) { best = d; best_segment = &s; best_t = t; }
+                    }
+                }
+            }
+            // anything in ring + 1 is at least ring cells away
+            if (best_segment && std::sqrt(best) <= ring * cell_) break;
+        }
+        if (!best_segment) return false;
+
+        const QPointF d = best_segment->b - best_segment->a;
+        out.point = best_segment->a + best_t * d;
+        out.distance = std::sqrt(best);
+        const double cross = d.x() * (p.y() - best_segment->a.y()) - d.y() * (p.x() - best_segment->a.x());
+        out.signed_distance = cross >= 0.0 ? out.distance : -out.distance;
+        out.heading = std::atan2(d.y(), d.x());
+        out.segment = best_segment->index;
+        return true;
+    }
+
+private:
+    struct Segment {
+        QPointF a;
+        QPointF b;
+        int index = 0;
+        int cx0 = 0, cy0 = 0, cx1 = 0, cy1 = 0;   // covered cells
+    };
+
+    int cellOf(double v) const { return int(std::floor(v / cell_)); }
+    static quint64 key(int x, int y) { return (quint64(quint32(x)) << 32) | quint32(y); }
+
+    static double distanceSquared(const QPointF &p, const Segment &s, double &t)
+    {
+        const double dx = s.b.x() - s.a.x(), dy = s.b.y() - s.a.y();
+        const double len2 = dx * dx + dy * dy;
+        t = len2 > 0.0 ? qBound(0.0, ((p.x() - s.a.x()) * dx + (p.y() - s.a.y()) * dy) / len2, 1.0) : 0.0;
+        const double ex = s.a.x() + t * dx - p.x(), ey = s.a.y() + t * dy - p.y();
+        return ex * ex + ey * ey;
+    }
+
+    int addSegment(const QPointF &a, const QPointF &b)
+    {
+        const int id = next_id_++;
+        Segment s;
+        s.a = a; s.b = b;
+        s.cx0 = cellOf(qMin(a.x(), b.x())); s.cx1 = cellOf(qMax(a.x(), b.x()));
+        s.cy0 = cellOf(qMin(a.y(), b.y())); s.cy1 = cellOf(qMax(a.y(), b.y()));
+        segments_.insert(id, s);
+
+        // bounding box cells, plan segments are a few cm so this is one or two cells
+        for (int y = s.cy0; y <= s.cy1; ++y)
+            for (int x = s.cx0; x <= s.cx1; ++x) cells_[key(x, y)].append(id);
+
+        if (segments_.size() == 1) { min_cx_ = s.cx0; max_cx_ = s.cx1; min_cy_ = s.cy0; max_cy_ = s.cy1; }
+        else
+        {
+            min_cx_ = qMin(min_cx_, s.cx0); max_cx_ = qMax(max_cx_, s.cx1);
+            min_cy_ = qMin(min_cy_, s.cy0); max_cy_ = qMax(max_cy_, s.cy1);
+        }
+        return id;
+    }
+
+    void removeSegment(int id)
+    {
+        auto found = segments_.find(id);
+        if (found == segments_.end()) return;
+        const Segment s = *found;
+        segments_.erase(found);
+
+        for (int y = s.cy0; y <= s.cy1; ++y)
+        {
+            for (int x = s.cx0; x <= s.cx1; ++x)
+            {
+                auto cell = cells_.find(key(x, y));
+                if (cell == cells_.end()) continue;
+                const int at = cell->indexOf(id);
+                if (at >= 0) { (*cell)[at] = cell->last(); cell->removeLast(); }
+                if (cell->isEmpty()) cells_.erase(cell);
+            }
+        }
+        // the bounds only grow; they just widen the ring limit of a query
+    }
+
+    double cell_;
+    QVector<QPointF> poses_;
+    QVector<int> order_;                    // plan order -> segment id
+    QHash<int, Segment> segments_;
+    QHash<quint64, QVector<int>> cells_;    // cell -> segment ids
+    int next_id_ = 0;
+    int min_cx_ = 0, max_cx_ = 0, min_cy_ = 0, max_cy_ = 0;
+};
+
+//================================================================================
+// 2. odom -> map without tf
+//================================================================================
+// The controller follows /plan in the map frame while /odom is in the odom frame.
+// Every map frame pose ( /amcl_pose ) is matched with the odom pose of the same
+// stamp; the map <- odom offset from that pair is applied to later odom samples.
+class RomMapOdomCorrection {
+public:
+    static constexpr double HISTORY_SEC = 2.0;
+
+    void addOdom(double t_sec, const RomPose2D &pose)
+    {
+        if (!odom_.isEmpty() && t_sec < odom_.last().t) odom_.clear();
+        odom_.append(Stamped{ t_sec, pose });
+        while (odom_.size() > 2 && odom_.first().t < t_sec - HISTORY_SEC) odom_.removeFirst();
+    }
+
+    // false while there is no odom sample close enough to the stamp
+    bool addMapPose(double t_sec, const RomPose2D &map_pose)
+    {
+        if (odom_.isEmpty() || t_sec < odom_.first().t - 0.1 || t_sec > odom_.last().t + 0.1) return false;
+
+        // a stamp past the newest sample ( up to 0.1 s ) uses the newest sample
+        RomPose2D odom = odom_.last().pose;
+        for (int i = 1; i < odom_.size(); ++i)
+        {
+            if (odom_[i].t < t_sec) continue;
+            const Stamped &a = odom_[i - 1];
+            const Stamped &b = odom_[i];
+            const double u = b.t > a.t ? qBound(0.0, (t_sec - a.t) / (b.t - a.t), 1.0) : 1.0;
+            odom.x = a.pose.x + u * (b.pose.x - a.pose.x);
+            odom.y = a.pose.y + u * (b.pose.y - a.pose.y);
+            odom.yaw = a.pose.yaw + u * romWrapAngle(b.pose.yaw - a.pose.yaw);
+            break;
+        }
+
+        // map <- odom = map_pose * odom^-1
+        dyaw_ = romWrapAngle(map_pose.yaw - odom.yaw);
+        const double c = std::cos(dyaw_), s = std::sin(dyaw_);
+        dx_ = map_pose.x - (c * odom.x - s * odom.y);
+        dy_ = map_pose.y - (s * odom.x + c * odom.y);
+        valid_ = true;
+        return true;
+    }
+
+    bool isValid() const { return valid_; }
+    void clear() { odom_.clear(); valid_ = false; dx_ = dy_ = dyaw_ = 0.0; }
+
+    // identity until the first map pose
+    RomPose2D toMap(const RomPose2D &odom) const
+    {
+        const double c = std::cos(dyaw_), s = std::sin(dyaw_);
+        return RomPose2D{ dx_ + c * odom.x - s * odom.y, dy_ + s * odom.x + c * odom.y, romWrapAngle(odom.yaw + dyaw_) };
+    }
+
+private:
+    struct Stamped {
+        double t;
+        RomPose2D pose;
+    };
+    QList<Stamped> odom_;
+    double dx_ = 0.0;
+    double dy_ = 0.0;
+    double dyaw_ = 0.0;
+    bool valid_ = false;
+};
+}
+
+#endif
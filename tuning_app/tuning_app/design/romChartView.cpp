@@ -0,0 +1,179 @@
+#include "romChartView.hpp"
+
+#include <QtCharts/QPolarChart>
+#include <QtCharts/QXYSeries>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QElapsedTimer>
+#include <QResizeEvent>
+#include <QtMath>
+
+using namespace rom_dynamics::ui::qt;
+
+namespace {
+struct ChartDefaults {
+    bool initialized = false;
+    RomChartBackend backend = RomChartBackend::Software;
+    bool overlay = false;
+};
+
+ChartDefaults &chartDefaults()
+{
+    static ChartDefaults defaults;
+    if (!defaults.initialized)
+    {
+        defaults.initialized = true;
+
+        const QByteArray env = qgetenv("ROM_CHART_BACKEND").toLower();
+        if (env == "software") defaults.backend = RomChartBackend::Software;
+        else if (env == "opengl") defaults.backend = RomChartBackend::OpenGL;
+        else defaults.backend = RomChartView::glRenderer().isEmpty() ? RomChartBackend::Software : RomChartBackend::OpenGL;
+
+        defaults.overlay = qEnvironmentVariableIntValue("ROM_CHART_FPS") != 0;
+    }
+    return defaults;
+}
+}
+
+rom_dynamics::ui::qt::RomChartView::RomChartView(QChart *chart, QWidget *parent)
+    : QChartView(chart, parent)
+{
+    overlay_ = new QLabel(this);
+    overlay_->setAttribute(Qt::WA_TransparentForMouseEvents);
+    overlay_->setStyleSheet("color: #03fc84; background: rgba(0,0,0,120); font: 9px; padding: 1px 3px;");
+    overlay_->setVisible(defaultOverlayVisible());
+
+    setRenderHint(QPainter::Antialiasing);
+    setBackend(defaultBackend());
+}
+
+RomChartBackend rom_dynamics::ui::qt::RomChartView::defaultBackend()
+{
+    return chartDefaults().backend;
+}
+
+void rom_dynamics::ui::qt::RomChartView::setDefaultBackend(RomChartBackend backend)
+{
+    chartDefaults().backend = backend;
+}
+
+bool rom_dynamics::ui::qt::RomChartView::defaultOverlayVisible()
+{
+    return chartDefaults().overlay;
+}
+
+void rom_dynamics::ui::qt::RomChartView::setDefaultOverlayVisible(bool visible)
+{
+    chartDefaults().overlay = visible;
+}
+
+QString rom_dynamics::ui::qt::RomChartView::glRenderer()
+{
+    // one probe per process
+    static bool probed = false;
+    static QString renderer;
+    if (probed) return renderer;
+    probed = true;
+
+    QOpenGLContext context;
+    if (!context.create()) return renderer;
+
+    QOffscreenSurface surface;
+    surface.setFormat(context.format());
+    surface.create();
+    if (!surface.isValid() || !context.makeCurrent(&surface)) return renderer;
+
+    const GLubyte *name = context.functions()->glGetString(GL_RENDERER);
+    renderer = name ? QString::fromLatin1(reinterpret_cast<const char*>(name)) : QString("unknown");
+    context.doneCurrent();
+    return renderer;
+}
+
+bool rom_dynamics::ui::qt::RomChartView::isSoftwareGl()
+{
+    const QString renderer = glRenderer().toLower();
+    return renderer.contains("llvmpipe") || renderer.contains("softpipe") || renderer.contains("swrast");
+}
+
+void rom_dynamics::ui::qt::RomChartView::setBackend(RomChartBackend backend)
+{
+    backend_ = backend;
+    applyBackend();
+}
+
+void rom_dynamics::ui::qt::RomChartView::applyBackend()
+{
+    // Qt Charts has no GL path for polar charts
+    const bool gl = backend_ == RomChartBackend::OpenGL
+                    && !qobject_cast<QPolarChart*>(chart())
+                    && !glRenderer().isEmpty();
+    effective_ = gl ? RomChartBackend::OpenGL : RomChartBackend::Software;
+
+    for (QAbstractSeries *series : chart()->series())
+    {
+        if (qobject_cast<QXYSeries*>(series)) series->setUseOpenGL(gl);
+    }
+
+    // GL series are not antialiased anyway; on llvmpipe every antialiased raster pixel costs CPU
+    setRenderHint(QPainter::Antialiasing, !(gl && isSoftwareGl()));
+    updateOverlay();
+}
+
+void rom_dynamics::ui::qt::RomChartView::setFrameOverlayVisible(bool visible)
+{
+    overlay_->setVisible(visible);
+    frames_ = 0;
+    paintMsSum_ = paintMsMax_ = 0.0;
+    windowClock_.invalidate();
+    updateOverlay();
+}
+
+void rom_dynamics::ui::qt::RomChartView::paintEvent(QPaintEvent *event)
+{
+    if (!overlay_->isVisible())
+    {
+        QChartView::paintEvent(event);
+        return;
+    }
+
+    QElapsedTimer paintClock;
+    paintClock.start();
+    QChartView::paintEvent(event);
+    const double ms = paintClock.nsecsElapsed() / 1e6;
+
+    if (!windowClock_.isValid()) windowClock_.start();
+    ++frames_;
+    paintMsSum_ += ms;
+    paintMsMax_ = qMax(paintMsMax_, ms);
+
+    if (windowClock_.elapsed() >= 1000) updateOverlay();
+}
+
+void rom_dynamics::ui::qt::RomChartView::resizeEvent(QResizeEvent *event)
+{
+    QChartView::resizeEvent(event);
+    overlay_->move(width() - overlay_->width() - 4, 4);
+}
+
+void rom_dynamics::ui::qt::RomChartView::updateOverlay()
+{
+    if (!overlay_->isVisible()) return;
+
+    const double seconds = windowClock_.isValid() ? windowClock_.elapsed() / 1000.0 : 0.0;
+    const double fps = seconds > 0.0 ? frames_ / seconds : 0.0;
+    const double avg = frames_ > 0 ? paintMsSum_ / frames_ : 0.0;
+
+    overlay_->setText(QString("%1  %2 fps  paint %3 / %4 ms")
+                      .arg(effective_ == RomChartBackend::OpenGL ? "GL" : "SW")
+                      .arg(fps, 0, 'f', 0)
+                      .arg(avg, 0, 'f', 1)
+                      .arg(paintMsMax_, 0, 'f', 1));
+    overlay_->adjustSize();
+    overlay_->move(width() - overlay_->width() - 4, 4);
+    overlay_->raise();
+
+    frames_ = 0;
+    paintMsSum_ = paintMsMax_ = 0.0;
+    if (windowClock_.isValid()) windowClock_.restart();
+}
@@ -0,0 +1,68 @@
+#ifndef ROM_CHART_VIEW_HPP
+#define ROM_CHART_VIEW_HPP
+
+#pragma once
+
+#include <QtCharts/QChartView>
+#include <QElapsedTimer>
+#include <QLabel>
+#include <QString>
+
+namespace rom_dynamics::ui::qt {
+
+enum class RomChartBackend { Software, OpenGL };
+
+// QChartView used by every rom graph.
+//   backend : OpenGL puts QLineSeries / QScatterSeries on Qt Charts' GL path
+//             ( setUseOpenGL ). Polar charts and machines without a usable GL context
+//             stay on the raster QPainter path.
+//   overlay : fps and paint time of the raster part, top right of the plot.
+// The process wide default comes from ROM_CHART_BACKEND=opengl|software and
+// ROM_CHART_FPS=1, otherwise OpenGL whenever a context can be created.
+class RomChartView : public QChartView
+{
+    Q_OBJECT
+
+public:
+    explicit RomChartView(QChart *chart, QWidget *parent = nullptr);
+    ~RomChartView() override = default;
+
+    static RomChartBackend defaultBackend();
+    static void setDefaultBackend(RomChartBackend backend);
+    static bool defaultOverlayVisible();
+    static void setDefaultOverlayVisible(bool visible);
+
+    // GL_RENDERER of a probe context, empty when no context could be created
+    static QString glRenderer();
+    static bool isSoftwareGl();   // llvmpipe / softpipe / swrast
+
+    void setBackend(RomChartBackend backend);
+    RomChartBackend backend() const { return backend_; }
+    // what actually renders, after the polar / no-GL fallback
+    RomChartBackend effectiveBackend() const { return effective_; }
+
+    // call after adding series to the chart
+    void applyBackend();
+
+    void setFrameOverlayVisible(bool visible);
+    bool frameOverlayVisible() const { return overlay_->isVisible(); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateOverlay();
+
+    RomChartBackend backend_ = RomChartBackend::Software;
+    RomChartBackend effective_ = RomChartBackend::Software;
+
+    QLabel *overlay_ = nullptr;
+    QElapsedTimer windowClock_;
+    int frames_ = 0;
+    double paintMsSum_ = 0.0;
+    double paintMsMax_ = 0.0;
+};
+}
+
+#endif
@@ -0,0 +1,291 @@
+#include "romGauge.hpp"
+
+#include <QPainter>
+#include <QRadialGradient>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGSimpleTextureNode>
+#include <QSGFlatColorMaterial>
+#include <QSGVertexColorMaterial>
+#include <QtQml/qqml.h>
+#include <QtMath>
+#include <cmath>
+
+using namespace rom_dynamics::ui::qt;
+
+namespace {
+// node order under the root : dial, needle, cap
+constexpr int kCapSegments = 24;
+
+// 0 -> left-most, max -> right-most, through the top ( screen y points down )
+inline double needleAngle(double speed, double max_speed)
+{
+    const double t = max_speed > 0.0 ? qBound(0.0, speed / max_speed, 1.0) : 0.0;
+    return M_PI + t * M_PI;
+}
+
+inline void setQuad(QSGGeometry::ColoredPoint2D *v, QPointF a, QPointF b, double half_width,
+                    const QColor &from, const QColor &to)
+{
+    const QPointF d = b - a;
+    const double len = std::hypot(d.x(), d.y());
+    const QPointF n = len > 0.0 ? QPointF(-d.y() / len, d.x() / len) * half_width : QPointF();
+
+    // premultiplied for QSGVertexColorMaterial
+    auto pm = [](const QColor &c, int ch) { return uchar(ch * c.alpha() / 255); };
+    const QPointF p[4] = { a + n, a - n, b + n, b - n };
+    const QColor c[4]  = { from, from, to, to };
+    const int order[6] = { 0, 1, 2, 2, 1, 3 };
+    for (int i = 0; i < 6; ++i)
+    {
+        const QColor &col = c[order[i]];
+        v[i].set(float(p[order[i]].x()), float(p[order[i]].y()),
+                 pm(col, col.red()), pm(col, col.green()), pm(col, col.blue()), uchar(col.alpha()));
+    }
+}
+}
+
+rom_dynamics::ui::qt::RomGauge::RomGauge(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void rom_dynamics::ui::qt::RomGauge::registerQmlType()
+{
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+    qmlRegisterType<RomGauge>("RomGauges", 1, 0, "RomGauge");
+}
+
+void rom_dynamics::ui::qt::RomGauge::setSpeed(double speed)
+{
+    if (qFuzzyCompare(1.0 + speed, 1.0 + speed_)) return;
+    speed_ = speed;
+    needle_dirty_ = true;
+    emit speedChanged();
+    update();
+}
+
+void rom_dynamics::ui::qt::RomGauge::setMaxSpeed(double max_speed)
+{
+    if (max_speed <= 0.0 || qFuzzyCompare(max_speed, max_speed_)) return;
+    max_speed_ = max_speed;
+    dial_dirty_ = needle_dirty_ = true;
+    emit maxSpeedChanged();
+    update();
+}
+
+void rom_dynamics::ui::qt::RomGauge::setLabelScale(double scale)
+{
+    if (scale <= 0.0 || qFuzzyCompare(scale, label_scale_)) return;
+    label_scale_ = scale;
+    dial_dirty_ = true;
+    emit dialChanged();
+    emit speedChanged();
+    update();
+}
+
+void rom_dynamics::ui::qt::RomGauge::setValueDecimals(int decimals)
+{
+    if (decimals == value_decimals_) return;
+    value_decimals_ = qBound(0, decimals, 6);
+    emit speedChanged();
+}
+
+void rom_dynamics::ui::qt::RomGauge::setCaption(const QString &caption)
+{
+    if (caption == caption_) return;
+    caption_ = caption;
+    dial_dirty_ = true;
+    emit dialChanged();
+    update();
+}
+
+QString rom_dynamics::ui::qt::RomGauge::valueText() const
+{
+    const double value = speed_ / label_scale_;
+    return value_decimals_ > 0 ? QString::number(value, 'f', value_decimals_)
+                               : QString::number(qRound(value));
+}
+
+void rom_dynamics::ui::qt::RomGauge::geometryChange(const QRectF &new_geometry, const QRectF &old_geometry)
+{
+    QQuickItem::geometryChange(new_geometry, old_geometry);
+    if (new_geometry.size() != old_geometry.size())
+    {
+        dial_dirty_ = needle_dirty_ = true;
+        update();
+    }
+}
+
+QImage rom_dynamics::ui::qt::RomGauge::renderDial(const QSize &size) const
+{
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setRenderHint(QPainter::TextAntialiasing);
+
+    const double w = size.width(), h = size.height();
+    const QPointF c(w / 2.0, h / 2.0);
+    const double radius = qMin(w, h) * 0.45;
+
+    // background radial gradient
+    QRadialGradient g(c, radius * 1.1, c + QPointF(-radius * 0.2, -radius * 0.3));
+    g.setColorAt(0.0, QColor("#111111"));
+    g.setColorAt(0.6, QColor("#222222"));
+    g.setColorAt(1.0, QColor("#000000"));
+    p.setPen(Qt::NoPen);
+    p.setBrush(g);
+    p.drawEllipse(c, radius * 1.05, radius * 1.05);
+
+    // outer bezel
+    p.setBrush(Qt::NoBrush);
+    p.setPen(QPen(QColor("#1a1a1a"), qMax(2.0, radius * 0.03)));
+    p.drawEllipse(c, radius * 1.02, radius * 1.02);
+
+    // ticks every 5, labels every 10
+    QFont font("sans-serif");
+    font.setPixelSize(qMax(6, qRound(radius * 0.09)));
+    p.setFont(font);
+
+    const int steps = qMax(1, qRound(max_speed_ / 5.0));
+    for (int i = 0; i <= steps; ++i)
+    {
+        const double t = double(i) / steps;
+        const double angle = M_PI + t * M_PI;
+        const bool major = (i % 2) == 0;
+        const double inner = radius * (major ? 0.76 : 0.82);
+        const double outer = radius * 0.95;
+        const QPointF dir(std::cos(angle), std::sin(angle));
+
+        p.setPen(QPen(QColor("#cfcfcf"), qMax(1.0, radius * (major ? 0.008 : 0.004))));
+        p.drawLine(c + dir * inner, c + dir * outer);
+
+        const double value = t * max_speed_;
+        if (qRound(value) % 10 == 0)
+        {
+            const double shown = value / label_scale_;
+            const QString text = label_scale_ > 1.0 ? QString::number(shown, 'f', 1) : QString::number(qRound(shown));
+            const QPointF at = c + dir * (radius * 0.62);
+            p.setPen(QColor("#dcdcdc"));
+            p.drawText(QRectF(at.x() - radius * 0.2, at.y() - radius * 0.08, radius * 0.4, radius * 0.16),
+                       Qt::AlignCenter, text);
+        }
+    }
+
+    // center shadow / inner circle
+    QRadialGradient g2(c, radius * 0.7, c + QPointF(-radius * 0.1, -radius * 0.1));
+    g2.setColorAt(0.0, QColor(255, 255, 255, 13));
+    g2.setColorAt(1.0, QColor(0, 0, 0, 153));
+    p.setPen(Qt::NoPen);
+    p.setBrush(g2);
+    p.drawEllipse(c, radius * 0.55, radius * 0.55);
+
+    // caption under the value text
+    p.setPen(QColor("#cfcfcf"));
+    p.drawText(QRectF(0, c.y() + 55 - radius * 0.08, w, radius * 0.16), Qt::AlignCenter, caption_);
+
+    return image;
+}
+
+QSGNode *rom_dynamics::ui::qt::RomGauge::updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *)
+{
+    const QRectF bounds = boundingRect();
+    if (bounds.isEmpty() || !window())
+    {
+        delete old_node;
+        return nullptr;
+    }
+
+    QSGNode *root = old_node;
+    QSGSimpleTextureNode *dial = nullptr;
+    QSGGeometryNode *needle = nullptr;
+    QSGGeometryNode *cap = nullptr;
+
+    if (!root)
+    {
+        root = new QSGNode();
+
+        dial = new QSGSimpleTextureNode();
+        dial->setOwnsTexture(true);
+        root->appendChildNode(dial);
+
+        // shadow quad + body quad
+        needle = new QSGGeometryNode();
+        QSGGeometry *needle_geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 12);
+        needle_geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        needle->setGeometry(needle_geometry);
+        needle->setFlag(QSGNode::OwnsGeometry);
+        needle->setMaterial(new QSGVertexColorMaterial());
+        needle->setFlag(QSGNode::OwnsMaterial);
+        root->appendChildNode(needle);
+
+        cap = new QSGGeometryNode();
+        QSGGeometry *cap_geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), kCapSegments + 2);
+        cap_geometry->setDrawingMode(QSGGeometry::DrawTriangleFan);
+        cap->setGeometry(cap_geometry);
+        cap->setFlag(QSGNode::OwnsGeometry);
+        QSGFlatColorMaterial *cap_material = new QSGFlatColorMaterial();
+        cap_material->setColor(QColor("#222222"));
+        cap->setMaterial(cap_material);
+        cap->setFlag(QSGNode::OwnsMaterial);
+        root->appendChildNode(cap);
+
+        dial_dirty_ = needle_dirty_ = true;
+    }
+    else
+    {
+        dial = static_cast<QSGSimpleTextureNode*>(root->childAtIndex(0));
+        needle = static_cast<QSGGeometryNode*>(root->childAtIndex(1));
+        cap = static_cast<QSGGeometryNode*>(root->childAtIndex(2));
+    }
+
+    const QPointF c = bounds.center();
+    const double radius = qMin(bounds.width(), bounds.height()) * 0.45;
+
+    if (dial_dirty_)
+    {
+        dial_dirty_ = false;
+        const QImage image = renderDial(bounds.size().toSize());
+        // the node owns its texture, setTexture() deletes the previous one
+        dial->setTexture(window()->createTextureFromImage(image));
+        dial->setRect(bounds);
+
+        QSGGeometry::Point2D *v = cap->geometry()->vertexDataAsPoint2D();
+        const double cap_radius = qMax(6.0, radius * 0.07);
+        v[0].set(float(c.x()), float(c.y()));
+        for (int i = 0; i <= kCapSegments; ++i)
+        {
+            const double a = 2.0 * M_PI * i / kCapSegments;
+            v[i + 1].set(float(c.x() + cap_radius * std::cos(a)), float(c.y() + cap_radius * std::sin(a)));
+        }
+        cap->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    if (needle_dirty_)
+    {
+        needle_dirty_ = false;
+        const double angle = needleAngle(speed_, max_speed_);
+        const double len = radius * 0.90;
+        const QPointF dir(std::cos(angle), std::sin(angle));
+        const QPointF tip = c + dir * len;
+
+        QSGGeometry::ColoredPoint2D *v = needle->geometry()->vertexDataAsColoredPoint2D();
+        const QPointF shadow_offset(-2.0, -2.0);
+        const QPointF shadow_base = c + shadow_offset + QPointF(std::cos(angle - M_PI_2), std::sin(angle - M_PI_2)) * (len * 0.05);
+        setQuad(v, shadow_base, tip + shadow_offset, qMax(6.0, radius * 0.06) / 2.0,
+                QColor(0, 0, 0, 153), QColor(0, 0, 0, 153));
+
+        const QPointF base = c + QPointF(std::cos(angle + M_PI_2), std::sin(angle + M_PI_2)) * (len * 0.06);
+        setQuad(v + 6, base, tip, qMax(4.0, radius * 0.05) / 2.0, QColor("#7f0000"), QColor("#ff0000"));
+        needle->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    return root;
+}
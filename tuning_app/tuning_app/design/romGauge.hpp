@@ -0,0 +1,76 @@
+#ifndef ROM_GAUGE_ITEM_HPP
+#define ROM_GAUGE_ITEM_HPP
+
+#pragma once
+
+#include <QQuickItem>
+#include <QImage>
+#include <QString>
+
+namespace rom_dynamics::ui::qt {
+
+// Half circle speed / rpm gauge drawn straight into the scene graph.
+//   dial   : gradient, bezel, ticks, labels and caption rendered once into a texture,
+//            redrawn only when size, range or caption change
+//   needle : one vertex-colored geometry node, only its 12 vertices change per value
+//   cap    : flat colored fan over the needle
+// The value text is a QML Text bound to valueText ( see Gauges.qml ), so glyphs are cached too.
+class RomGauge : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(double maxSpeed READ maxSpeed WRITE setMaxSpeed NOTIFY maxSpeedChanged)
+    Q_PROPERTY(double labelScale READ labelScale WRITE setLabelScale NOTIFY dialChanged)
+    Q_PROPERTY(int valueDecimals READ valueDecimals WRITE setValueDecimals NOTIFY speedChanged)
+    Q_PROPERTY(QString caption READ caption WRITE setCaption NOTIFY dialChanged)
+    Q_PROPERTY(QString valueText READ valueText NOTIFY speedChanged)
+
+public:
+    explicit RomGauge(QQuickItem *parent = nullptr);
+    ~RomGauge() override = default;
+
+    // qmlRegisterType, once per process ( import RomGauges 1.0 )
+    static void registerQmlType();
+
+    double speed() const { return speed_; }
+    void setSpeed(double speed);
+
+    double maxSpeed() const { return max_speed_; }
+    void setMaxSpeed(double max_speed);
+
+    // dial labels and value text show speed / labelScale ( 100 -> m/s gauges fed in cm/s )
+    double labelScale() const { return label_scale_; }
+    void setLabelScale(double scale);
+
+    int valueDecimals() const { return value_decimals_; }
+    void setValueDecimals(int decimals);
+
+    QString caption() const { return caption_; }
+    void setCaption(const QString &caption);
+
+    QString valueText() const;
+
+signals:
+    void speedChanged();
+    void maxSpeedChanged();
+    void dialChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &new_geometry, const QRectF &old_geometry) override;
+
+private:
+    QImage renderDial(const QSize &size) const;
+
+    double speed_ = 0.0;
+    double max_speed_ = 100.0;
+    double label_scale_ = 1.0;
+    int value_decimals_ = 0;
+    QString caption_;
+
+    bool dial_dirty_ = true;
+    bool needle_dirty_ = true;
+};
+}
+
+#endif
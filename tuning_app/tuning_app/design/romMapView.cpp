@@ -0,0 +1,446 @@
+#include "romMapView.hpp"
+
+#include <QQuickWindow>
+#include <QElapsedTimer>
+#include <QSGGeometryNode>
+#include <QSGOpacityNode>
+#include <QSGVertexColorMaterial>
+#include <QSGFlatColorMaterial>
+#include <QSGSimpleTextureNode>
+#include <QSGTransformNode>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QtQml/qqml.h>
+#include <QtMath>
+#include <cmath>
+
+using namespace rom_dynamics::ui::qt;
+
+rom_dynamics::ui::qt::RomMapView::RomMapView(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    setAcceptedMouseButtons(Qt::LeftButton);
+    setClip(true);
+}
+
+void rom_dynamics::ui::qt::RomMapView::registerQmlType()
+{
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+    qmlRegisterType<RomMapView>("RomMaps", 1, 0, "RomMapView");
+}
+
+//================================================================================
+// 1. grid layers ( ui thread )
+//================================================================================
+
+void rom_dynamics::ui::qt::RomMapView::attachGridSource(int layer, OccupancyGridSource *source)
+{
+    connect(source, &OccupancyGridSource::gridReset, this, [this, layer](const RomGridInfo &info) { setGridInfo(layer, info); });
+    connect(source, &OccupancyGridSource::tilesReady, this, [this, layer](const QList<RomGridTile> &tiles) { updateTiles(layer, tiles); });
+}
+
+void rom_dynamics::ui::qt::RomMapView::setGridInfo(int layer, const RomGridInfo &info)
+{
+    GridLayer &grid = layers_[layer];
+    grid.info = info;
+    grid.reset = true;
+    for (const Tile &tile : std::as_const(grid.tiles))
+    {
+        if (tile.node) grid.stale.append(tile.node);
+    }
+    grid.tiles.clear();
+
+    if (!user_moved_ && layer == layers_.firstKey()) fitToLayer(layer);
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::updateTiles(int layer, const QList<RomGridTile> &tiles)
+{
+    GridLayer &grid = layers_[layer];
+    for (const RomGridTile &incoming : tiles)
+    {
+        Tile &tile = grid.tiles[tileKey(incoming)];
+        tile.data = incoming;
+        tile.dirty = true;
+    }
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::setLayerOpacity(int layer, double opacity)
+{
+    layers_[layer].opacity = qBound(0.0, opacity, 1.0);
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::clearLayer(int layer)
+{
+    setGridInfo(layer, RomGridInfo{});
+}
+
+void rom_dynamics::ui::qt::RomMapView::fitToLayer(int layer)
+{
+    auto it = layers_.constFind(layer);
+    if (it == layers_.constEnd() || !it->info.isValid() || width() <= 0 || height() <= 0) return;
+
+    const RomGridInfo &info = it->info;
+    const double w = info.width * info.resolution;
+    const double h = info.height * info.resolution;
+    center_ = QPointF(info.origin_x + w / 2.0, info.origin_y + h / 2.0);
+    scale_ = 0.95 * qMin(width() / w, height() / h);
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::pushScan(const QVector<QPointF> &points)
+{
+    scans_.push(points);
+    scan_dirty_ = true;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::setScanDepth(int depth)
+{
+    scans_.setDepth(depth);
+    scan_dirty_ = true;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::setScanColor(const QColor &color)
+{
+    scan_color_ = color;
+    scan_dirty_ = true;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::clearScan()
+{
+    scans_.clear();
+    scan_dirty_ = true;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::setPath(int id, const QVector<QPointF> &points, const QColor &color)
+{
+    PathLayer &path = paths_[id];
+    path.points = points;
+    path.color = color;
+    path.dirty = true;
+    path.remove = false;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::clearPath(int id)
+{
+    auto it = paths_.find(id);
+    if (it == paths_.end()) return;
+    it->remove = true;      // the node goes on the render side
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::setRobotPose(double x, double y, double yaw)
+{
+    has_robot_ = true;
+    robot_position_ = QPointF(x, y);
+    robot_yaw_ = yaw;
+    robot_dirty_ = true;
+    if (!user_moved_ && layers_.isEmpty()) center_ = robot_position_;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::clearRobotPose()
+{
+    has_robot_ = false;
+    robot_dirty_ = true;
+    update();
+}
+
+//================================================================================
+// 2. view
+//================================================================================
+
+QMatrix4x4 rom_dynamics::ui::qt::RomMapView::viewMatrix() const
+{
+    QMatrix4x4 m;
+    m.translate(float(width() / 2.0), float(height() / 2.0));
+    m.scale(float(scale_));
+    m.translate(float(-center_.x()), float(center_.y()));
+    return m;
+}
+
+QPointF rom_dynamics::ui::qt::RomMapView::worldToItem(const QPointF &world) const
+{
+    return QPointF(width() / 2.0 + (world.x() - center_.x()) * scale_,
+                   height() / 2.0 - (world.y() - center_.y()) * scale_);
+}
+
+QPointF rom_dynamics::ui::qt::RomMapView::itemToWorld(const QPointF &item) const
+{
+    return QPointF(center_.x() + (item.x() - width() / 2.0) / scale_,
+                   center_.y() - (item.y() - height() / 2.0) / scale_);
+}
+
+void rom_dynamics::ui::qt::RomMapView::geometryChange(const QRectF &new_geometry, const QRectF &old_geometry)
+{
+    QQuickItem::geometryChange(new_geometry, old_geometry);
+    if (!user_moved_ && !layers_.isEmpty()) fitToLayer(layers_.firstKey());
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::mousePressEvent(QMouseEvent *event)
+{
+    drag_last_ = event->position();
+    event->accept();
+}
+
+void rom_dynamics::ui::qt::RomMapView::mouseMoveEvent(QMouseEvent *event)
+{
+    const QPointF delta = event->position() - drag_last_;
+    drag_last_ = event->position();
+    center_ -= QPointF(delta.x() / scale_, -delta.y() / scale_);
+    user_moved_ = true;
+    update();
+}
+
+void rom_dynamics::ui::qt::RomMapView::mouseReleaseEvent(QMouseEvent *event)
+{
+    event->accept();
+}
+
+void rom_dynamics::ui::qt::RomMapView::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    // back to auto fit
+    user_moved_ = false;
+    if (!layers_.isEmpty()) fitToLayer(layers_.firstKey());
+    event->accept();
+}
+
+void rom_dynamics::ui::qt::RomMapView::wheelEvent(QWheelEvent *event)
+{
+    // zoom about the cursor : the world point under it stays put
+    const QPointF anchor = itemToWorld(event->position());
+    const double factor = std::pow(1.0015, event->angleDelta().y());
+    scale_ = qBound(0.5, scale_ * factor, 2000.0);
+    const QPointF moved = itemToWorld(event->position());
+    center_ += anchor - moved;
+    user_moved_ = true;
+    event->accept();
+    update();
+}
+
+//================================================================================
+// 3. scene graph ( render thread, ui thread blocked )
+//================================================================================
+
+QSGNode *rom_dynamics::ui::qt::RomMapView::updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *)
+{
+    if (!window())
+    {
+        delete old_node;
+        return nullptr;
+    }
+
+    QSGTransformNode *root = static_cast<QSGTransformNode*>(old_node);
+    if (!root)
+    {
+        // fresh tree ( first frame or the scene graph was rebuilt ) : upload every tile again
+        root = new QSGTransformNode();
+        for (GridLayer &grid : layers_)
+        {
+            grid.node = nullptr;
+            grid.stale.clear();
+            for (Tile &tile : grid.tiles) { tile.node = nullptr; tile.dirty = true; }
+        }
+
+        // scan and robot stay last, grid layers are inserted in front of them
+        auto makeNode = [root]() {
+            QSGGeometryNode *node = new QSGGeometryNode();
+            QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+            geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+            node->setGeometry(geometry);
+            node->setFlag(QSGNode::OwnsGeometry);
+            node->setMaterial(new QSGVertexColorMaterial());
+            node->setFlag(QSGNode::OwnsMaterial);
+            root->appendChildNode(node);
+            return node;
+        };
+        scan_node_ = makeNode();
+        robot_node_ = makeNode();
+        scan_dirty_ = robot_dirty_ = true;
+        for (PathLayer &path : paths_) { path.node = nullptr; path.dirty = true; }
+    }
+
+    root->setMatrix(viewMatrix());
+    syncGridLayers(root);
+    syncPaths(root);
+
+    // dots and the robot keep their size in pixels
+    if (marker_scale_ != scale_)
+    {
+        marker_scale_ = scale_;
+        scan_dirty_ = robot_dirty_ = true;
+    }
+    if (scan_dirty_) syncScan(scan_node_);
+    if (robot_dirty_) syncRobot(robot_node_);
+    return root;
+}
+
+void rom_dynamics::ui::qt::RomMapView::syncPaths(QSGNode *parent)
+{
+    for (auto it = paths_.begin(); it != paths_.end();)
+    {
+        PathLayer &path = it.value();
+        if (path.remove)
+        {
+            delete path.node;
+            it = paths_.erase(it);
+            continue;
+        }
+
+        if (!path.node)
+        {
+            path.node = new QSGGeometryNode();
+            QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+            geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+            geometry->setLineWidth(1.0f);    // the only width every rhi backend draws
+            path.node->setGeometry(geometry);
+            path.node->setFlag(QSGNode::OwnsGeometry);
+            path.node->setMaterial(new QSGFlatColorMaterial());
+            path.node->setFlag(QSGNode::OwnsMaterial);
+            // below the scan and robot nodes
+            parent->insertChildNodeBefore(path.node, scan_node_);
+        }
+
+        if (path.dirty)
+        {
+            path.dirty = false;
+            QSGGeometry *geometry = path.node->geometry();
+            if (geometry->vertexCount() != path.points.size()) geometry->allocate(path.points.size());
+            QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+            for (const QPointF &p : std::as_const(path.points)) (v++)->set(float(p.x()), float(-p.y()));
+            static_cast<QSGFlatColorMaterial*>(path.node->material())->setColor(path.color);
+            path.node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+        }
+        ++it;
+    }
+}
+
+void rom_dynamics::ui::qt::RomMapView::syncScan(QSGGeometryNode *node)
+{
+    scan_dirty_ = false;
+
+    // one quad ( two triangles ) per beam, all scans in the same buffer
+    const int points = scans_.totalPoints();
+    QSGGeometry *geometry = node->geometry();
+    if (geometry->vertexCount() != points * 6) geometry->allocate(points * 6);
+
+    QSGGeometry::ColoredPoint2D *v = geometry->vertexDataAsColoredPoint2D();
+    const float h = float(SCAN_DOT_PX / 2.0 / scale_);
+    for (int age = 0; age < scans_.size(); ++age)
+    {
+        // newest opaque, oldest faint ( premultiplied for QSGVertexColorMaterial )
+        const int alpha = 255 - age * 200 / qMax(1, scans_.depth());
+        const uchar r = uchar(scan_color_.red() * alpha / 255);
+        const uchar g = uchar(scan_color_.green() * alpha / 255);
+        const uchar b = uchar(scan_color_.blue() * alpha / 255);
+
+        for (const QPointF &p : scans_.at(age))
+        {
+            const float x = float(p.x()), y = float(-p.y());
+            v[0].set(x - h, y - h, r, g, b, uchar(alpha));
+            v[1].set(x + h, y - h, r, g, b, uchar(alpha));
+            v[2].set(x - h, y + h, r, g, b, uchar(alpha));
+            v[3].set(x - h, y + h, r, g, b, uchar(alpha));
+            v[4].set(x + h, y - h, r, g, b, uchar(alpha));
+            v[5].set(x + h, y + h, r, g, b, uchar(alpha));
+            v += 6;
+        }
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void rom_dynamics::ui::qt::RomMapView::syncRobot(QSGGeometryNode *node)
+{
+    robot_dirty_ = false;
+
+    QSGGeometry *geometry = node->geometry();
+    if (!has_robot_)
+    {
+        geometry->allocate(0);
+        node->markDirty(QSGNode::DirtyGeometry);
+        return;
+    }
+    if (geometry->vertexCount() != 3) geometry->allocate(3);
+
+    // arrow head along the heading, node space is ( x, -y )
+    const double size = ROBOT_PX / scale_;
+    const double c = std::cos(robot_yaw_), s = std::sin(robot_yaw_);
+    auto corner = [&](double fx, double fy) {
+        return QPointF(robot_position_.x() + c * fx - s * fy, -(robot_position_.y() + s * fx + c * fy));
+    };
+    const QPointF tip = corner(size, 0.0);
+    const QPointF left = corner(-size * 0.5, size * 0.5);
+    const QPointF right = corner(-size * 0.5, -size * 0.5);
+
+    QSGGeometry::ColoredPoint2D *v = geometry->vertexDataAsColoredPoint2D();
+    v[0].set(float(tip.x()), float(tip.y()), 0x03, 0xfc, 0x84, 255);
+    v[1].set(float(left.x()), float(left.y()), 0x03, 0xfc, 0x84, 255);
+    v[2].set(float(right.x()), float(right.y()), 0x03, 0xfc, 0x84, 255);
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void rom_dynamics::ui::qt::RomMapView::syncGridLayers(QSGNode *parent)
+{
+    QSGNode *previous = nullptr;
+    for (auto it = layers_.begin(); it != layers_.end(); ++it)
+    {
+        GridLayer &grid = it.value();
+        if (!grid.node)
+        {
+            grid.node = new QSGOpacityNode();
+            if (previous) parent->insertChildNodeAfter(grid.node, previous);
+            else parent->prependChildNode(grid.node);
+        }
+        previous = grid.node;
+        grid.node->setOpacity(grid.opacity);
+
+        if (grid.reset)
+        {
+            qDeleteAll(grid.stale);     // deleting a node detaches it and its texture
+            grid.stale.clear();
+            grid.reset = false;
+        }
+
+        QElapsedTimer clock;
+        clock.start();
+        int uploaded = 0;
+
+        const RomGridInfo &info = grid.info;
+        for (Tile &tile : grid.tiles)
+        {
+            if (!tile.dirty) continue;
+            tile.dirty = false;
+            if (tile.data.image.isNull()) continue;
+            ++uploaded;
+
+            if (!tile.node)
+            {
+                tile.node = new QSGSimpleTextureNode();
+                tile.node->setOwnsTexture(true);
+                tile.node->setFiltering(QSGTexture::Nearest);     // crisp cells when zoomed in
+                grid.node->appendChildNode(tile.node);
+            }
+
+            // owned by the node, setTexture() deletes the previous one
+            tile.node->setTexture(window()->createTextureFromImage(tile.data.image, QQuickWindow::TextureCanUseAtlas));
+
+            // node space is ( x, -y ), the image top is the highest row of the tile
+            const double x = info.origin_x + tile.data.col0 * info.resolution;
+            const double top = info.origin_y + (tile.data.row0 + tile.data.rows) * info.resolution;
+            tile.node->setRect(QRectF(x, -top, tile.data.cols * info.resolution, tile.data.rows * info.resolution));
+        }
+
+        if (uploaded > 0) emit tilesUploaded(it.key(), uploaded, clock.nsecsElapsed() / 1e6);
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef ROM_MAP_VIEW_HPP
+#define ROM_MAP_VIEW_HPP
+
+#pragma once
+
+#include <QQuickItem>
+#include <QColor>
+#include <QHash>
+#include <QMap>
+#include <QPointF>
+#include <QMatrix4x4>
+#include "occupancyGrid.hpp"
+#include "scanLayer.hpp"
+
+class QSGGeometryNode;
+class QSGOpacityNode;
+class QSGSimpleTextureNode;
+class QSGTransformNode;
+
+namespace rom_dynamics::ui::qt {
+
+// Pan / zoom map canvas in the scene graph ( carto and nav2 tabs ).
+//   grid layers : OccupancyGrid tiles as textures, one texture node per tile; a tile is
+//                 uploaded again only when OccupancyGridSource reports it changed
+//   scan        : last few LaserScans as small quads in one vertex buffer, rebuilt at most
+//                 once per frame, older scans fade out
+//   paths       : polylines ( plans, odom trail ), one line strip node each
+//   robot       : one triangle at the robot pose
+//   view        : one transform node, so panning and zooming never touch the tiles
+// Node coordinates are world meters with y flipped ( x, -y ).
+class RomMapView : public QQuickItem
+{
+    Q_OBJECT
+
+public:
+    explicit RomMapView(QQuickItem *parent = nullptr);
+    ~RomMapView() override = default;
+
+    // qmlRegisterType, once per process ( import RomMaps 1.0 )
+    static void registerQmlType();
+
+    // layers draw in ascending id order
+    void attachGridSource(int layer, OccupancyGridSource *source);
+    void setGridInfo(int layer, const RomGridInfo &info);
+    void updateTiles(int layer, const QList<RomGridTile> &tiles);
+    void setLayerOpacity(int layer, double opacity);
+    void clearLayer(int layer);
+
+    Q_INVOKABLE void fitToLayer(int layer);
+
+    // world points of one scan ( RomScanProjector ), drawn above every grid layer
+    void pushScan(const QVector<QPointF> &points);
+    void setScanDepth(int depth);
+    void setScanColor(const QColor &color);
+    void clearScan();
+
+    // world polyline, drawn above the grids and below the scans; ids draw in ascending order
+    void setPath(int id, const QVector<QPointF> &points, const QColor &color);
+    void clearPath(int id);
+
+    // without any grid layer the view follows the robot until the user pans / zooms
+    void setRobotPose(double x, double y, double yaw);
+    void clearRobotPose();
+
+    double viewScale() const { return scale_; }    // px / m
+    QPointF viewCenter() const { return center_; }  // world m
+    QPointF worldToItem(const QPointF &world) const;
+    QPointF itemToWorld(const QPointF &item) const;
+
+signals:
+    // render side, per frame that created textures for a layer
+    void tilesUploaded(int layer, int tiles, double upload_ms);
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *old_node, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &new_geometry, const QRectF &old_geometry) override;
+
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+private:
+    struct Tile {
+        RomGridTile data;
+        bool dirty = true;
+        QSGSimpleTextureNode *node = nullptr;   // render side
+    };
+    struct GridLayer {
+        RomGridInfo info;
+        QHash<quint32, Tile> tiles;
+        double opacity = 1.0;
+        bool reset = true;                      // drop every tile node before the next upload
+        QList<QSGSimpleTextureNode*> stale;     // nodes of a previous layout
+        QSGOpacityNode *node = nullptr;
+    };
+
+    static quint32 tileKey(const RomGridTile &tile)
+    {
+        return quint32(tile.col0 / OccupancyGridDecoder::TILE) | (quint32(tile.row0 / OccupancyGridDecoder::TILE) << 16);
+    }
+    static constexpr double SCAN_DOT_PX = 3.0;
+    static constexpr double ROBOT_PX = 14.0;
+
+    struct PathLayer {
+        QVector<QPointF> points;
+        QColor color;
+        bool dirty = true;
+        bool remove = false;
+        QSGGeometryNode *node = nullptr;
+    };
+
+    QMatrix4x4 viewMatrix() const;
+    void syncGridLayers(QSGNode *parent);
+    void syncPaths(QSGNode *parent);
+    void syncScan(QSGGeometryNode *node);
+    void syncRobot(QSGGeometryNode *node);
+
+    QMap<int, GridLayer> layers_;
+
+    QMap<int, PathLayer> paths_;
+
+    RomScanHistory scans_;
+    QColor scan_color_ = QColor(255, 48, 48);
+    bool scan_dirty_ = false;
+    QSGGeometryNode *scan_node_ = nullptr;
+
+    bool has_robot_ = false;
+    QPointF robot_position_;
+    double robot_yaw_ = 0.0;
+    bool robot_dirty_ = false;
+    QSGGeometryNode *robot_node_ = nullptr;
+
+    double marker_scale_ = 0.0;         // scale_ the dot / robot sizes were built for
+
+    double scale_ = 20.0;           // px / m
+    QPointF center_;
+    bool user_moved_ = false;       // auto fit until the first pan / zoom
+    QPointF drag_last_;
+};
+}
+
+#endif
@@ -18,8 +18,81 @@
 #include <QtCharts>
 #include <QtMath>
 
+#include "decimation.hpp"
+#include "romChartView.hpp"
+
 namespace rom_dynamics::ui::qt {
 
+// Fixed capacity trail of chart points. push() is O(1) and never allocates once full;
+// written() counts every push so a consumer can tell how many points arrived since it last looked.
+class RomPointRing {
+public:
+    explicit RomPointRing(int capacity = 1) { setCapacity(capacity); }
+
+    void setCapacity(int capacity)
+    {
+        buffer_ = QList<QPointF>(qMax(1, capacity));
+        head_ = 0; size_ = 0; written_ = 0;
+    }
+    void clear() { head_ = 0; size_ = 0; }
+
+    void push(const QPointF &p)
+    {
+        buffer_[head_] = p;
+        head_ = (head_ + 1) % buffer_.size();
+        if (size_ < buffer_.size()) ++size_;
+        ++written_;
+    }
+
+    int size() const { return size_; }
+    int capacity() const { return buffer_.size(); }
+    bool isEmpty() const { return size_ == 0; }
+    quint64 written() const { return written_; }
+
+    // i = 0 is the oldest point still in the ring
+    const QPointF &at(int i) const { return buffer_[(head_ - size_ + i + buffer_.size()) % buffer_.size()]; }
+
+    // newest `count` points, oldest first
+    QList<QPointF> last(int count) const
+    {
+        count = qMin(count, size_);
+        QList<QPointF> out;
+        out.reserve(count);
+        for (int i = size_ - count; i < size_; ++i) out.append(at(i));
+        return out;
+    }
+    QList<QPointF> toList() const { return last(size_); }
+
+private:
+    QList<QPointF> buffer_;
+    int head_ = 0;
+    int size_ = 0;
+    quint64 written_ = 0;
+};
+
+// Keeps a line series equal to a RomPointRing with one append / removePoints per frame
+// instead of clear + re-append per sample.
+struct RomRingSeriesSync {
+    quint64 synced = 0;     // ring.written() at the last sync
+
+    void sync(const RomPointRing &ring, QXYSeries *series)
+    {
+        const quint64 fresh = ring.written() - synced;
+        synced = ring.written();
+        if (fresh == 0) return;
+
+        if (fresh >= quint64(ring.size()) || series->count() + int(fresh) < ring.size())
+        {
+            series->replace(ring.toList());     // first fill or more than a whole ring behind
+            return;
+        }
+
+        series->append(ring.last(int(fresh)));
+        const int overflow = series->count() - ring.size();
+        if (overflow > 0) series->removePoints(0, overflow);
+    }
+};
+
 class RobotVelocityGraph : public QWidget {
     Q_OBJECT
 
@@ -88,32 +161,71 @@ public:
         axisY_->setTickCount(9);
 
         QVBoxLayout* layout = new QVBoxLayout(this);
-        QChartView* chartView = new QChartView(chart_);
-        chartView->setRenderHint(QPainter::Antialiasing);
-        layout->addWidget(chartView);
+        chartView_ = new RomChartView(chart_);
+        chartView_->setRubberBand(QChartView::HorizontalRubberBand); // drag to zoom, right click to zoom out
+        layout->addWidget(chartView_);
         setLayout(layout);
         setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+        // zoom -> decimate the visible slice at full plot width
+        connect(axisX_, &QValueAxis::rangeChanged, this, [this](qreal min, qreal max) {
+            if (settingRange_) return;
+            if (min <= firstX() && max >= lastX()) lod_.clearViewRange();
+            else lod_.setViewRange(min, max);
+            series_->replace(lod_.points());
+        });
+
+        frameTimer_.setSingleShot(true);
+        frameTimer_.setInterval(16);
+        connect(&frameTimer_, &QTimer::timeout, this, &RobotVelocityGraph::refresh);
     }
 
+    // whole history at once ( x = sample index )
     void updateGraph(const QVector<double>& velocities)
     {
-        series_->clear();
+        lod_.clear();
+        for (int i = 0; i < velocities.size(); ++i) lod_.append(QPointF(i, velocities[i]));
+        samples_ = velocities.size();
+        refresh();
+    }
 
-        if (velocities.isEmpty()) 
+    // streaming, one sample at a time; redrawn at most once per frame
+    void appendVelocity(double velocity)
+    {
+        // not lod_.size() : it shrinks when the lod drops its oldest half, x must keep growing
+        lod_.append(QPointF(double(samples_++), velocity));
+        if (!frameTimer_.isActive()) frameTimer_.start();
+    }
+
+    void refresh()
+    {
+        // full history stays in lod_, the series only gets ~2 points per pixel
+        lod_.setPixelWidth(int(chart_->plotArea().width()));
+        const QList<QPointF> points = lod_.points();
+        series_->replace(points);
+
+        if (points.isEmpty()) 
         {
+            settingRange_ = true;
             axisX_->setRange(0, 1);
+            settingRange_ = false;
             axisY_->setRange(0, 1);
             return;
         }
-        double vMin = velocities[0];
-        double vMax = velocities[0];
-        for (int i = 0; i < velocities.size(); ++i) {
-            double v = velocities[i];
-            if (v < vMin) vMin = v;
-            if (v > vMax) vMax = v;
-            series_->append(i, v);
+
+        // min / max buckets keep every extreme, so the decimated points give the exact y range
+        double vMin = points[0].y();
+        double vMax = points[0].y();
+        for (const QPointF &p : points) {
+            if (p.y() < vMin) vMin = p.y();
+            if (p.y() > vMax) vMax = p.y();
+        }
+        if (!lod_.hasViewRange())
+        {
+            settingRange_ = true;
+            axisX_->setRange(firstX(), qMax(firstX() + 1.0, lastX()));
+            settingRange_ = false;
         }
-        axisX_->setRange(0, velocities.size() > 1 ? velocities.size()-1 : 1);
 
         // If all values identical, expand a small band
         if (qFuzzyCompare(vMin, vMax)) {
@@ -138,9 +250,19 @@ public:
 
 private:
     QChart *chart_ = nullptr;
+    RomChartView *chartView_ = nullptr;
     QLineSeries *series_ = nullptr;
     QValueAxis *axisX_ = nullptr;
     QValueAxis *axisY_ = nullptr;
+
+    // x range of the samples the lod still holds
+    double firstX() const { return lod_.full().isEmpty() ? 0.0 : lod_.full().first().x(); }
+    double lastX() const { return lod_.full().isEmpty() ? 1.0 : lod_.full().last().x(); }
+
+    RomMinMaxLod lod_;
+    qint64 samples_ = 0;            // x of the next streamed sample
+    QTimer frameTimer_;
+    bool settingRange_ = false;     // our own axis updates are not a zoom
 };
 
 
@@ -148,11 +270,21 @@ class RomPositionGraph : public QWidget {
     Q_OBJECT
 
 public:
-    const int MAX_POINTS = 20;
+    static constexpr int MAX_POINTS = 20000;   // overlay trail length
+    static constexpr int MARKER_POINTS = 20;   // newest points also drawn as markers
+    static constexpr int FRAME_MS = 16;
+
     RomPositionGraph(QWidget *parent = nullptr)
         : QWidget(parent)
+        , odomPositions_(MARKER_POINTS)
+        , diffOdomPositions_(MARKER_POINTS)
     {
         setStyleSheet("background-color: rgba(255,255,255,0);");
+
+        // samples arriving within one frame are drawn together
+        frameTimer_.setSingleShot(true);
+        frameTimer_.setInterval(FRAME_MS);
+        connect(&frameTimer_, &QTimer::timeout, this, &RomPositionGraph::flushSeries);
         
         chart_ = new QChart();
 
@@ -239,16 +371,15 @@ public:
         axisY_->setTickCount(11);
 
         QVBoxLayout* layout = new QVBoxLayout(this);
-        QChartView* chartView = new QChartView(chart_);
-        chartView->setRenderHint(QPainter::Antialiasing);
+        chartView_ = new RomChartView(chart_);
 
         // NEW: Set QChartView size constraint for a square aspect ratio
         // This tells the layout to try and keep the chart square.
-        chartView->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
-        chartView->setMinimumSize(300, 300); // Give a starting square size
-        chartView->setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+        chartView_->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+        chartView_->setMinimumSize(300, 300); // Give a starting square size
+        chartView_->setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
 
-        layout->addWidget(chartView);
+        layout->addWidget(chartView_);
         setLayout(layout);
         setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     }
@@ -259,137 +390,157 @@ void updateGraph(const QPointF& my_odomPosition, const QPointF& my_diffOdomPosit
     QPointF odomPosition(-1.0 * my_odomPosition.y(), my_odomPosition.x());
     QPointF diffOdomPosition(-1.0 * my_diffOdomPosition.y(), my_diffOdomPosition.x());
 
-    // 1. Sliding Window Logic for BOTH Paths
-    if (odomPositions_.size() >= MAX_POINTS) {
-        odomPositions_.removeFirst();
-        diffOdomPositions_.removeFirst(); // Keep both lists synchronized
-    }
-    odomPositions_.append(odomPosition);
-    diffOdomPositions_.append(diffOdomPosition);
-
-    // 2. Clear and Redraw ALL Series
-    odomSeries_->clear();
-    odomScatterSeries_->clear();
-    diffOdomSeries_->clear();
-    diffOdomScatterSeries_->clear();
-
-    if (odomPositions_.isEmpty())
-    {
-        // Reset axes if no data
-        axisX_->setRange(-1, 1);
-        axisY_->setRange(-1, 1);
-        axisX_->setTickCount(5);
-        axisY_->setTickCount(5);
-        return;
-    }
+    // 1. O(1) amortized per sample : full history + markers, the series follow once per frame ( flushSeries )
+    odomLod_.append(odomPosition);
+    diffOdomLod_.append(diffOdomPosition);
+    odomPositions_.push(odomPosition);
+    diffOdomPositions_.push(diffOdomPosition);
+    if (!frameTimer_.isActive()) frameTimer_.start();
 
-    // 3. Auto-calculate Axes Range based on ALL points
-    static double minX = std::numeric_limits<double>::max();
-    static double maxX = std::numeric_limits<double>::lowest();
-    static double minY = std::numeric_limits<double>::max();
-    static double maxY = std::numeric_limits<double>::lowest();
-
-    // Combine Odom and Diff Odom points for Auto-Scaling
-    auto updateMinMax = [&](const QPointF& p) {
-        minX = qMin(minX, p.x());
-        maxX = qMax(maxX, p.x());
-        minY = qMin(minY, p.y());
-        maxY = qMax(maxY, p.y());
-    };
-
-    // if(odomPosition.x() > maxX || odomPosition.x() < minX || odomPosition.y() > maxY || odomPosition.y() < minY)
-    // {
-    //     updateMinMax(odomPosition);
-    // }
+    // 2. Auto-calculate Axes Range : only the bounds here, the axes follow once per frame ( flushSeries )
     double shift_offset = 0.05; 
-    if(odomPosition.x() > maxX )
+    if(odomPosition.x() > maxX_ )
     {
-        minX += shift_offset; maxX += shift_offset;
+        minX_ += shift_offset; maxX_ += shift_offset;
     }
-    if(odomPosition.x() < minX )
+    if(odomPosition.x() < minX_ )
     {
-        minX -= shift_offset; maxX -= shift_offset;
+        minX_ -= shift_offset; maxX_ -= shift_offset;
     }
-    if(odomPosition.y() > maxY )
+    if(odomPosition.y() > maxY_ )
     {
-        minY += shift_offset; maxY += shift_offset;
+        minY_ += shift_offset; maxY_ += shift_offset;
     }
-    if(odomPosition.y() < minY )
+    if(odomPosition.y() < minY_ )
     {
-        minY -= shift_offset; maxY -= shift_offset;
+        minY_ -= shift_offset; maxY_ -= shift_offset;
     }
     if(first_time_update_)
     {
         first_time_update_ = false;
-        updateMinMax(odomPosition);
-        //updateMinMax(diffOdomPosition);
+        minX_ = qMin(minX_, odomPosition.x());
+        maxX_ = qMax(maxX_, odomPosition.x());
+        minY_ = qMin(minY_, odomPosition.y());
+        maxY_ = qMax(maxY_, odomPosition.y());
     }
+}
 
-    // for (const auto& p : odomPositions_) {
-    //     updateMinMax(p);
-    // }
-    // for (const auto& p : diffOdomPositions_) {
-    //     updateMinMax(p);
-    // }
-    
-    // Add Padding to the calculated range (e.g., 5% of the range or a fixed small value)
-    const double padding = 0.1; // 0.1 meter padding for better visualization
-    
-    // Handle case where only one point exists (range is zero)
-    double rangeX = maxX - minX;
-    double rangeY = maxY - minY;
-    
-    if (rangeX < 0.1) rangeX = 0.2; // Ensure min range is not too small
-    if (rangeY < 0.1) rangeY = 0.2;
-    
-    double padX = rangeX * 0.05 + padding; // 5% of range + 0.1m fixed pad
-    double padY = rangeY * 0.05 + padding;
-    
-    // Apply the new ranges with padding
-    axisX_->setRange(minX - padX, maxX + padX);
-    axisY_->setRange(minY - padY, maxY + padY);
-
-    // 4. Populate ALL Series (Loop)
-    for (int i = 0; i < odomPositions_.size(); ++i) {
-        // Odom Path
-        odomSeries_->append(odomPositions_[i]);
-        odomScatterSeries_->append(odomPositions_[i]);
-        
-        // Diff Odom Path
-        diffOdomSeries_->append(diffOdomPositions_[i]);
-        diffOdomScatterSeries_->append(diffOdomPositions_[i]);
+    // other robots ( RobotSessionPool ), one thin line each on the same axes
+    void updateOverlay(const QString &key, const QPointF &my_position, const QColor &color)
+    {
+        Overlay &overlay = overlays_[key];
+        if (!overlay.series)
+        {
+            overlay.positions.setCapacity(MAX_POINTS);
+            overlay.series = new QLineSeries();
+            overlay.series->setName(key);
+            overlay.series->setPen(QPen(color, 1, Qt::DashLine));
+            chart_->addSeries(overlay.series);
+            overlay.series->attachAxis(axisX_);
+            overlay.series->attachAxis(axisY_);
+            chartView_->applyBackend();
+        }
+
+        overlay.positions.push(QPointF(-1.0 * my_position.y(), my_position.x()));
+        if (!frameTimer_.isActive()) frameTimer_.start();
     }
 
-    // 5. Set Tick Count
-    // Use an appropriate tick count based on the dynamic range (e.g., 10 ticks per meter)
-    int numTicksX = qRound((maxX - minX) / 0.1); 
-    int numTicksY = qRound((maxY - minY) / 0.1); 
-    
-    // Ensure minimum 5 ticks and maximum 20 ticks
-    axisX_->setTickCount(qBound(5, numTicksX, 20)); 
-    axisY_->setTickCount(qBound(5, numTicksY, 20));
-}
+    void removeOverlay(const QString &key)
+    {
+        auto it = overlays_.find(key);
+        if (it == overlays_.end()) return;
+        chart_->removeSeries(it->series);
+        delete it->series;
+        overlays_.erase(it);
+    }
 
     // Destructor
     virtual ~RomPositionGraph() {}
 
 private:
+    void flushSeries()
+    {
+        // whole run, decimated to ~2 points per pixel of plot width
+        const int px = int(chart_->plotArea().width());
+        odomLod_.setPixelWidth(px);
+        diffOdomLod_.setPixelWidth(px);
+        odomSeries_->replace(odomLod_.points());
+        diffOdomSeries_->replace(diffOdomLod_.points());
+
+        // markers stay short, replace() of MARKER_POINTS is constant cost
+        odomScatterSeries_->replace(odomPositions_.last(MARKER_POINTS));
+        diffOdomScatterSeries_->replace(diffOdomPositions_.last(MARKER_POINTS));
+
+        for (Overlay &overlay : overlays_)
+        {
+            overlay.sync.sync(overlay.positions, overlay.series);
+        }
+
+        if (!first_time_update_) updateAxes();
+    }
+
+    void updateAxes()
+    {
+        // Add Padding to the calculated range (e.g., 5% of the range or a fixed small value)
+        const double padding = 0.1; // 0.1 meter padding for better visualization
+
+        // Handle case where only one point exists (range is zero)
+        double rangeX = maxX_ - minX_;
+        double rangeY = maxY_ - minY_;
+
+        if (rangeX < 0.1) rangeX = 0.2; // Ensure min range is not too small
+        if (rangeY < 0.1) rangeY = 0.2;
+
+        double padX = rangeX * 0.05 + padding; // 5% of range + 0.1m fixed pad
+        double padY = rangeY * 0.05 + padding;
+
+        // Apply the new ranges with padding
+        axisX_->setRange(minX_ - padX, maxX_ + padX);
+        axisY_->setRange(minY_ - padY, maxY_ + padY);
+
+        // 3. Set Tick Count
+        // Use an appropriate tick count based on the dynamic range (e.g., 10 ticks per meter)
+        int numTicksX = qRound((maxX_ - minX_) / 0.1);
+        int numTicksY = qRound((maxY_ - minY_) / 0.1);
+
+        // Ensure minimum 5 ticks and maximum 20 ticks
+        axisX_->setTickCount(qBound(5, numTicksX, 20));
+        axisY_->setTickCount(qBound(5, numTicksY, 20));
+    }
+
+    struct Overlay {
+        QLineSeries *series = nullptr;
+        RomPointRing positions;
+        RomRingSeriesSync sync;
+    };
+
     QChart *chart_ = nullptr;
+    QHash<QString, Overlay> overlays_;
 
     // Odom Path (Series 1)
     QLineSeries *odomSeries_ = nullptr; 
     QScatterSeries *odomScatterSeries_ = nullptr;
-    QList<QPointF> odomPositions_; 
+    RomLttbLod odomLod_;
+    RomPointRing odomPositions_;    // markers
     
     // Diff Odom Path (Series 2)
     QLineSeries *diffOdomSeries_ = nullptr;
     QScatterSeries *diffOdomScatterSeries_ = nullptr;
-    QList<QPointF> diffOdomPositions_; 
+    RomLttbLod diffOdomLod_;
+    RomPointRing diffOdomPositions_;
     
     QValueAxis *axisX_ = nullptr;
     QValueAxis *axisY_ = nullptr;
+    RomChartView *chartView_ = nullptr;
+
+    // odom bounds the axes follow, per graph
+    double minX_ = std::numeric_limits<double>::max();
+    double maxX_ = std::numeric_limits<double>::lowest();
+    double minY_ = std::numeric_limits<double>::max();
+    double maxY_ = std::numeric_limits<double>::lowest();
 
     bool first_time_update_ = true;
+    QTimer frameTimer_;
     
 };
 
@@ -520,8 +671,7 @@ public:
 
         // --- 4. Layout ---
         QVBoxLayout* layout = new QVBoxLayout(this);
-        QChartView* chartView = new QChartView(chart_);
-        chartView->setRenderHint(QPainter::Antialiasing);
+        QChartView* chartView = new RomChartView(chart_);   // polar : always the raster path
         chartView->setRenderHint(QPainter::SmoothPixmapTransform);
         chartView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
         
@@ -0,0 +1,119 @@
+#ifndef ROM_SCAN_LAYER_HPP
+#define ROM_SCAN_LAYER_HPP
+
+#pragma once
+
+#include <QList>
+#include <QVector>
+#include <QPointF>
+#include <QtMath>
+#include <cmath>
+
+namespace rom_dynamics::ui::qt {
+
+// sensor_msgs/LaserScan ranges -> world points.
+// cos / sin per beam are computed once per scan layout ( angle_min, increment, count );
+// each scan is then one branch-free multiply-add loop over the ranges ( vectorizes )
+// plus one pass that drops the out of range beams.
+class RomScanProjector {
+public:
+    // pose of the laser in the world ( m, rad ); returns the valid beams, reused by the next call
+    const QVector<QPointF> &project(const double *ranges, int count, double angle_min, double angle_increment,
+                                    double range_min, double range_max, double pose_x, double pose_y, double pose_yaw)
+    {
+        if (count != cos_.size() || angle_min != angle_min_ || angle_increment != angle_increment_)
+        {
+            rebuildTable(count, angle_min, angle_increment);
+        }
+
+        xs_.resize(count);
+        ys_.resize(count);
+        const double c = std::cos(pose_yaw);
+        const double s = std::sin(pose_yaw);
+        const double *cos_t = cos_.constData();
+        const double *sin_t = sin_.constData();
+        double *xs = xs_.data();
+        double *ys = ys_.data();
+        for (int i = 0; i < count; ++i)
+        {
+            const double lx = ranges[i] * cos_t[i];
+            const double ly = ranges[i] * sin_t[i];
+            xs[i] = pose_x + c * lx - s * ly;
+            ys[i] = pose_y + s * lx + c * ly;
+        }
+
+        // inf / NaN / null ( rosbridge writes inf as null -> 0 ) fail the range test
+        points_.resize(count);
+        QPointF *out = points_.data();
+        int n = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            if (ranges[i] >= range_min && ranges[i] <= range_max) out[n++] = QPointF(xs[i], ys[i]);
+        }
+        points_.resize(n);
+        return points_;
+    }
+
+private:
+    void rebuildTable(int count, double angle_min, double angle_increment)
+    {
+        angle_min_ = angle_min;
+        angle_increment_ = angle_increment;
+        cos_.resize(count);
+        sin_.resize(count);
+        for (int i = 0; i < count; ++i)
+        {
+            const double a = angle_min + i * angle_increment;
+            cos_[i] = std::cos(a);
+            sin_[i] = std::sin(a);
+        }
+    }
+
+    double angle_min_ = 0.0;
+    double angle_increment_ = 0.0;
+    QVector<double> cos_;
+    QVector<double> sin_;
+    QVector<double> xs_;
+    QVector<double> ys_;
+    QVector<QPointF> points_;
+};
+
+// Last few projected scans, newest first, fixed number of slots.
+class RomScanHistory {
+public:
+    explicit RomScanHistory(int depth = 5) { setDepth(depth); }
+
+    void setDepth(int depth)
+    {
+        scans_ = QList<QVector<QPointF>>(qMax(1, depth));
+        head_ = 0; size_ = 0;
+    }
+    void clear() { head_ = 0; size_ = 0; }
+
+    void push(const QVector<QPointF> &points)
+    {
+        head_ = (head_ + scans_.size() - 1) % scans_.size();
+        scans_[head_] = points;
+        if (size_ < scans_.size()) ++size_;
+    }
+
+    int depth() const { return scans_.size(); }
+    int size() const { return size_; }
+    // age 0 = newest
+    const QVector<QPointF> &at(int age) const { return scans_[(head_ + age) % scans_.size()]; }
+
+    int totalPoints() const
+    {
+        int n = 0;
+        for (int age = 0; age < size_; ++age) n += at(age).size();
+        return n;
+    }
+
+private:
+    QList<QVector<QPointF>> scans_;
+    int head_ = 0;
+    int size_ = 0;
+};
+}
+
+#endif
@@ -0,0 +1,271 @@
+#include "topicMonitor.hpp"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QSignalBlocker>
+#include <QSet>
+#include <algorithm>
+
+using namespace rom_dynamics::ui::qt;
+using rom_dynamics::communication::ServiceResult;
+
+//================================================================================
+// 1. RomTopicMonitor
+//================================================================================
+
+rom_dynamics::ui::qt::RomTopicMonitor::RomTopicMonitor(QWidget *parent)
+    : QWidget(parent)
+{
+    const QString btnStyle = "QPushButton { color: #c3c9d4; border-radius: 4px; border: 1px solid #c3c9d4; padding: 2px 10px; }"
+                             "QPushButton:hover { color: white; border: 1px solid orange; }";
+    const QString editStyle = "color: #c3c9d4; font: 11px; border: 1px solid #555; border-radius: 3px;";
+
+    refreshBtn_ = new QPushButton("Topics", this);
+    refreshBtn_->setStyleSheet(btnStyle);
+    connect(refreshBtn_, &QPushButton::clicked, this, &RomTopicMonitor::refreshTopics);
+
+    resetBtn_ = new QPushButton("Reset", this);
+    resetBtn_->setStyleSheet(btnStyle);
+    connect(resetBtn_, &QPushButton::clicked, this, &RomTopicMonitor::resetStats);
+
+    filterEdit_ = new QLineEdit(this);
+    filterEdit_->setPlaceholderText("filter");
+    filterEdit_->setStyleSheet(editStyle);
+    connect(filterEdit_, &QLineEdit::textChanged, this, &RomTopicMonitor::applyFilter);
+
+    QHBoxLayout *top = new QHBoxLayout();
+    top->addWidget(refreshBtn_);
+    top->addWidget(resetBtn_);
+    top->addWidget(filterEdit_, 1);
+
+    table_ = new QTableWidget(0, COLUMN_COUNT, this);
+    table_->setHorizontalHeaderLabels({ "topic", "type", "Hz", "jitter ms", "p99 dt ms", "size", "bandwidth" });
+    table_->verticalHeader()->setVisible(false);
+    table_->verticalHeader()->setDefaultSectionSize(18);
+    table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    table_->horizontalHeader()->setStretchLastSection(true);
+    table_->setColumnWidth(Topic, 210);
+    table_->setColumnWidth(Type, 170);
+    for (int c = Rate; c < Bandwidth; ++c) table_->setColumnWidth(c, 66);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setSelectionMode(QAbstractItemView::NoSelection);
+    table_->setStyleSheet("QTableWidget { color: #c3c9d4; font: 10px; border: 1px solid #444; gridline-color: #3a3a3a; }"
+                          "QHeaderView::section { color: #bdb7b7; background: #2e2e2e; border: 0px; font: 10px; }");
+    connect(table_, &QTableWidget::itemChanged, this, &RomTopicMonitor::onItemChanged);
+    connect(table_, &QTableWidget::cellDoubleClicked, this, [this](int row, int) {
+        const QTableWidgetItem *item = table_->item(row, Topic);
+        if (!item) return;
+        auto it = topics_.constFind(item->text());
+        if (it != topics_.constEnd()) emit inspectRequested(it.key(), it->type);
+    });
+
+    status_ = new QLabel("Topics : list the topics of the robot, check the ones to measure, double click one to inspect", this);
+    status_->setStyleSheet("color: #03fc84; font: 10px;");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->addLayout(top);
+    layout->addWidget(table_, 1);
+    layout->addWidget(status_);
+    setLayout(layout);
+
+    clock_.start();
+    statsTimer_.setInterval(STATS_MS);
+    connect(&statsTimer_, &QTimer::timeout, this, &RomTopicMonitor::updateRows);
+    statsTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::setServiceCaller(rom_dynamics::communication::ServiceCaller *caller)
+{
+    caller_ = caller;
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::refreshTopics()
+{
+    if (!caller_)
+    {
+        status_->setText("not connected");
+        return;
+    }
+    status_->setText("/rosapi/topics ...");
+
+    QPointer<RomTopicMonitor> self(this);
+    caller_->call("/rosapi/topics", QJsonObject(), [self](const ServiceResult &result) {
+        if (!self) return;
+        if (!result.ok)
+        {
+            self->status_->setText(QString("/rosapi/topics : %1").arg(result.error));
+            return;
+        }
+
+        const QJsonArray topics = result.values.value("topics").toArray();
+        const QJsonArray types = result.values.value("types").toArray();
+
+        // topics that disappeared go unless they are still being measured
+        QSet<QString> listed;
+        for (int i = 0; i < topics.size(); ++i)
+        {
+            const QString topic = topics[i].toString();
+            if (topic.isEmpty()) continue;
+            listed.insert(topic);
+            Entry &entry = self->topics_[topic];
+            entry.type = i < types.size() ? types[i].toString() : QString();
+        }
+        for (auto it = self->topics_.begin(); it != self->topics_.end();)
+        {
+            if (!listed.contains(it.key()) && !it->monitored) it = self->topics_.erase(it);
+            else ++it;
+        }
+
+        self->rebuildRows();
+        self->status_->setText(QString("%1 topics  ( %2 ms )").arg(self->topics_.size()).arg(result.rtt_ms));
+    });
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::onFrame(const QString &topic, int bytes)
+{
+    auto it = topics_.find(topic);
+    if (it == topics_.end() || !it->monitored) return;
+    it->stats.add(clock_.nsecsElapsed() / 1000, bytes);
+}
+
+bool rom_dynamics::ui::qt::RomTopicMonitor::isMonitored(const QString &topic) const
+{
+    auto it = topics_.constFind(topic);
+    return it != topics_.constEnd() && it->monitored;
+}
+
+QList<QPair<QString, QString>> rom_dynamics::ui::qt::RomTopicMonitor::monitored() const
+{
+    QList<QPair<QString, QString>> out;
+    for (auto it = topics_.constBegin(); it != topics_.constEnd(); ++it)
+    {
+        if (it->monitored) out.append({ it.key(), it->type });
+    }
+    return out;
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::resetStats()
+{
+    for (Entry &entry : topics_) entry.stats.reset();
+    updateRows();
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::rebuildRows()
+{
+    rebuilding_ = true;
+    const QSignalBlocker blocker(table_);
+
+    QStringList names = topics_.keys();
+    std::sort(names.begin(), names.end());
+
+    table_->setRowCount(names.size());
+    for (int row = 0; row < names.size(); ++row)
+    {
+        Entry &entry = topics_[names[row]];
+        entry.row = row;
+
+        QTableWidgetItem *name = new QTableWidgetItem(names[row]);
+        name->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+        name->setCheckState(entry.monitored ? Qt::Checked : Qt::Unchecked);
+        table_->setItem(row, Topic, name);
+
+        QTableWidgetItem *type = new QTableWidgetItem(entry.type);
+        type->setFlags(Qt::ItemIsEnabled);
+        table_->setItem(row, Type, type);
+
+        for (int c = Rate; c < COLUMN_COUNT; ++c)
+        {
+            QTableWidgetItem *value = new QTableWidgetItem();
+            value->setFlags(Qt::ItemIsEnabled);
+            value->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            table_->setItem(row, c, value);
+        }
+    }
+
+    rebuilding_ = false;
+    applyFilter();
+    updateRows();
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::updateRows()
+{
+    const qint64 now_ms = clock_.elapsed();
+    const qint64 now_us = clock_.nsecsElapsed() / 1000;
+    const bool decay = now_ms - lastDecayMs_ >= DECAY_MS;
+    if (decay) lastDecayMs_ = now_ms;
+
+    int monitored = 0;
+    double total_rate = 0.0;
+    double total_bw = 0.0;
+
+    const QSignalBlocker blocker(table_);
+    for (auto it = topics_.begin(); it != topics_.end(); ++it)
+    {
+        Entry &entry = it.value();
+        if (!entry.monitored || entry.row < 0) continue;
+        ++monitored;
+
+        RomTopicStats &stats = entry.stats;
+        const double rate = stats.rateHz(now_us);
+        const double bw = stats.bandwidth(now_us);
+        total_rate += rate;
+        total_bw += bw;
+
+        const bool has_dt = stats.count >= 2;
+        table_->item(entry.row, Rate)->setText(has_dt ? QString::number(rate, 'f', rate < 10.0 ? 2 : 1) : "-");
+        table_->item(entry.row, Jitter)->setText(has_dt ? QString::number(stats.jitterUs() / 1000.0, 'f', 2) : "-");
+        table_->item(entry.row, P99)->setText(has_dt ? QString::number(stats.dt_hist.quantile(0.99) / 1000.0, 'f', 1) : "-");
+        table_->item(entry.row, Size)->setText(stats.count ? bytesText(stats.size_mean) : "-");
+        table_->item(entry.row, Bandwidth)->setText(has_dt ? bytesText(bw) + "/s" : "-");
+
+        if (decay) stats.dt_hist.decay();
+    }
+
+    if (monitored > 0)
+    {
+        status_->setText(QString("%1 topics, %2 measured  |  %3 msg/s  %4/s  ( arrival at this client )")
+                         .arg(topics_.size()).arg(monitored)
+                         .arg(total_rate, 0, 'f', 1).arg(bytesText(total_bw)));
+    }
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::applyFilter()
+{
+    const QString filter = filterEdit_->text().trimmed();
+    for (auto it = topics_.constBegin(); it != topics_.constEnd(); ++it)
+    {
+        if (it->row < 0) continue;
+        const bool show = filter.isEmpty() || it->monitored
+                          || it.key().contains(filter, Qt::CaseInsensitive)
+                          || it->type.contains(filter, Qt::CaseInsensitive);
+        table_->setRowHidden(it->row, !show);
+    }
+}
+
+void rom_dynamics::ui::qt::RomTopicMonitor::onItemChanged(QTableWidgetItem *item)
+{
+    if (rebuilding_ || !item || item->column() != Topic) return;
+
+    auto it = topics_.find(item->text());
+    if (it == topics_.end()) return;
+
+    const bool on = item->checkState() == Qt::Checked;
+    if (on == it->monitored) return;
+
+    it->monitored = on;
+    it->stats.reset();
+
+    const QSignalBlocker blocker(table_);
+    for (int c = Rate; c < COLUMN_COUNT; ++c) table_->item(it->row, c)->setText(QString());
+
+    emit monitorToggled(it.key(), it->type, on);
+}
+
+QString rom_dynamics::ui::qt::RomTopicMonitor::bytesText(double bytes)
+{
+    if (bytes < 1024.0) return QString("%1 B").arg(bytes, 0, 'f', 0);
+    if (bytes < 1024.0 * 1024.0) return QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+    return QString("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 2);
+}
@@ -0,0 +1,89 @@
+#ifndef ROM_TOPIC_MONITOR_HPP
+#define ROM_TOPIC_MONITOR_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QTableWidget>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+#include <QPair>
+#include "topicStats.hpp"
+#include "../communication/service_caller.hpp"
+
+namespace rom_dynamics::ui::qt {
+
+// Topic inventory ( /rosapi/topics ) with ros2 topic hz / bw style numbers for every
+// checked topic. Nothing is buffered : each frame updates the topic's RomTopicStats
+// and the table text is refreshed every STATS_MS. Sizes are rosbridge frame bytes
+// ( JSON ), not the CDR size on the ROS side.
+class RomTopicMonitor : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int STATS_MS = 500;
+    static constexpr int DECAY_MS = 10000;   // percentile histograms halve this often
+
+    enum Column { Topic, Type, Rate, Jitter, P99, Size, Bandwidth, COLUMN_COUNT };
+
+    explicit RomTopicMonitor(QWidget *parent = nullptr);
+    ~RomTopicMonitor() override = default;
+
+    void setServiceCaller(rom_dynamics::communication::ServiceCaller *caller);
+
+    // /rosapi/topics, keeps the statistics of topics that are still there
+    void refreshTopics();
+
+    // one received frame of a monitored topic
+    void onFrame(const QString &topic, int bytes);
+    bool isMonitored(const QString &topic) const;
+    QString typeOf(const QString &topic) const { return topics_.value(topic).type; }
+
+    // ( topic, type ) of every checked topic
+    QList<QPair<QString, QString>> monitored() const;
+
+    void resetStats();
+
+signals:
+    void monitorToggled(const QString &topic, const QString &type, bool on);
+    void inspectRequested(const QString &topic, const QString &type);
+
+private:
+    struct Entry {
+        QString type;
+        int row = -1;
+        bool monitored = false;
+        RomTopicStats stats;
+    };
+
+    void rebuildRows();
+    void updateRows();
+    void applyFilter();
+    void onItemChanged(QTableWidgetItem *item);
+
+    static QString bytesText(double bytes);
+
+    QPointer<rom_dynamics::communication::ServiceCaller> caller_;
+
+    QPushButton *refreshBtn_;
+    QPushButton *resetBtn_;
+    QLineEdit *filterEdit_;
+    QTableWidget *table_;
+    QLabel *status_;
+
+    QHash<QString, Entry> topics_;
+    QTimer statsTimer_;
+    QElapsedTimer clock_;
+    qint64 lastDecayMs_ = 0;
+    bool rebuilding_ = false;
+};
+
+}
+
+#endif // ROM_TOPIC_MONITOR_HPP
@@ -0,0 +1,152 @@
+#ifndef ROM_TOPIC_STATS_HPP
+#define ROM_TOPIC_STATS_HPP
+
+#pragma once
+
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <cmath>
+#include <climits>
+#include <cstring>
+
+namespace rom_dynamics::ui::qt {
+
+//================================================================================
+// 1. log bucketed histogram ( HDR style, 3 mantissa bits )
+//================================================================================
+// Values below SUB get their own bucket, above that every power of two is split
+// into SUB buckets, so a quantile is off by at most 1 / SUB of its value.
+// Fixed size, record() is a count leading zeros and an increment.
+class RomLogHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int MAX_EXP = 40;     // values are clamped to 2^40
+    static constexpr int BUCKETS = (MAX_EXP - SUB_BITS + 2) * SUB;
+
+    RomLogHistogram() { reset(); }
+
+    void reset()
+    {
+        std::memset(counts_, 0, sizeof(counts_));
+        total_ = 0;
+    }
+
+    void record(quint64 value)
+    {
+        const int index = bucketOf(value);
+        ++counts_[index];
+        ++total_;
+    }
+
+    // halves every count; called periodically so old samples fade out
+    void decay()
+    {
+        total_ = 0;
+        for (int i = 0; i < BUCKETS; ++i)
+        {
+            counts_[i] >>= 1;
+            total_ += counts_[i];
+        }
+    }
+
+    quint64 count() const { return total_; }
+
+    // q in [0, 1]; middle of the bucket that holds the q-th sample
+    double quantile(double q) const
+    {
+        if (total_ == 0) return 0.0;
+        const quint64 rank = quint64(qBound(0.0, q, 1.0) * double(total_ - 1)) + 1;
+        quint64 seen = 0;
+        for (int i = 0; i < BUCKETS; ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank) return bucketMid(i);
+        }
+        return bucketMid(BUCKETS - 1);
+    }
+
+    static int bucketOf(quint64 value)
+    {
+        if (value < quint64(SUB)) return int(value);
+        int e = 63 - qCountLeadingZeroBits(value);
+        if (e > MAX_EXP) { e = MAX_EXP; value = (quint64(2) << MAX_EXP) - 1; }
+        const int m = int(value >> (e - SUB_BITS)) & (SUB - 1);
+        return (e - SUB_BITS + 1) * SUB + m;
+    }
+
+    static double bucketMid(int index)
+    {
+        if (index < SUB) return double(index);
+        const int e = index / SUB + SUB_BITS - 1;
+        const int m = index % SUB;
+        const double width = std::ldexp(1.0, e - SUB_BITS);
+        return double(SUB + m) * width + width * 0.5;
+    }
+
+private:
+    quint32 counts_[BUCKETS];
+    quint64 total_ = 0;
+};
+
+//================================================================================
+// 2. per topic arrival statistics
+//================================================================================
+// Constant memory per topic : EWMA mean / variance of the inter-arrival time and of
+// the frame size, and a decaying histogram of the inter-arrival time for percentiles.
+// The first samples are plain averages ( weight 1 / n ) until n reaches 1 / ALPHA.
+// Times are microseconds of the monitor clock, i.e. arrival at this client.
+struct RomTopicStats {
+    static constexpr double ALPHA = 1.0 / 32.0;
+
+    quint64 count = 0;
+    quint64 bytes = 0;
+    qint64 last_us = -1;
+
+    double dt_mean = 0.0;       // us
+    double dt_var = 0.0;        // us^2
+    double size_mean = 0.0;     // bytes
+    int size_min = INT_MAX;
+    int size_max = 0;
+    RomLogHistogram dt_hist;
+
+    void add(qint64 t_us, int size)
+    {
+        ++count;
+        bytes += quint64(qMax(0, size));
+        size_mean += (double(size) - size_mean) * qMax(ALPHA, 1.0 / double(count));
+        size_min = qMin(size_min, size);
+        size_max = qMax(size_max, size);
+
+        if (last_us >= 0)
+        {
+            const double dt = double(qMax<qint64>(0, t_us - last_us));
+            const double a = qMax(ALPHA, 1.0 / double(count - 1));
+            const double diff = dt - dt_mean;
+            const double incr = a * diff;
+            dt_mean += incr;
+            dt_var = (1.0 - a) * (dt_var + diff * incr);
+            dt_hist.record(quint64(dt));
+        }
+        last_us = t_us;
+    }
+
+    void reset() { *this = RomTopicStats(); }
+
+    double jitterUs() const { return std::sqrt(qMax(0.0, dt_var)); }
+
+    // a topic that went quiet longer than it usually does decays towards 0 Hz
+    double rateHz(qint64 now_us) const
+    {
+        if (count < 2 || dt_mean <= 0.0) return 0.0;
+        const double gap = double(now_us - last_us);
+        const double dt = gap > dt_mean + 3.0 * jitterUs() ? gap : dt_mean;
+        return 1e6 / dt;
+    }
+
+    double bandwidth(qint64 now_us) const { return size_mean * rateHz(now_us); }
+};
+
+}
+
+#endif // ROM_TOPIC_STATS_HPP
@@ -0,0 +1,165 @@
+#include "trackingDisplay.hpp"
+#include <QVBoxLayout>
+#include <cmath>
+#include <limits>
+
+using namespace rom_dynamics::ui::qt;
+
+//================================================================================
+// 1. RomTrackingErrorGraph
+//================================================================================
+
+rom_dynamics::ui::qt::RomTrackingErrorGraph::RomTrackingErrorGraph(QWidget *parent)
+    : QWidget(parent)
+{
+    chart_ = new QChart();
+
+    QFont titleFont;
+    QColor titleColor("#03fc84");
+    titleFont.setFamily("SF Pro Text");
+    titleFont.setPointSize(10);
+    chart_->setTitle("Tracking Error");
+    chart_->setTitleBrush(QBrush(titleColor));
+    chart_->setTitleFont(titleFont);
+
+    chart_->setBackgroundBrush(Qt::NoBrush);
+    chart_->setPlotAreaBackgroundBrush(Qt::NoBrush);
+    chart_->setBackgroundRoundness(0);
+    chart_->setMargins(QMargins(4, 4, 4, 4));
+    chart_->legend()->setLabelColor(QColor(189, 183, 183));
+    chart_->legend()->setAlignment(Qt::AlignBottom);
+
+    axisX_ = new QValueAxis();
+    axisY_ = new QValueAxis();
+    axisX_->setTitleText("s");
+
+    QColor axisColor(189, 183, 183, 80);
+    axisX_->setGridLineColor(axisColor);
+    axisY_->setGridLineColor(axisColor);
+    axisX_->setLabelsColor(axisColor);
+    axisY_->setLabelsColor(axisColor);
+    axisX_->setTitleBrush(QBrush(axisColor));
+    axisX_->setLinePen(QPen(axisColor));
+    axisY_->setLinePen(QPen(axisColor));
+
+    QFont axisFont;
+    axisFont.setFamily("SF Pro Text");
+    axisFont.setPointSize(7);
+    axisX_->setLabelsFont(axisFont);
+    axisY_->setLabelsFont(axisFont);
+
+    axisX_->setRange(0, WINDOW_SEC);
+    axisY_->setRange(-0.5, 0.5);
+
+    chart_->addAxis(axisX_, Qt::AlignBottom);
+    chart_->addAxis(axisY_, Qt::AlignLeft);
+
+    const QPair<QString, QColor> plotted[CURVE_COUNT] = {
+        { "cross track m",  QColor(QColorConstants::Svg::orange) },
+        { "heading rad",    QColor("#00bfff") },
+        { "v err m/s",      QColor("#03fc84") },
+        { "w err rad/s",    QColor(180, 120, 255) },
+    };
+    for (int c = 0; c < CURVE_COUNT; ++c)
+    {
+        traces_[c].series = new QLineSeries();
+        traces_[c].series->setName(plotted[c].first);
+        traces_[c].series->setPen(QPen(plotted[c].second, 1.5));
+        chart_->addSeries(traces_[c].series);
+        traces_[c].series->attachAxis(axisX_);
+        traces_[c].series->attachAxis(axisY_);
+    }
+
+    chart_view_ = new RomChartView(chart_);
+
+    stats_ = new QLabel(this);
+    stats_->setStyleSheet("color: #bdb7b7; font-size: 10px;");
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(chart_view_, 1);
+    layout->addWidget(stats_);
+    setLayout(layout);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    frameTimer_.setSingleShot(true);
+    frameTimer_.setInterval(REFRESH_MS);
+    connect(&frameTimer_, &QTimer::timeout, this, &RomTrackingErrorGraph::refresh);
+}
+
+void rom_dynamics::ui::qt::RomTrackingErrorGraph::append(double t_sec, double cross_track, double heading, double linear, double angular)
+{
+    // stamps went back ( robot restarted, replay seek ) : start over
+    if (started_ && t_sec < last_t_) clear();
+    if (!started_) { t0_ = t_sec; started_ = true; }
+    last_t_ = t_sec;
+
+    const double values[CURVE_COUNT] = { cross_track, heading, linear, angular };
+    for (int c = 0; c < CURVE_COUNT; ++c)
+    {
+        if (std::isfinite(values[c])) traces_[c].ring.push(QPointF(t_sec - t0_, values[c]));
+    }
+
+    if (isVisible() && !frameTimer_.isActive()) frameTimer_.start();
+}
+
+void rom_dynamics::ui::qt::RomTrackingErrorGraph::clear()
+{
+    for (Trace &trace : traces_)
+    {
+        trace.ring.clear();
+        trace.sync = RomRingSeriesSync{};
+        trace.series->clear();
+    }
+    started_ = false;
+}
+
+void rom_dynamics::ui::qt::RomTrackingErrorGraph::setIndexStats(double query_us, int segments, int reinserted)
+{
+    index_text_ = QString("plan %1 seg  query %2 us  last replan %3 seg")
+                      .arg(segments).arg(query_us, 0, 'f', 2).arg(reinserted);
+}
+
+void rom_dynamics::ui::qt::RomTrackingErrorGraph::refresh()
+{
+    const double now = last_t_ - t0_;
+    const double from = now - WINDOW_SEC;
+
+    double y_min = std::numeric_limits<double>::max();
+    double y_max = std::numeric_limits<double>::lowest();
+    double rms[CURVE_COUNT] = {};
+    double peak[CURVE_COUNT] = {};
+
+    for (int c = 0; c < CURVE_COUNT; ++c)
+    {
+        Trace &trace = traces_[c];
+        trace.sync.sync(trace.ring, trace.series);
+
+        int n = 0;
+        for (int i = 0; i < trace.ring.size(); ++i)
+        {
+            const QPointF &p = trace.ring.at(i);
+            if (p.x() < from) continue;
+            y_min = qMin(y_min, p.y());
+            y_max = qMax(y_max, p.y());
+            rms[c] += p.y() * p.y();
+            peak[c] = qMax(peak[c], std::abs(p.y()));
+            ++n;
+        }
+        rms[c] = n > 0 ? std::sqrt(rms[c] / n) : 0.0;
+    }
+
+    axisX_->setRange(qMax(0.0, from), qMax(WINDOW_SEC, now));
+    if (y_min <= y_max)
+    {
+        const double pad = qMax(0.05, 0.1 * (y_max - y_min));
+        axisY_->setRange(y_min - pad, y_max + pad);
+    }
+
+    stats_->setText(QString("rms / max   xte %1 / %2 m   head %3 / %4 rad   v %5 / %6   w %7 / %8     %9")
+                        .arg(rms[CrossTrack], 0, 'f', 3).arg(peak[CrossTrack], 0, 'f', 3)
+                        .arg(rms[Heading], 0, 'f', 3).arg(peak[Heading], 0, 'f', 3)
+                        .arg(rms[Linear], 0, 'f', 3).arg(peak[Linear], 0, 'f', 3)
+                        .arg(rms[Angular], 0, 'f', 3).arg(peak[Angular], 0, 'f', 3)
+                        .arg(index_text_));
+}
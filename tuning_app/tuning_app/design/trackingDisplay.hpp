@@ -0,0 +1,67 @@
+#ifndef ROM_TRACKING_DISPLAY_HPP
+#define ROM_TRACKING_DISPLAY_HPP
+
+#pragma once
+
+#include <QWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QtCharts/QChart>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include "rom_design.hpp"
+#include "romChartView.hpp"
+#include "pathTracking.hpp"
+
+namespace rom_dynamics::ui::qt {
+
+// Controller tracking against /plan, one sample per odom message:
+// cross-track ( signed, m ), heading error ( rad ), cmd_vel - odom linear / angular velocity.
+// The last WINDOW_SEC are plotted, rms / max of the same window under the chart.
+class RomTrackingErrorGraph : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr double WINDOW_SEC = 30.0;
+    static constexpr int CAPACITY = 3000;       // 100 Hz odom over the window
+    static constexpr int REFRESH_MS = 33;
+
+    enum Curve { CrossTrack, Heading, Linear, Angular, CURVE_COUNT };
+
+    explicit RomTrackingErrorGraph(QWidget *parent = nullptr);
+    ~RomTrackingErrorGraph() override = default;
+
+    // nan = not available for this sample ( no plan, no recent cmd_vel )
+    void append(double t_sec, double cross_track, double heading, double linear, double angular);
+    void clear();
+
+    // shown on the stats line : nearest segment query cost and plan size
+    void setIndexStats(double query_us, int segments, int reinserted);
+
+private:
+    struct Trace {
+        RomPointRing ring{CAPACITY};
+        RomRingSeriesSync sync;
+        QLineSeries *series = nullptr;
+    };
+
+    void refresh();
+
+    RomChartView *chart_view_;
+    QChart *chart_;
+    QValueAxis *axisX_;
+    QValueAxis *axisY_;
+    QLabel *stats_;
+    Trace traces_[CURVE_COUNT];
+
+    double t0_ = 0.0;
+    double last_t_ = 0.0;
+    bool started_ = false;
+    QString index_text_;
+    QTimer frameTimer_;
+};
+
+}
+
+#endif // ROM_TRACKING_DISPLAY_HPP
@@ -14,12 +14,25 @@
 #include <QObject>
 #include <QQmlContext>
 #include <QQuickItem>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QGraphicsView>
+#include <QDateTime>
+#include <QShortcut>
+#include <QJsonDocument>
+#include <QSplitter>
+#include <QTabWidget>
+#include <QToolTip>
+#include <QCursor>
 
 #include "design/rom_design.hpp"
 
 #include <QDir>
 #include "design/readmeviewer.h"
 #include "design/covarianceDisplay.hpp"
+#include "design/gaugeScheduler.hpp"
+#include "design/romGauge.hpp"
+#include "design/romMapView.hpp"
 
 using namespace rom_dynamics::ui::qt;
 
@@ -53,7 +66,16 @@ MainWindow::MainWindow(QWidget *parent)
 
     initRos2ControlTab();
     initEkfTab();
-    //initCartoTab();
+    initCartoTab();
+    initNav2_1Tab();
+    initNav2_2Tab();
+    initNav2_3Tab();
+    initBtTab();
+    initTopicTab();
+    initLogTab();
+    initSessionCapture();
+    initSessionPool();
+    initChartShortcuts();
 }
 
 MainWindow::~MainWindow()
@@ -470,6 +492,24 @@ void MainWindow::createCommunicationClient(const QString &robot_ns, const QStrin
     qDebug() << "Hacked" ;
     this->isConnected_ = true;
 
+    // live robot wins over a replay
+    if (replay_ && replay_->isOpen())
+    {
+        replay_->close();
+        replayBar_->hide();
+    }
+
+    if(subscriptions_)
+    {
+        subscriptions_->deleteLater();
+        subscriptions_ = nullptr;
+    }
+    if(services_)
+    {
+        services_->cancelAll("client replaced");
+        services_->deleteLater();
+        services_ = nullptr;
+    }
     if(communication_)
     {
         communication_->deleteLater();
@@ -478,6 +518,27 @@ void MainWindow::createCommunicationClient(const QString &robot_ns, const QStrin
     // bridge driver နဲ့ ဆက်သွယ်ဖို့ 
     communication_ = new RosBridgeClient(robot_ns, host, port, this);
     connect(communication_, &RosBridgeClient::receivedTopicMessage, this, &MainWindow::onReceivedTopicMessage);
+    connect(communication_, &RosBridgeClient::receivedRawTopicMessage, this, &MainWindow::onReceivedRawTopicMessage);
+    connect(communication_, &RosBridgeClient::reconnectLatencyMeasured, this, [](qint64 reconnect_ms, qint64 outage_ms) {
+        qDebug() << "rosbridge reconnected, first message after" << reconnect_ms << "ms ( outage" << outage_ms << "ms )";
+    });
+
+    // a running recording follows the new client
+    communication_->setRecorder(recorder_ && recorder_->isRecording() ? recorder_ : nullptr);
+
+    // tab တွေကြား topic မျှသုံးဖို့ ( ref counted, unsubscribe after grace period )
+    subscriptions_ = new SubscriptionManager(communication_, 5000, this);
+
+    services_ = new ServiceCaller(communication_, 4, this);
+    if (parameterEditor_) parameterEditor_->setServiceCaller(services_);
+    if (topicMonitor_) topicMonitor_->setServiceCaller(services_);
+    if (messageInspector_) messageInspector_->setServiceCaller(services_);
+    topicRawTopics_.clear();
+
+    // /rosout is kept from the moment we connect, not only while the log tab is open
+    subscriptions_->acquire("rosout", "/rosout", "rcl_interfaces/msg/Log");
+
+    installLatencyRenderHooks();
 }
 void MainWindow::on_ekfTuningGuideBtn_clicked()
 {
@@ -563,102 +624,35 @@ void MainWindow::initRos2ControlTab()
         vLayout->setSpacing(8);                   // Space between elements (layouts)
         ui->ros2_control->setLayout(vLayout);
 
-        // ---------------------------------------------------------------------------- create 3 meters
-        // --- Create a horizontal layout for the 3 meters ---
-        QHBoxLayout *hLayout = new QHBoxLayout();
-        hLayout->setSpacing(16); 
-        hLayout->setAlignment(Qt::AlignLeft);
-        ros2ControlQmlView_.clear();
-
-        QQuickWidget *speed_meter   = new QQuickWidget(ui->ros2_control);
-        QQuickWidget *leftRpm_meter = new QQuickWidget(ui->ros2_control);
-        QQuickWidget *rightRpm_meter= new QQuickWidget(ui->ros2_control);
-
-        QVector<QQuickWidget*> meterWidgets = { speed_meter, leftRpm_meter, rightRpm_meter };
-
-        for(int i = 0; i < meterWidgets.size(); ++i)
-        {
-            QQuickWidget *meter = meterWidgets[i];
-            meter->setResizeMode(QQuickWidget::SizeRootObjectToView);
+        // ---------------------------------------------------------------------------- 6 meters, one scene
+        // one QQuickWidget ( one FBO, one render pass ) with native RomGauge items instead of six Canvas views
+        RomGauge::registerQmlType();
 
-            // Set fixed height (e.g., 60% of container height)
-            int meterHeight = static_cast<int>(ui->ros2_control->height() * 0.45);
-            meter->setMinimumHeight(meterHeight);
-            meter->setMaximumHeight(meterHeight);
+        ros2ControlGaugeView_ = new QQuickWidget(ui->ros2_control);
+        ros2ControlGaugeView_->setResizeMode(QQuickWidget::SizeRootObjectToView);
+        ros2ControlGaugeView_->setClearColor(QColor("#2e2e2e"));
+        ros2ControlGaugeView_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+        ros2ControlGaugeView_->setSource(QUrl(QStringLiteral("qrc:/Gauges.qml")));
 
-            meter->setClearColor(QColor("#2e2e2e"));
-            
-            meter->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-            
-            if (i == 0) {
-                meter->setSource(QUrl(QStringLiteral("qrc:/Speed.qml")));
-            } else if (i == 1) {
-                meter->setSource(QUrl(QStringLiteral("qrc:/LeftSpeed.qml")));
-            } else if (i == 2) {
-                meter->setSource(QUrl(QStringLiteral("qrc:/RightSpeed.qml")));
-            }
-
-            if (meter->status() != QQuickWidget::Ready) {
-                qWarning() << "Failed to load QML for meter" << i << ":" << meter->errors();
-            }
-
-            // Add to layout and store reference
-            hLayout->addWidget(meter, 1);  // equal width
-            ros2ControlQmlView_.append(meter);
+        if (ros2ControlGaugeView_->status() != QQuickWidget::Ready) {
+            qWarning() << "Failed to load QML for gauges :" << ros2ControlGaugeView_->errors();
         }
 
-        // --- Add the horizontal layout to the vertical layout ---
-        vLayout->addLayout(hLayout);
-        vLayout->addStretch(1);
-
-        // ---------------------------------------------------------------------------- next 3 meters
-        // --- Create a horizontal layout for the Actual 3 meters ---
-        QHBoxLayout *lower_hLayout = new QHBoxLayout();
-        lower_hLayout->setSpacing(16); 
-        
-        //ros2ControlQmlView_.clear();
+        vLayout->addWidget(ros2ControlGaugeView_, 1);
 
-        QQuickWidget *actual_speed_meter   = new QQuickWidget(ui->ros2_control);
-        QQuickWidget *actualLeftRpm_meter  = new QQuickWidget(ui->ros2_control);
-        QQuickWidget *actualRightRpm_meter = new QQuickWidget(ui->ros2_control);
+        // one push per display frame instead of one repaint per message ( Ros2ControlGauge order )
+        const char *gaugeNames[] = { "cmdSpeedGauge", "cmdLeftRpmGauge", "cmdRightRpmGauge",
+                                     "actualSpeedGauge", "actualLeftRpmGauge", "actualRightRpmGauge" };
+        QQuickItem *gaugeRoot = ros2ControlGaugeView_->rootObject();
 
-        QVector<QQuickWidget*> lower_meterWidgets = { actual_speed_meter, actualLeftRpm_meter, actualRightRpm_meter };
-
-        for(int i = 0; i < lower_meterWidgets.size(); ++i)
+        gaugeScheduler_ = new GaugeUpdateScheduler(this);
+        for (int i = 0; i < 6; ++i)
         {
-            QQuickWidget *meter = lower_meterWidgets[i];
-            meter->setResizeMode(QQuickWidget::SizeRootObjectToView);
-
-            // Set fixed height (e.g., 60% of container height)
-            int meterHeight = static_cast<int>(ui->ros2_control->height() * 0.45);
-            meter->setMinimumHeight(meterHeight);
-            meter->setMaximumHeight(meterHeight);
-
-            meter->setClearColor(QColor("#2e2e2e"));
-            
-            meter->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
-            
-            if (i == 0) {
-                meter->setSource(QUrl(QStringLiteral("qrc:/ActualSpeed.qml")));
-            } else if (i == 1) {
-                meter->setSource(QUrl(QStringLiteral("qrc:/ActualLeftSpeed.qml")));
-            } else if (i == 2) {
-                meter->setSource(QUrl(QStringLiteral("qrc:/ActualRightSpeed.qml")));
-            }
-
-            if (meter->status() != QQuickWidget::Ready) {
-                qWarning() << "Failed to load QML for meter" << i << ":" << meter->errors();
-            }
-
-            // Add to layout and store reference
-            lower_hLayout->addWidget(meter, 1);  // equal width
-            ros2ControlQmlView_.append(meter);
+            QObject *gauge = gaugeRoot ? gaugeRoot->findChild<QObject*>(gaugeNames[i]) : nullptr;
+            const bool rpm = (i != CmdSpeedGauge && i != ActualSpeedGauge);
+            gaugeScheduler_->addGauge(gauge, "speed", rpm);
         }
 
-        // --- Add the horizontal layout to the vertical layout ---
-        vLayout->addLayout(lower_hLayout);
-        vLayout->addStretch(1);
-        
         ui->desireVelHzLabel->raise();ui->desireVelHzUnitLabel->raise();
         ui->desireLeftWheelRpmLabel->raise();ui->desireLeftWheelRpmUnitLabel->raise();
         ui->desireRightWheelRpmLabel->raise();ui->desireRightWheelRpmUnitLabel->raise();
@@ -672,34 +666,38 @@ void MainWindow::initRos2ControlTab()
 }
 void MainWindow::activateRos2ControlTab()
 {
-    if (!communication_) return;
+    if (gaugeScheduler_)
+    {
+        gaugeScheduler_->setFrameRate(GaugeUpdateScheduler::refreshRateFor(this));
+        gaugeScheduler_->start();
+    }
+
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::ros2_control));
 
     QString cmd_vel_topic_name = "/diff_controller/cmd_vel_unstamped";
     QString cmd_vel_msg_type   = "geometry_msgs/msg/Twist";
-    communication_->subscribeTopic(cmd_vel_topic_name, cmd_vel_msg_type);
+    subscriptions_->acquire(owner, cmd_vel_topic_name, cmd_vel_msg_type);
 
     QString odom_topic_name = "/diff_controller/odom";
     QString odom_msg_type   = "nav_msgs/msg/Odometry";
-    communication_->subscribeTopic(odom_topic_name, odom_msg_type);
+    subscriptions_->acquire(owner, odom_topic_name, odom_msg_type);
 
     QString js_topic_name = "/joint_states";
     QString js_msg_type   = "sensor_msgs/msg/JointState";
-    communication_->subscribeTopic(js_topic_name, js_msg_type);
+    subscriptions_->acquire(owner, js_topic_name, js_msg_type);
 
     qDebug() << "Subscribed to " << cmd_vel_topic_name << "," << odom_topic_name << "," << js_topic_name;
 }
 void MainWindow::deactivateRos2ControlTab()
 {
-    if (!communication_) return;
-    
-    QString cmd_vel_topic_name = "/diff_controller/cmd_vel_unstamped";
-    QString odom_topic_name = "/diff_controller/odom";
-    QString js_topic_name = "/joint_states";
-    communication_->unsubscribeTopic(cmd_vel_topic_name);
-    communication_->unsubscribeTopic(odom_topic_name);
-    communication_->unsubscribeTopic(js_topic_name);
+    if (gaugeScheduler_) gaugeScheduler_->stop();
 
-    qDebug() << "Unsubscribed from " << cmd_vel_topic_name << "," << odom_topic_name << "," << js_topic_name;
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::ros2_control));
+
+    // topics stay alive for the grace period, shared ones ( /diff_controller/odom ) stay while ekf holds them
+    subscriptions_->releaseAll(owner);
 }
 
 
@@ -741,6 +739,29 @@ void MainWindow::initEkfTab()
 
         ui->ekf->setLayout(grid);
 
+        // covariance timeline covers the four graphs while it is shown
+        ekfCovarianceTimelinePtr_ = new rom_dynamics::ui::qt::RomCovarianceTimeline(ui->ekf);
+        ekfCovarianceTimelinePtr_->setAutoFillBackground(true);
+        ekfCovarianceTimelinePtr_->hide();
+
+        ekfTimelineBtn_ = new QPushButton("~", ui->ekf);
+        ekfTimelineBtn_->setGeometry(745, 9, 20, 21);
+        ekfTimelineBtn_->setCheckable(true);
+        ekfTimelineBtn_->setToolTip("Covariance timeline");
+        connect(ekfTimelineBtn_, &QPushButton::toggled, this, [this](bool on) {
+            if (on)
+            {
+                ekfCovarianceTimelinePtr_->setGeometry(ui->ekf->rect());
+                ekfCovarianceTimelinePtr_->show();
+                ekfCovarianceTimelinePtr_->raise();
+                ekfTimelineBtn_->raise();
+            }
+            else
+            {
+                ekfCovarianceTimelinePtr_->hide();
+            }
+        });
+
         //=================================
         ui->controllerLegendLabel->raise();
         ui->controllerPoseLegendLabel->raise();
@@ -834,112 +855,251 @@ void MainWindow::initEkfTab()
 }
 void MainWindow::activateEkfTab()
 {
-    if (!communication_) return;
+    ekfState_.clear();
+    if (!ekfFrameTimer_)
+    {
+        ekfFrameTimer_ = new QTimer(this);
+        ekfFrameTimer_->setTimerType(Qt::PreciseTimer);
+        connect(ekfFrameTimer_, &QTimer::timeout, this, &MainWindow::onEkfFrame);
+    }
+    ekfFrameTimer_->start(qMax(1, qRound(1000.0 / GaugeUpdateScheduler::refreshRateFor(this))));
+
+    // overlay robots only need their ekf pose
+    if (sessionPool_) sessionPool_->subscribeAll("/odom", "nav_msgs/msg/Odometry");
+
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::ekf));
 
     QString odom_topic_name = "/diff_controller/odom";
     QString odom_msg_type   = "nav_msgs/msg/Odometry";
-    communication_->subscribeTopic(odom_topic_name, odom_msg_type);
+    subscriptions_->acquire(owner, odom_topic_name, odom_msg_type);
 
     QString ekf_odom_topic_name = "/odom";
-    QString cmd_vel_msg_type   = "geometry_msgs/msg/Twist";
-    communication_->subscribeTopic(ekf_odom_topic_name, odom_msg_type);
+    subscriptions_->acquire(owner, ekf_odom_topic_name, odom_msg_type);
 
     QString imu_topic_name = "/imu/out";
     QString imu_msg_type   = "sensor_msgs/msg/Imu";
-    communication_->subscribeTopic(imu_topic_name, imu_msg_type);
+    subscriptions_->acquire(owner, imu_topic_name, imu_msg_type);
 
     qDebug() << "Subscribed to " << odom_topic_name << "," << ekf_odom_topic_name << "," << imu_topic_name;
 }
 void MainWindow::deactivateEkfTab()
 {
-    QString ekf_odom_topic_name = "/odom";
-    QString odom_topic_name = "/diff_controller/odom";
-    QString imu_topic_name = "/imu/out";
-    communication_->unsubscribeTopic(ekf_odom_topic_name);
-    communication_->unsubscribeTopic(odom_topic_name);
-    communication_->unsubscribeTopic(imu_topic_name);
+    if (ekfFrameTimer_) ekfFrameTimer_->stop();
 
-    qDebug() << "Unsubscribed from " << odom_topic_name << "," << ekf_odom_topic_name << "," << imu_topic_name;
+    if (sessionPool_) sessionPool_->unsubscribeAll("/odom");
+
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::ekf));
+
+    subscriptions_->releaseAll(owner);
 }
 
 void MainWindow::initCartoTab()
 {
+    if (!ui->carto) return;
+
+    QLayout *existing = ui->carto->layout();
+    if (existing) delete existing;
 
+    QVBoxLayout *vLayout = new QVBoxLayout(ui->carto);
+    vLayout->setContentsMargins(8, 8, 8, 8);
+    vLayout->setSpacing(4);
+
+    cartoMapWidget_ = createMapWidget(ui->carto, vLayout, cartoMap_);
+
+    cartoStatusLabel_ = new QLabel("waiting for /map", ui->carto);
+    cartoStatusLabel_->setStyleSheet("color: #bdb7b7; font-size: 10px;");
+    vLayout->addWidget(cartoStatusLabel_);
+
+    // layer 0 : cartographer /map, decoded on its own thread
+    cartoGrid_ = new OccupancyGridSource(this);
+    if (cartoMap_) cartoMap_->attachGridSource(0, cartoGrid_);
+
+    connect(cartoGrid_, &OccupancyGridSource::gridReset, this, [this](const RomGridInfo &info) {
+        cartoStatusLabel_->setText(QString("/map %1 x %2 @ %3 m").arg(info.width).arg(info.height).arg(info.resolution));
+    });
+    connect(cartoGrid_, &OccupancyGridSource::decoded, this, [this](int tiles, double parse_ms, double tile_ms) {
+        const QString text = cartoStatusLabel_->text().section("  |", 0, 0);
+        cartoStatusLabel_->setText(QString("%1  |  parse %2 ms  tiles %3 ( %4 ms )")
+                                   .arg(text).arg(parse_ms, 0, 'f', 1).arg(tiles).arg(tile_ms, 0, 'f', 1));
+    });
 }
 void MainWindow::activateCartoTab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-    
-    //communication_->subscribeTopic(example_topic_name, example_msg_type);
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::carto));
 
-    //qDebug() << "Subscribed to " << example_topic_name;
+    // maps can be megabytes of JSON : parsed on the grid decode thread, not here
+    communication_->setRawTopic("/map");
+    communication_->setRawTopic("/map_updates");
 
+    subscriptions_->acquire(owner, "/map", "nav_msgs/msg/OccupancyGrid");
+    subscriptions_->acquire(owner, "/map_updates", "map_msgs/msg/OccupancyGridUpdate");
+    subscriptions_->acquire(owner, "/scan", "sensor_msgs/msg/LaserScan");
+    subscriptions_->acquire(owner, "/tracked_pose", "geometry_msgs/msg/PoseStamped");
 }
 void MainWindow::deactivateCartoTab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-
-    //communication_->unsubscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Unsubscribed to " << example_topic_name;
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::carto));
 
+    subscriptions_->releaseAll(owner);
 }
 
 void MainWindow::initNav2_1Tab()
 {
+    if (!ui->navi2_one) return;
+
+    QLayout *existing = ui->navi2_one->layout();
+    if (existing) delete existing;
+
+    QVBoxLayout *vLayout = new QVBoxLayout(ui->navi2_one);
+    vLayout->setContentsMargins(8, 8, 8, 8);
+    vLayout->setSpacing(4);
+
+    nav2MapWidget_ = createMapWidget(ui->navi2_one, vLayout, nav2Map_);
+
+    nav2StatusLabel_ = new QLabel("waiting for /map", ui->navi2_one);
+    nav2StatusLabel_->setStyleSheet("color: #bdb7b7; font-size: 10px;");
+    vLayout->addWidget(nav2StatusLabel_);
 
+    // layer 0 : map_server /map
+    nav2Grid_ = new OccupancyGridSource(this);
+    if (nav2Map_) nav2Map_->attachGridSource(0, nav2Grid_);
+
+    connect(nav2Grid_, &OccupancyGridSource::gridReset, this, [this](const RomGridInfo &info) {
+        nav2StatusLabel_->setText(QString("/map %1 x %2 @ %3 m").arg(info.width).arg(info.height).arg(info.resolution));
+    });
+
+    // layers 1 / 2 : costmaps, patched by their costmap_updates
+    initCostmapLayer(0, "global_costmap", 1, vLayout);
+    initCostmapLayer(1, "local_costmap", 2, vLayout);
+
+    if (nav2Map_)
+    {
+        connect(nav2Map_, &RomMapView::tilesUploaded, this, [this](int layer, int tiles, double upload_ms) {
+            if (layer < 1 || layer > 2) return;
+            CostmapStats &stats = nav2Costmaps_[layer - 1];
+            stats.uploaded_tiles = tiles;
+            stats.upload_ms = upload_ms;
+            showCostmapStats(stats);
+        });
+    }
+}
+void MainWindow::initCostmapLayer(int index, const QString &name, int layer, QVBoxLayout *layout)
+{
+    CostmapStats &stats = nav2Costmaps_[index];
+    stats.name = name;
+    stats.source = new OccupancyGridSource(this);
+    stats.source->setPalette(OccupancyGridSource::costmapPalette());
+    stats.label = new QLabel(QString("waiting for /%1/costmap").arg(name), layout->parentWidget());
+    stats.label->setStyleSheet("color: #bdb7b7; font-size: 10px;");
+    layout->addWidget(stats.label);
+
+    if (nav2Map_)
+    {
+        nav2Map_->attachGridSource(layer, stats.source);
+        nav2Map_->setLayerOpacity(layer, 0.8);
+    }
+
+    connect(stats.source, &OccupancyGridSource::decoded, this, [this, index](int tiles, double parse_ms, double tile_ms) {
+        CostmapStats &stats = nav2Costmaps_[index];
+        stats.parse_ms = parse_ms;
+        stats.color_ms = tile_ms;
+        stats.colored_tiles = tiles;
+        showCostmapStats(stats);
+    });
+}
+void MainWindow::showCostmapStats(const CostmapStats &stats)
+{
+    stats.label->setText(QString("%1  |  decode %2 ms  color %3 ms ( %4 tiles )  upload %5 ms ( %6 tiles )")
+                         .arg(stats.name)
+                         .arg(stats.parse_ms, 0, 'f', 2)
+                         .arg(stats.color_ms, 0, 'f', 2).arg(stats.colored_tiles)
+                         .arg(stats.upload_ms, 0, 'f', 2).arg(stats.uploaded_tiles));
 }
 void MainWindow::activateNav2_1Tab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-    
-    //communication_->subscribeTopic(example_topic_name, example_msg_type);
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::nav2_1));
 
-    //qDebug() << "Subscribed to " << example_topic_name;
+    communication_->setRawTopic("/map");
+    subscriptions_->acquire(owner, "/map", "nav_msgs/msg/OccupancyGrid");
 
+    for (const CostmapStats &stats : nav2Costmaps_)
+    {
+        const QString costmap = "/" + stats.name + "/costmap";
+        communication_->setRawTopic(costmap);
+        communication_->setRawTopic(costmap + "_updates");
+        subscriptions_->acquire(owner, costmap, "nav_msgs/msg/OccupancyGrid");
+        subscriptions_->acquire(owner, costmap + "_updates", "map_msgs/msg/OccupancyGridUpdate");
+    }
+
+    subscriptions_->acquire(owner, "/scan", "sensor_msgs/msg/LaserScan");
+    subscriptions_->acquire(owner, "/amcl_pose", "geometry_msgs/msg/PoseWithCovarianceStamped");
 }
 void MainWindow::deactivateNav2_1Tab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-
-    //communication_->unsubscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Unsubscribed to " << example_topic_name;
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::nav2_1));
 
+    subscriptions_->releaseAll(owner);
 }
 
 void MainWindow::initNav2_2Tab()
 {
+    if (!ui->navi2_two) return;
+
+    QLayout *existing = ui->navi2_two->layout();
+    if (existing) delete existing;
 
+    QHBoxLayout *hLayout = new QHBoxLayout(ui->navi2_two);
+    hLayout->setContentsMargins(8, 8, 8, 8);
+    hLayout->setSpacing(4);
+
+    // plan / local plan / odom trail, the view follows the robot
+    nav2TrackingMapWidget_ = createMapWidget(ui->navi2_two, hLayout, nav2TrackingMap_);
+    hLayout->setStretch(0, 1);
+
+    nav2TrackingGraph_ = new RomTrackingErrorGraph(ui->navi2_two);
+    hLayout->addWidget(nav2TrackingGraph_, 1);
 }
 void MainWindow::activateNav2_2Tab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-    
-    //communication_->subscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Subscribed to " << example_topic_name;
-
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::nav2_2));
+
+    subscriptions_->acquire(owner, "/plan", "nav_msgs/msg/Path");
+    subscriptions_->acquire(owner, "/local_plan", "nav_msgs/msg/Path");
+    subscriptions_->acquire(owner, "/odom", "nav_msgs/msg/Odometry");
+    subscriptions_->acquire(owner, "/cmd_vel", "geometry_msgs/msg/Twist");
+    subscriptions_->acquire(owner, "/amcl_pose", "geometry_msgs/msg/PoseWithCovarianceStamped");
 }
 void MainWindow::deactivateNav2_2Tab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-
-    //communication_->unsubscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Unsubscribed to " << example_topic_name;
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::nav2_2));
 
+    subscriptions_->releaseAll(owner);
 }
 
 void MainWindow::initNav2_3Tab()
 {
+    if (!ui->navi2_three) return;
 
+    QLayout *existing = ui->navi2_three->layout();
+    if (existing) delete existing;
+
+    QVBoxLayout *vLayout = new QVBoxLayout(ui->navi2_three);
+    vLayout->setContentsMargins(0, 0, 0, 0);
+
+    parameterEditor_ = new RomParameterEditor(ui->navi2_three);
+    parameterEditor_->setNodes({ "/ekf_filter_node", "/controller_server", "/planner_server", "/amcl",
+                                 "/local_costmap/local_costmap", "/global_costmap/global_costmap",
+                                 "/velocity_smoother", "/bt_navigator" });
+    parameterEditor_->setServiceCaller(services_);
+    vLayout->addWidget(parameterEditor_);
 }
 void MainWindow::activateNav2_3Tab()
 {
@@ -964,60 +1124,540 @@ void MainWindow::deactivateNav2_3Tab()
 
 void MainWindow::initBtTab()
 {
+    if (!ui->bt) return;
+
+    QLayout *existing = ui->bt->layout();
+    if (existing) delete existing;
+
+    QVBoxLayout *vLayout = new QVBoxLayout(ui->bt);
+    vLayout->setContentsMargins(0, 0, 0, 0);
 
+    btMonitor_ = new RomBtMonitor(ui->bt);
+    vLayout->addWidget(btMonitor_);
 }
 void MainWindow::activateBtTab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-    
-    //communication_->subscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Subscribed to " << example_topic_name;
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::bt));
 
+    subscriptions_->acquire(owner, "/behavior_tree_log", "nav2_msgs/msg/BehaviorTreeLog");
 }
 void MainWindow::deactivateBtTab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-
-    //communication_->unsubscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Unsubscribed to " << example_topic_name;
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::bt));
 
+    subscriptions_->releaseAll(owner);
 }
 
 void MainWindow::initTopicTab()
 {
-
+    if (!ui->topic) return;
+
+    QLayout *existing = ui->topic->layout();
+    if (existing) delete existing;
+
+    QVBoxLayout *vLayout = new QVBoxLayout(ui->topic);
+    vLayout->setContentsMargins(0, 0, 0, 0);
+
+    QSplitter *splitter = new QSplitter(Qt::Vertical, ui->topic);
+    splitter->setChildrenCollapsible(false);
+
+    topicMonitor_ = new RomTopicMonitor(splitter);
+    topicMonitor_->setServiceCaller(services_);
+
+    // inspector and plots side by side, fields are dragged from one to the other
+    QSplitter *lower = new QSplitter(Qt::Horizontal, splitter);
+    lower->setChildrenCollapsible(false);
+    messageInspector_ = new RomMessageInspector(lower);
+    messageInspector_->setServiceCaller(services_);
+    fieldPlots_ = new RomFieldPlotPanel(lower);
+    lower->addWidget(messageInspector_);
+    lower->addWidget(fieldPlots_);
+    lower->setSizes({ 330, 470 });
+
+    splitter->addWidget(topicMonitor_);
+    splitter->addWidget(lower);
+    splitter->setSizes({ 200, 360 });
+    vLayout->addWidget(splitter);
+
+    connect(topicMonitor_, &RomTopicMonitor::monitorToggled, this, [this](const QString &topic, const QString &type, bool on) {
+        if (currentMode == Mode::topic) setTopicMonitored(topic, type, on);
+    });
+    connect(topicMonitor_, &RomTopicMonitor::inspectRequested, this, &MainWindow::setTopicInspected);
+    connect(fieldPlots_, &RomFieldPlotPanel::topicNeeded, this, &MainWindow::setTopicPlotted);
 }
 void MainWindow::activateTopicTab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
-    
-    //communication_->subscribeTopic(example_topic_name, example_msg_type);
-
-    //qDebug() << "Subscribed to " << example_topic_name;
+    if (!subscriptions_ || !topicMonitor_) return;
 
+    for (const auto &entry : topicMonitor_->monitored()) setTopicMonitored(entry.first, entry.second, true);
+    if (messageInspector_ && !messageInspector_->topic().isEmpty()) setTopicInspected(messageInspector_->topic(), inspectedType_);
+    if (fieldPlots_)
+    {
+        for (const QString &topic : fieldPlots_->topics()) setTopicPlotted(topic, plottedTypes_.value(topic), true);
+    }
 }
 void MainWindow::deactivateTopicTab()
 {
-    //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
-    //QString example_msg_type   = "geometry_msgs/msg/Twist";
+    if (!subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::topic));
+
+    subscriptions_->releaseAll(owner);
+    subscriptions_->releaseAll(owner + "/inspect");
+    subscriptions_->releaseAll(owner + "/plot");
+    for (const QString &topic : std::as_const(topicRawTopics_)) communication_->setRawTopic(topic, false);
+    topicRawTopics_.clear();
+}
+void MainWindow::setTopicMonitored(const QString &topic, const QString &type, bool on)
+{
+    if (!subscriptions_ || !communication_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::topic));
 
-    //communication_->unsubscribeTopic(example_topic_name, example_msg_type);
+    // /rosapi/topics names are absolute, the client adds the namespace itself
+    QString local = topic;
+    if (!robotNamespace_.isEmpty() && local.startsWith(robotNamespace_)) local.remove(0, robotNamespace_.size());
 
-    //qDebug() << "Unsubscribed to " << example_topic_name;
+    if (on)
+    {
+        // only size and arrival time are needed : raw frames skip the JSON decode
+        if (!communication_->isRawTopic(local))
+        {
+            communication_->setRawTopic(local);
+            topicRawTopics_.insert(local);
+        }
+        subscriptions_->acquire(owner, local, type);
+    }
+    else
+    {
+        subscriptions_->release(owner, local);
+        if (topicRawTopics_.remove(local)) communication_->setRawTopic(local, false);
+    }
+}
+void MainWindow::setTopicInspected(const QString &topic, const QString &type)
+{
+    if (!messageInspector_) return;
+    messageInspector_->inspect(topic, type);
+    inspectedType_ = type;
+
+    if (currentMode != Mode::topic || !subscriptions_ || !communication_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::topic)) + "/inspect";
+
+    QString local = topic;
+    if (!robotNamespace_.isEmpty() && local.startsWith(robotNamespace_)) local.remove(0, robotNamespace_.size());
+
+    // raw : the inspector decodes only the frames it shows
+    subscriptions_->releaseAll(owner);
+    if (!communication_->isRawTopic(local))
+    {
+        communication_->setRawTopic(local);
+        topicRawTopics_.insert(local);
+    }
+    subscriptions_->acquire(owner, local, type);
+}
+void MainWindow::setTopicPlotted(const QString &topic, const QString &type, bool on)
+{
+    if (on)
+    {
+        QString resolved = type;
+        if (resolved.isEmpty() && topicMonitor_) resolved = topicMonitor_->typeOf(topic);
+        plottedTypes_.insert(topic, resolved);
+    }
+    else plottedTypes_.remove(topic);
+
+    if (currentMode != Mode::topic || !subscriptions_) return;
+    const QString owner = QString::fromStdString(ModeToString(Mode::topic)) + "/plot";
+
+    QString local = topic;
+    if (!robotNamespace_.isEmpty() && local.startsWith(robotNamespace_)) local.remove(0, robotNamespace_.size());
 
+    if (on) subscriptions_->acquire(owner, local, plottedTypes_.value(topic));
+    else subscriptions_->release(owner, local);
 }
 
 void MainWindow::initLogTab()
 {
+    if (ui->log)
+    {
+        QLayout *existing = ui->log->layout();
+        if (existing) 
+        {
+            delete existing;
+        }
+
+        QVBoxLayout *logLayout = new QVBoxLayout(ui->log);
+        logLayout->setContentsMargins(0, 0, 0, 0);
+
+        // --- /rosout and latency pages ---
+        QTabWidget *logTabs = new QTabWidget(ui->log);
+        logTabs->setStyleSheet("QTabBar::tab { color: #c3c9d4; background: #2e2e2e; padding: 3px 12px; font: 10px; }"
+                               "QTabBar::tab:selected { color: white; border-bottom: 1px solid orange; }");
+        logView_ = new rom_dynamics::ui::qt::RomLogView(&logStore_, logTabs);
+        QWidget *latencyPage = new QWidget(logTabs);
+        logTabs->addTab(logView_, "rosout");
+        logTabs->addTab(latencyPage, "latency");
+        logLayout->addWidget(logTabs);
+        ui->log->setLayout(logLayout);
+
+        QVBoxLayout *vLayout = new QVBoxLayout(latencyPage);
+        vLayout->setContentsMargins(8, 8, 8, 8);
+        vLayout->setSpacing(8);
+
+        // --- header : clock offset + export ---
+        QHBoxLayout *hLayout = new QHBoxLayout();
+        clockOffsetLabel_ = new QLabel("clock offset : waiting for /rosapi/get_time", latencyPage);
+        clockOffsetLabel_->setStyleSheet("color: #03fc84; font: 10px;");
+
+        QPushButton *resetBtn  = new QPushButton("Reset", latencyPage);
+        QPushButton *exportBtn = new QPushButton("Export Chrome Trace", latencyPage);
+        for (QPushButton *btn : { resetBtn, exportBtn })
+        {
+            btn->setStyleSheet("QPushButton { color: white; background-color: #222; border: none; padding: 4px 8px; }"
+                               "QPushButton:hover { background-color: white; color: black; }");
+        }
+
+        hLayout->addWidget(clockOffsetLabel_, 1);
+        hLayout->addWidget(resetBtn);
+        hLayout->addWidget(exportBtn);
+        vLayout->addLayout(hLayout);
+
+        // --- per topic latency ( p50 / p99, ms ) ---
+        const QStringList headers = { "topic", "msgs",
+                                      "net p50", "net p99",
+                                      "decode p50", "decode p99",
+                                      "dispatch p50", "dispatch p99",
+                                      "render p50", "render p99",
+                                      "total p50", "total p99" };
+        latencyTable_ = new QTableWidget(0, headers.size(), latencyPage);
+        latencyTable_->setHorizontalHeaderLabels(headers);
+        latencyTable_->verticalHeader()->setVisible(false);
+        latencyTable_->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        latencyTable_->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+        latencyTable_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        latencyTable_->setSelectionMode(QAbstractItemView::NoSelection);
+        latencyTable_->setStyleSheet("QTableWidget { color: white; background: #2e2e2e; gridline-color: #444; font: 10px; }"
+                                     "QHeaderView::section { color: #03fc84; background: #222; border: none; font: 10px; }");
+        vLayout->addWidget(latencyTable_, 1);
+
+        latencyRefreshTimer_ = new QTimer(this);
+        latencyRefreshTimer_->setInterval(500);
+        connect(latencyRefreshTimer_, &QTimer::timeout, this, &MainWindow::refreshLatencyTable);
+
+        connect(resetBtn, &QPushButton::clicked, this, [this]() {
+            if (communication_) communication_->latencyTracer()->reset();
+            refreshLatencyTable();
+        });
+        connect(exportBtn, &QPushButton::clicked, this, [this]() {
+            if (!communication_) return;
+            QString path = QFileDialog::getSaveFileName(this, "Export Chrome Trace", "rom_latency_trace.json", "Trace (*.json)");
+            if (path.isEmpty()) return;
+            if (!communication_->latencyTracer()->exportChromeTrace(path))
+            {
+                QMessageBox::warning(this, "Export Chrome Trace", "Could not write " + path);
+            }
+        });
+    }
+}
+void MainWindow::initSessionCapture()
+{
+    recorder_ = new SessionRecorder(this);
+    replay_ = new SessionReplay(this);
+    connect(replay_, &SessionReplay::receivedTopicMessage, this, &MainWindow::onReceivedTopicMessage);
+
+    const QString btnStyle = "QPushButton { color: #c3c9d4; border-radius: 4px; border: 1px solid #c3c9d4; }"
+                             "QPushButton:hover { color: white; border: 1px solid orange; }"
+                             "QPushButton:focus { color: white; border: 1px solid orange; }";
+
+    // --- ssh tab : under rsync / connect ---
+    recordBtn_ = new QPushButton("Record", ui->ssh);
+    recordBtn_->setGeometry(540, 295, 63, 25);
+    recordBtn_->setStyleSheet(btnStyle);
+    recordBtn_->setToolTip("Record every received topic into a .romcap file");
+    connect(recordBtn_, &QPushButton::clicked, this, &MainWindow::toggleRecording);
+
+    replayBtn_ = new QPushButton("Replay", ui->ssh);
+    replayBtn_->setGeometry(608, 295, 63, 25);
+    replayBtn_->setStyleSheet(btnStyle);
+    replayBtn_->setToolTip("Play a .romcap file back instead of a robot");
+    connect(replayBtn_, &QPushButton::clicked, this, &MainWindow::openReplay);
+
+    // --- replay bar, bottom of the window, hidden until a file is open ---
+    replayBar_ = new QWidget(ui->centralwidget);
+    replayBar_->setGeometry(0, 572, 800, 28);
+    replayBar_->setStyleSheet("background: #222;");
+
+    QHBoxLayout *barLayout = new QHBoxLayout(replayBar_);
+    barLayout->setContentsMargins(8, 2, 8, 2);
+    barLayout->setSpacing(6);
+
+    replayPlayBtn_ = new QPushButton("Play", replayBar_);
+    replayPlayBtn_->setFixedWidth(50);
+    replayPlayBtn_->setStyleSheet(btnStyle);
+
+    replaySpeedCombo_ = new QComboBox(replayBar_);
+    replaySpeedCombo_->addItem("1x", 1.0);
+    replaySpeedCombo_->addItem("2x", 2.0);
+    replaySpeedCombo_->addItem("5x", 5.0);
+    replaySpeedCombo_->addItem("10x", 10.0);
+    replaySpeedCombo_->addItem("max", 0.0);
+    replaySpeedCombo_->setStyleSheet("color: #c3c9d4; font: 10px;");
+
+    replaySlider_ = new QSlider(Qt::Horizontal, replayBar_);
+    replaySlider_->setRange(0, 1000);
+
+    replayTimeLabel_ = new QLabel("0.0 / 0.0 s", replayBar_);
+    replayTimeLabel_->setStyleSheet("color: #03fc84; font: 10px;");
+    replayTimeLabel_->setMinimumWidth(90);
+
+    QPushButton *closeReplayBtn = new QPushButton("x", replayBar_);
+    closeReplayBtn->setFixedWidth(25);
+    closeReplayBtn->setStyleSheet(btnStyle);
+
+    barLayout->addWidget(replayPlayBtn_);
+    barLayout->addWidget(replaySpeedCombo_);
+    barLayout->addWidget(replaySlider_, 1);
+    barLayout->addWidget(replayTimeLabel_);
+    barLayout->addWidget(closeReplayBtn);
+    replayBar_->hide();
+
+    connect(replayPlayBtn_, &QPushButton::clicked, this, [this]() {
+        if (replay_->isPlaying()) replay_->pause();
+        else replay_->play();
+        replayPlayBtn_->setText(replay_->isPlaying() ? "Pause" : "Play");
+    });
+    connect(replaySpeedCombo_, &QComboBox::currentIndexChanged, this, [this](int index) {
+        replay_->setSpeed(replaySpeedCombo_->itemData(index).toDouble());
+    });
+    connect(replaySlider_, &QSlider::sliderReleased, this, [this]() {
+        replay_->seek(replay_->duration() * replaySlider_->value() / 1000);
+    });
+    connect(closeReplayBtn, &QPushButton::clicked, this, &MainWindow::closeReplay);
+
+    connect(replay_, &SessionReplay::positionChanged, this, [this](qint64 ts_ns) {
+        const qint64 duration = qMax<qint64>(1, replay_->duration());
+        if (!replaySlider_->isSliderDown())
+        {
+            replaySlider_->setValue(static_cast<int>(ts_ns * 1000 / duration));
+        }
+        replayTimeLabel_->setText(QString("%1 / %2 s").arg(ts_ns / 1e9, 0, 'f', 1).arg(duration / 1e9, 0, 'f', 1));
+    });
+    connect(replay_, &SessionReplay::finished, this, [this]() {
+        replayPlayBtn_->setText("Play");
+    });
+    connect(replay_, &SessionReplay::throughputMeasured, this, [](quint64 messages, double seconds) {
+        qDebug() << "replay throughput :" << messages << "messages in" << seconds << "s ="
+                 << (seconds > 0 ? messages / seconds : 0.0) << "msg/s";
+    });
+}
+void MainWindow::toggleRecording()
+{
+    if (recorder_->isRecording())
+    {
+        if (communication_) communication_->setRecorder(nullptr);
+        qDebug() << "recording stopped :" << recorder_->messageCount() << "messages," << recorder_->bytesWritten() << "bytes";
+        recorder_->close();
+        recordBtn_->setText("Record");
+        return;
+    }
+
+    const QString name = QString("rom_session_%1.romcap").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+    QString path = QFileDialog::getSaveFileName(this, "Record Session", name, "ROM capture (*.romcap)");
+    if (path.isEmpty()) return;
+
+    if (!recorder_->open(path))
+    {
+        QMessageBox::warning(this, "Record Session", "Could not write " + path);
+        return;
+    }
+    if (communication_) communication_->setRecorder(recorder_);
+    recordBtn_->setText("Stop");
+}
+void MainWindow::openReplay()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Replay Session", QString(), "ROM capture (*.romcap)");
+    if (path.isEmpty()) return;
+
+    if (!replay_->open(path))
+    {
+        QMessageBox::warning(this, "Replay Session", "Could not read " + path);
+        return;
+    }
 
+    // a replay stands in for the robot : drop the live client so both never feed the tabs
+    if (subscriptions_) { subscriptions_->deleteLater(); subscriptions_ = nullptr; }
+    if (communication_) { communication_->deleteLater(); communication_ = nullptr; }
+    this->isConnected_ = true;
+
+    replaySpeedCombo_->setCurrentIndex(0);
+    replay_->setSpeed(1.0);
+    replayPlayBtn_->setText("Play");
+    replayBar_->show();
+    replayBar_->raise();
+
+    qDebug() << "replay" << path << ":" << replay_->messageCount() << "messages,"
+             << replay_->duration() / 1e9 << "s," << replay_->topics();
+}
+void MainWindow::closeReplay()
+{
+    replay_->close();
+    replayBar_->hide();
+    this->isConnected_ = false;
+    ui->tabWidget->setCurrentIndex(0);
+}
+void MainWindow::initSessionPool()
+{
+    sessionPool_ = new RobotSessionPool(this);
+    sessionPool_->setMaxRate(30.0);   // graphs redraw at most this often per robot
+    connect(sessionPool_, &RobotSessionPool::receivedTopicMessage, this, &MainWindow::onReceivedSessionMessage);
+    connect(sessionPool_, &RobotSessionPool::sessionConnectionChanged, this, [](const QString &key, bool connected) {
+        qDebug() << "overlay robot" << key << (connected ? "connected" : "disconnected");
+    });
+
+    overlayRobotBtn_ = new QPushButton("+", ui->ssh);
+    overlayRobotBtn_->setGeometry(700, 295, 25, 25);
+    overlayRobotBtn_->setStyleSheet(recordBtn_->styleSheet());
+    overlayRobotBtn_->setToolTip("Add / remove this robot as an overlay on the ekf graphs");
+    connect(overlayRobotBtn_, &QPushButton::clicked, this, &MainWindow::toggleOverlaySession);
+}
+void MainWindow::toggleOverlaySession()
+{
+    const QString ip = ui->ipLineEdit->text().trimmed();
+    const QString robot_ns = ui->nsLineEdit->text().trimmed();
+    if (ip.isEmpty())
+    {
+        ui->ipLineEdit->setFocus();
+        return;
+    }
+
+    const quint16 port = this->robotPort_.toUShort();
+    const QString key = RobotSessionPool::sessionKey(robot_ns, ip, port);
+
+    if (sessionPool_->contains(key))
+    {
+        sessionPool_->removeSession(key);
+        sessionColors_.remove(key);
+        if (odomDiffOdomPositionGraphPtr_) odomDiffOdomPositionGraphPtr_->removeOverlay(key);
+        return;
+    }
+
+    static const QList<QColor> overlayColors = { QColor("#00bfff"), QColor("#ff69b4"), QColor("#ffd700"), QColor("#ba55d3") };
+    sessionColors_.insert(key, overlayColors[sessionColors_.size() % overlayColors.size()]);
+    sessionPool_->addSession(robot_ns, ip, port);
+}
+void MainWindow::onReceivedSessionMessage(const QString &session_key, const QString &topic, const QJsonObject &msg)
+{
+    if (currentMode != Mode::ekf || topic != "/odom") return;
+    if (!odomDiffOdomPositionGraphPtr_ || !msg.contains("pose")) return;
+    // still queued from a session that was just removed : would re-create its overlay
+    if (!sessionPool_ || !sessionPool_->contains(session_key)) return;
+
+    const QJsonObject position = msg.value("pose").toObject().value("pose").toObject().value("position").toObject();
+    odomDiffOdomPositionGraphPtr_->updateOverlay(session_key,
+                                                 QPointF(position.value("x").toDouble(), position.value("y").toDouble()),
+                                                 sessionColors_.value(session_key, Qt::cyan));
+}
+void MainWindow::initChartShortcuts()
+{
+    // graphs are created per tab activation, so look the views up when the key is pressed
+    QShortcut *backendShortcut = new QShortcut(QKeySequence("Ctrl+Shift+G"), this);
+    connect(backendShortcut, &QShortcut::activated, this, [this]() {
+        const RomChartBackend backend = RomChartView::defaultBackend() == RomChartBackend::OpenGL
+                                        ? RomChartBackend::Software : RomChartBackend::OpenGL;
+        RomChartView::setDefaultBackend(backend);
+        for (RomChartView *view : findChildren<RomChartView*>()) view->setBackend(backend);
+        // shown where the user is, the switch has no other visible feedback
+        QToolTip::showText(QCursor::pos(), QString("chart backend : %1\ngl renderer : %2")
+                           .arg(backend == RomChartBackend::OpenGL ? "opengl" : "software", RomChartView::glRenderer()),
+                           this, QRect(), 3000);
+    });
+
+    QShortcut *overlayShortcut = new QShortcut(QKeySequence("Ctrl+Shift+F"), this);
+    connect(overlayShortcut, &QShortcut::activated, this, [this]() {
+        const bool visible = !RomChartView::defaultOverlayVisible();
+        RomChartView::setDefaultOverlayVisible(visible);
+        for (RomChartView *view : findChildren<RomChartView*>()) view->setFrameOverlayVisible(visible);
+    });
+}
+void MainWindow::installLatencyRenderHooks()
+{
+    if (!communication_) return;
+    LatencyTracer *tracer = communication_->latencyTracer();
+
+    // a paint only counts as rendering the topics that view draws ( names as the client reports them )
+    auto topics = [this](const QStringList &names) {
+        QStringList out;
+        for (const QString &name : names) out.append(robotNamespace_ + name);
+        return out;
+    };
+
+    // gauges : QQuickWidget composes in its paintEvent
+    if (ros2ControlGaugeView_)
+    {
+        tracer->watchView(ros2ControlGaugeView_,
+                          topics({ "/diff_controller/cmd_vel_unstamped", "/diff_controller/odom", "/joint_states" }));
+    }
+
+    // charts : QChartView paints into its viewport
+    const QList<QPair<QWidget*, QStringList>> graphs = {
+        { odomDiffOdomImuHeadingGraphPtr_, topics({ "/diff_controller/odom", "/odom", "/imu/out" }) },
+        { odomDiffOdomPositionGraphPtr_,   topics({ "/diff_controller/odom", "/odom" }) },
+        { ekfPositionCovarianceGraphPtr_,  topics({ "/odom" }) },
+        { ekfHeadingCovarianceGraphPtr_,   topics({ "/odom" }) },
+    };
+    for (const auto &graph : graphs)
+    {
+        if (!graph.first) continue;
+        for (QGraphicsView *view : graph.first->findChildren<QGraphicsView*>())
+        {
+            tracer->watchView(view->viewport(), graph.second);
+        }
+    }
+}
+void MainWindow::refreshLatencyTable()
+{
+    if (!latencyTable_ || !communication_) return;
+    const LatencyTracer *tracer = communication_->latencyTracer();
+
+    if (tracer->hasClockOffset())
+    {
+        clockOffsetLabel_->setText(QString("clock offset : %1 ms  ( rtt %2 ms )")
+                                   .arg(tracer->clockOffsetNs() / 1e6, 0, 'f', 2)
+                                   .arg(tracer->clockSyncRttNs() / 1e6, 0, 'f', 2));
+    }
+
+    auto toMs = [](qint64 us) {
+        return us < 0 ? QString("-") : QString::number(us / 1000.0, 'f', 2);
+    };
+
+    const QList<LatencyTracer::TopicLatency> &topics = tracer->topics();
+    latencyTable_->setRowCount(topics.size());
+    for (int row = 0; row < topics.size(); ++row)
+    {
+        const LatencyTracer::TopicLatency &t = topics[row];
+        QStringList cells = { t.topic, QString::number(t.messages) };
+        for (int stage = 0; stage < LatencyTracer::StageCount; ++stage)
+        {
+            cells << toMs(t.stages[stage].percentile(0.50)) << toMs(t.stages[stage].percentile(0.99));
+        }
+
+        for (int col = 0; col < cells.size(); ++col)
+        {
+            QTableWidgetItem *item = latencyTable_->item(row, col);
+            if (!item)
+            {
+                item = new QTableWidgetItem();
+                latencyTable_->setItem(row, col, item);
+            }
+            item->setText(cells[col]);
+        }
+    }
 }
 void MainWindow::activateLogTab()
 {
+    if (latencyRefreshTimer_) latencyRefreshTimer_->start();
+    refreshLatencyTable();
+    if (logView_) logView_->setActive(true);
+
     //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
     //QString example_msg_type   = "geometry_msgs/msg/Twist";
     
@@ -1028,6 +1668,9 @@ void MainWindow::activateLogTab()
 }
 void MainWindow::deactivateLogTab()
 {
+    if (latencyRefreshTimer_) latencyRefreshTimer_->stop();
+    if (logView_) logView_->setActive(false);
+
     //QString example_topic_name = "/diff_controller/cmd_vel_unstamped";
     //QString example_msg_type   = "geometry_msgs/msg/Twist";
 
@@ -1040,22 +1683,24 @@ void MainWindow::deactivateLogTab()
 
 void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject &msg)
 {
+    /* LOG TAB ( any tab ) */
+    // stored first, the topic tab may monitor / inspect / plot /rosout as well
+    if( topic == robotNamespace_ + "/rosout" )
+    {
+        logStore_.append(msg);
+    }
+
     /* ROS2 CONTROL TAB */
     if( currentMode == Mode::ros2_control )
     {
        // topic name က /diff_controller/cmd_vel_unstamped 
         if( topic == "/diff_controller/cmd_vel_unstamped" )
         {
-            if (ros2ControlQmlView_.size() != 6) return;
+            if (!gaugeScheduler_) return;
 
-            QObject* root = ros2ControlQmlView_[0] ? ros2ControlQmlView_[0]->rootObject() : nullptr;
-            
             if ( msg.isEmpty() || !msg.contains("linear") ) 
             {
-                if (root) 
-                {
-                    root->setProperty("speed", 0.0);
-                }
+                gaugeScheduler_->setValue(CmdSpeedGauge, 0.0);
                 return;
             }
 
@@ -1070,12 +1715,8 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             
             speed = speed * 100.0; // convert to m/s for display
 
-
-            if (root) 
-            {
-                QVariant qmlSpeed = QVariant::fromValue(speed);
-                root->setProperty("speed", qmlSpeed);
-            }
+            // latest value only, pushed to the gauge on the next frame
+            gaugeScheduler_->setValue(CmdSpeedGauge, speed);
 
             int right_rpm = 0;
             int left_rpm  = 0;
@@ -1088,35 +1729,18 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             if( right_rpm < 0 ) { right_rpm *= -1; }
             if( left_rpm  < 0 ) { left_rpm  *= -1; }
         
-            // left rpm
-            QObject* left_root = ros2ControlQmlView_[1] ? ros2ControlQmlView_[1]->rootObject() : nullptr;
-            if (left_root)
-            {
-                QVariant qmlLeftRpm = QVariant::fromValue(left_rpm);
-                left_root->setProperty("speed", qmlLeftRpm);
-            }
-            // right rpm
-            QObject* right_root = ros2ControlQmlView_[2] ? ros2ControlQmlView_[2]->rootObject() : nullptr;
-            if (right_root)
-            {
-                QVariant qmlRightRpm = QVariant::fromValue(right_rpm);
-                right_root->setProperty("speed", qmlRightRpm);
-            }
+            gaugeScheduler_->setValue(CmdLeftRpmGauge, left_rpm);
+            gaugeScheduler_->setValue(CmdRightRpmGauge, right_rpm);
 
         }
         // topic name က /diff_controller/odom for Actual Robot Velocity
         else if( topic == "/diff_controller/odom" )
         {
-            if (ros2ControlQmlView_.size() != 6) return;
+            if (!gaugeScheduler_) return;
 
-            QObject* root = ros2ControlQmlView_[3] ? ros2ControlQmlView_[3]->rootObject() : nullptr;
-            
             if ( msg.isEmpty() || !msg.contains("twist") ) 
             {
-                if (root) 
-                {
-                    root->setProperty("speed", 0.0);
-                }
+                gaugeScheduler_->setValue(ActualSpeedGauge, 0.0);
                 return;
             }
 
@@ -1134,29 +1758,17 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             
             speed = speed * 100.0; // convert to m/s for display
 
-            if (root) 
-            {
-                QVariant qmlSpeed = QVariant::fromValue(speed);
-                root->setProperty("speed", qmlSpeed);
-            }
+            gaugeScheduler_->setValue(ActualSpeedGauge, speed);
         }
         // topic name က /joint_states for Actual Robot RPMs
         else if( topic == "/joint_states" )
         {
-            if (ros2ControlQmlView_.size() != 6) return;
-            QObject* leftActualRpmRoot  = ros2ControlQmlView_[4] ? ros2ControlQmlView_[4]->rootObject() : nullptr;
-            QObject* rightActualRpmRoot = ros2ControlQmlView_[5] ? ros2ControlQmlView_[5]->rootObject() : nullptr;
+            if (!gaugeScheduler_) return;
 
             if ( msg.isEmpty() || !msg.contains("name") || !msg.contains("velocity") ) 
             {
-                if (leftActualRpmRoot) 
-                {
-                    leftActualRpmRoot->setProperty("speed", 0.0);
-                }
-                if (rightActualRpmRoot) 
-                {
-                    rightActualRpmRoot->setProperty("speed", 0.0);
-                }
+                gaugeScheduler_->setValue(ActualLeftRpmGauge, 0.0);
+                gaugeScheduler_->setValue(ActualRightRpmGauge, 0.0);
                 return;
             }
 
@@ -1185,16 +1797,8 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             if( left_wheel_velocity < 0 ) { left_wheel_velocity *= -1; }
             if( right_wheel_velocity < 0 ) { right_wheel_velocity *= -1; }
 
-            if (leftActualRpmRoot)
-            {
-                QVariant qmlLeftActualRpm = QVariant::fromValue(static_cast<int>(left_wheel_velocity));
-                leftActualRpmRoot->setProperty("speed", qmlLeftActualRpm);
-            }
-            if (rightActualRpmRoot)
-            {
-                QVariant qmlRightActualRpm = QVariant::fromValue(static_cast<int>(right_wheel_velocity));
-                rightActualRpmRoot->setProperty("speed", qmlRightActualRpm);
-            }
+            gaugeScheduler_->setValue(ActualLeftRpmGauge, static_cast<int>(left_wheel_velocity));
+            gaugeScheduler_->setValue(ActualRightRpmGauge, static_cast<int>(right_wheel_velocity));
         }
     }
     
@@ -1205,20 +1809,8 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
     QString ekf_odom_topic_name = "/odom";
     QString odom_topic_name = "/diff_controller/odom";
     QString imu_topic_name = "/imu/out";
-        
-    static QPointF ekf_position;
-    static QPointF odom_position;
-    static double imu_heading = 0.0;
-    static double odom_heading = 0.0;
-    static double ekf_heading = 0.0;
-
-    // Covariances
-    static double ekf_x  = 0.0; static double ekf_y = 0.0; static double ekf_yaw = 0.0;
-
-    static double xx_cov = 0.0; static double xy_cov = 0.0;
-    static double yx_cov = 0.0; static double yy_cov = 0.0;
-    static double yaw_cov = 0.0;
 
+        // samples only, the graphs are drawn from one aligned snapshot per frame ( onEkfFrame )
         if( topic == ekf_odom_topic_name )
         {
             if ( msg.isEmpty() || !msg.contains("pose") ) 
@@ -1231,14 +1823,13 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             QJsonObject position = pose_child.value("position").toObject();
             double x = position.value("x").toDouble();
             double y = position.value("y").toDouble();
-            ekf_position = QPointF(x, y);
 
             QJsonObject orientation = pose_child.value("orientation").toObject();
             double qx = orientation.value("x").toDouble();
             double qy = orientation.value("y").toDouble();
             double qz = orientation.value("z").toDouble();
             double qw = orientation.value("w").toDouble();
-            ekf_heading = quaternionToYawDegrees(qx, qy, qz, qw);
+            double ekf_heading = quaternionToYawDegrees(qx, qy, qz, qw);
 
            QJsonArray covariance_array = pose.value("covariance").toArray();
 
@@ -1247,44 +1838,25 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
                 qDebug() << "Covariance array is invalid or incomplete.";
                 return; 
             }
-            
-            xx_cov = covariance_array.at(0).toDouble();
-            xy_cov = covariance_array.at(1).toDouble();
-            yx_cov = covariance_array.at(6).toDouble();
-            yy_cov = covariance_array.at(7).toDouble();
-            yaw_cov = covariance_array.at(35).toDouble();
-
-            Eigen::Matrix2d covariance_xy_matrix;
-            covariance_xy_matrix << xx_cov, xy_cov, yx_cov, yy_cov;
-
-            qDebug() << " EKF Odom Position: " << ekf_position << ", Heading: " << ekf_heading;
-            qDebug() << " Diff Odom Position: " << odom_position << ", Heading: " << odom_heading;
-            qDebug() << " EKF Odom Position Covariance: " << xx_cov << "," << xy_cov << "," << yx_cov << "," << yy_cov << "," << yaw_cov;
-
-           
-            ekf_x = x; ekf_y = y; //ekf_yaw = ekf_heading; ======================== for check
 
-            // xx_cov = position_covariance_obj.value("0").toDouble();
-            // xy_cov = position_covariance_obj.value("1").toDouble();
-            // yx_cov = position_covariance_obj.value("6").toDouble();
-            // yy_cov = position_covariance_obj.value("7").toDouble();
-            // yaw_cov= position_covariance_obj.value("35").toDouble();
+            const double t_sec = stampSeconds(msg);
+            ekfState_.addEkf(t_sec, QPointF(x, y), ekf_heading,
+                             covariance_array.at(0).toDouble(), covariance_array.at(1).toDouble(),
+                             covariance_array.at(6).toDouble(), covariance_array.at(7).toDouble(),
+                             covariance_array.at(35).toDouble());
 
-            if( ekfPositionCovarianceGraphPtr_ )
+            if( ekfCovarianceTimelinePtr_ )
             {
-                ekfPositionCovarianceGraphPtr_->updateGraph(ekf_x, ekf_y, covariance_xy_matrix);
-            }
-            if( ekfHeadingCovarianceGraphPtr_ )
-            {
-                ekfHeadingCovarianceGraphPtr_->updateGraph(ekf_heading, yaw_cov);
-            }
-            if( odomDiffOdomImuHeadingGraphPtr_ )
-            {
-                odomDiffOdomImuHeadingGraphPtr_->updateGraph(odom_heading, imu_heading, ekf_heading);
-            }
-            if( odomDiffOdomPositionGraphPtr_ )
-            {
-                odomDiffOdomPositionGraphPtr_->updateGraph(odom_position, ekf_position);
+                const QJsonArray twist_covariance_array = msg.value("twist").toObject().value("covariance").toArray();
+                double pose_cov[36];
+                double twist_cov[36] = {};
+                for (int i = 0; i < 36; ++i) pose_cov[i] = covariance_array.at(i).toDouble();
+                if (twist_covariance_array.size() == 36)
+                {
+                    for (int i = 0; i < 36; ++i) twist_cov[i] = twist_covariance_array.at(i).toDouble();
+                }
+
+                ekfCovarianceTimelinePtr_->append(t_sec, pose_cov, twist_cov);
             }
         }
         else if( topic == odom_topic_name )
@@ -1299,14 +1871,14 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             QJsonObject position = pose_child.value("position").toObject();
             double x = position.value("x").toDouble();
             double y = position.value("y").toDouble();
-            odom_position = QPointF(x, y);
 
             QJsonObject orientation = pose_child.value("orientation").toObject();
             double qx = orientation.value("x").toDouble();
             double qy = orientation.value("y").toDouble();
             double qz = orientation.value("z").toDouble();
             double qw = orientation.value("w").toDouble();
-            odom_heading = quaternionToYawDegrees(qx, qy, qz, qw);
+
+            ekfState_.addOdom(stampSeconds(msg), QPointF(x, y), quaternionToYawDegrees(qx, qy, qz, qw));
         }
         else if( topic == imu_topic_name )
         {
@@ -1326,27 +1898,92 @@ void MainWindow::onReceivedTopicMessage(const QString &topic, const QJsonObject
             double cosy_cosp = 1.0 - 2.0 * (qy * qy + qz * qz);
             double yaw = std::atan2(siny_cosp, cosy_cosp);
             double yaw_degrees = yaw * (180.0 / M_PI);
-            imu_heading = yaw_degrees;
+
+            ekfState_.addImu(stampSeconds(msg), yaw_degrees);
         }
     }
 
     /* CARTO TAB */
-    else if( currentMode == Mode::carto ) {}
+    else if( currentMode == Mode::carto )
+    {
+        // replay hands over decoded messages, a live client sends these raw ( onReceivedRawTopicMessage )
+        if( topic == "/map" && cartoGrid_ ) cartoGrid_->submitMessage(msg);
+        else if( topic == "/map_updates" && cartoGrid_ ) cartoGrid_->submitMessage(msg, true);
+        else if( topic == "/tracked_pose" && poseFromMessage(msg, cartoPosition_, cartoYaw_) )
+        {
+            if( cartoMap_ ) cartoMap_->setRobotPose(cartoPosition_.x(), cartoPosition_.y(), cartoYaw_);
+        }
+        else if( topic == "/scan" ) pushScan(msg, cartoPosition_, cartoYaw_, cartoMap_);
+    }
 
     /* NAV2 1 TAB */
-    else if( currentMode == Mode::nav2_1 ) {}
+    else if( currentMode == Mode::nav2_1 )
+    {
+        if( topic == "/map" && nav2Grid_ ) nav2Grid_->submitMessage(msg);
+        else if( topic.endsWith("/costmap") || topic.endsWith("/costmap_updates") )
+        {
+            for (const CostmapStats &stats : nav2Costmaps_)
+            {
+                const QString costmap = "/" + stats.name + "/costmap";
+                if (topic == costmap) stats.source->submitMessage(msg);
+                else if (topic == costmap + "_updates") stats.source->submitMessage(msg, true);
+            }
+        }
+        else if( topic == "/amcl_pose" && poseFromMessage(msg, nav2Position_, nav2Yaw_) )
+        {
+            if( nav2Map_ ) nav2Map_->setRobotPose(nav2Position_.x(), nav2Position_.y(), nav2Yaw_);
+        }
+        else if( topic == "/scan" ) pushScan(msg, nav2Position_, nav2Yaw_, nav2Map_);
+    }
 
     /* NAV2 2 TAB */
-    else if( currentMode == Mode::nav2_2 ) {}
+    else if( currentMode == Mode::nav2_2 )
+    {
+        if( topic == "/plan" )
+        {
+            const QVector<QPointF> plan = pathFromMessage(msg);
+            nav2Reinserted_ = nav2PlanIndex_.setPath(plan);
+            if( nav2TrackingMap_ ) nav2TrackingMap_->setPath(0, plan, QColor(QColorConstants::Svg::orange));
+        }
+        else if( topic == "/local_plan" )
+        {
+            if( nav2TrackingMap_ ) nav2TrackingMap_->setPath(1, pathFromMessage(msg), QColor("#00bfff"));
+        }
+        else if( topic == "/amcl_pose" )
+        {
+            QPointF position;
+            double yaw = 0.0;
+            if( poseFromMessage(msg, position, yaw) ) nav2MapOdom_.addMapPose(stampSeconds(msg), RomPose2D{ position.x(), position.y(), yaw });
+        }
+        else if( topic == "/cmd_vel" )
+        {
+            nav2CmdLinear_ = msg.value("linear").toObject().value("x").toDouble();
+            nav2CmdAngular_ = msg.value("angular").toObject().value("z").toDouble();
+            nav2CmdWallSec_ = QDateTime::currentMSecsSinceEpoch() / 1000.0;
+        }
+        else if( topic == "/odom" ) onNav2TrackingOdom(msg);
+    }
 
     /* NAV2 3 TAB */
     else if( currentMode == Mode::nav2_3 ) {}
 
     /* BT TAB */
-    else if( currentMode == Mode::bt ) {}
+    else if( currentMode == Mode::bt )
+    {
+        if( topic == "/behavior_tree_log" && btMonitor_ ) btMonitor_->applyLog(msg);
+    }
 
     /* TOPIC TAB */
-    else if( currentMode == Mode::topic ) {}
+    else if( currentMode == Mode::topic )
+    {
+        // replay hands over decoded messages, a live client sends these raw ( onReceivedRawTopicMessage )
+        if( topicMonitor_ && topicMonitor_->isMonitored(topic) )
+        {
+            topicMonitor_->onFrame(topic, QJsonDocument(msg).toJson(QJsonDocument::Compact).size());
+        }
+        if( messageInspector_ && topic == messageInspector_->topic() ) messageInspector_->setMessage(msg);
+        if( fieldPlots_ ) fieldPlots_->onMessage(topic, msg);
+    }
 
     /* LOG TAB */
     else if( currentMode == Mode::log ) {}
@@ -1368,6 +2005,201 @@ void MainWindow::robotVelocityToWheelRpms(double linear_velocity, double angular
     right_rpm = static_cast<int>((omega_right * 60.0) / (2.0 * M_PI));
 }
 
+void MainWindow::onReceivedRawTopicMessage(const QString &topic_name, const QByteArray &frame)
+{
+    // the topic tab switches what it monitors to raw frames, /rosout included
+    if (topic_name == robotNamespace_ + "/rosout")
+        logStore_.append(QJsonDocument::fromJson(frame).object().value("msg").toObject());
+
+    if (currentMode == Mode::topic && topicMonitor_)
+    {
+        topicMonitor_->onFrame(topic_name, frame.size());
+        const bool inspected = messageInspector_ && topic_name == messageInspector_->topic();
+
+        // plots need every sample : decoded once here, the inspector gets the same message
+        if (fieldPlots_ && fieldPlots_->hasTopic(topic_name))
+        {
+            const QJsonObject msg = QJsonDocument::fromJson(frame).object().value("msg").toObject();
+            fieldPlots_->onMessage(topic_name, msg);
+            if (inspected) messageInspector_->setMessage(msg);
+        }
+        else if (inspected) messageInspector_->setFrame(frame);
+        return;
+    }
+
+    QString topic = topic_name;
+    if (!robotNamespace_.isEmpty() && topic.startsWith(robotNamespace_)) topic.remove(0, robotNamespace_.size());
+
+    if (currentMode == Mode::carto && cartoGrid_)
+    {
+        if (topic == "/map") cartoGrid_->submitFrame(frame);
+        else if (topic == "/map_updates") cartoGrid_->submitFrame(frame, true);
+    }
+    else if (currentMode == Mode::nav2_1 && nav2Grid_)
+    {
+        if (topic == "/map") nav2Grid_->submitFrame(frame);
+        for (const CostmapStats &stats : nav2Costmaps_)
+        {
+            const QString costmap = "/" + stats.name + "/costmap";
+            if (topic == costmap) stats.source->submitFrame(frame);
+            else if (topic == costmap + "_updates") stats.source->submitFrame(frame, true);
+        }
+    }
+}
+void MainWindow::onEkfFrame()
+{
+    EkfSnapshot snapshot;
+    if (!ekfState_.snapshot(snapshot)) return;
+
+    Eigen::Matrix2d covariance_xy_matrix;
+    covariance_xy_matrix << snapshot.xx_cov, snapshot.xy_cov, snapshot.yx_cov, snapshot.yy_cov;
+
+    if( ekfPositionCovarianceGraphPtr_ )
+    {
+        ekfPositionCovarianceGraphPtr_->updateGraph(snapshot.ekf_position.x(), snapshot.ekf_position.y(), covariance_xy_matrix);
+    }
+    if( ekfHeadingCovarianceGraphPtr_ )
+    {
+        ekfHeadingCovarianceGraphPtr_->updateGraph(snapshot.ekf_heading, snapshot.yaw_cov);
+    }
+    if( odomDiffOdomImuHeadingGraphPtr_ )
+    {
+        odomDiffOdomImuHeadingGraphPtr_->updateGraph(snapshot.odom_heading, snapshot.imu_heading, snapshot.ekf_heading);
+    }
+    if( odomDiffOdomPositionGraphPtr_ )
+    {
+        odomDiffOdomPositionGraphPtr_->updateGraph(snapshot.odom_position, snapshot.ekf_position);
+    }
+}
+double MainWindow::stampSeconds(const QJsonObject &msg)
+{
+    // header.stamp, receive time for messages without one
+    const QJsonObject stamp = msg.value("header").toObject().value("stamp").toObject();
+    const double t_sec = stamp.value("sec").toDouble() + stamp.value("nanosec").toDouble() * 1e-9;
+    return t_sec > 0.0 ? t_sec : QDateTime::currentMSecsSinceEpoch() / 1000.0;
+}
+QVector<QPointF> MainWindow::pathFromMessage(const QJsonObject &msg)
+{
+    const QJsonArray poses = msg.value("poses").toArray();
+    QVector<QPointF> points;
+    points.reserve(poses.size());
+    for (const QJsonValue &pose : poses)
+    {
+        const QJsonObject position = pose.toObject().value("pose").toObject().value("position").toObject();
+        points.append(QPointF(position.value("x").toDouble(), position.value("y").toDouble()));
+    }
+    return points;
+}
+void MainWindow::onNav2TrackingOdom(const QJsonObject &msg)
+{
+    QPointF position;
+    double yaw = 0.0;
+    if (!poseFromMessage(msg, position, yaw)) return;
+
+    const double t_sec = stampSeconds(msg);
+    const RomPose2D odom{ position.x(), position.y(), yaw };
+    nav2MapOdom_.addOdom(t_sec, odom);
+    const RomPose2D pose = nav2MapOdom_.toMap(odom);
+
+    if (nav2TrackingMap_)
+    {
+        nav2TrackingMap_->setRobotPose(pose.x, pose.y, pose.yaw);
+
+        // trail in 2 cm steps
+        const QPointF here(pose.x, pose.y);
+        if (nav2Trail_.isEmpty() || QLineF(nav2Trail_.at(nav2Trail_.size() - 1), here).length() > 0.02)
+        {
+            nav2Trail_.push(here);
+            nav2TrackingMap_->setPath(2, nav2Trail_.toList(), QColor("#03fc84"));
+        }
+    }
+    if (!nav2TrackingGraph_) return;
+
+    double cross_track = qQNaN();
+    double heading = qQNaN();
+    RomPathIndex::Nearest nearest;
+    QElapsedTimer clock;
+    clock.start();
+    const bool on_plan = nav2PlanIndex_.nearest(QPointF(pose.x, pose.y), nearest);
+    const double query_us = clock.nsecsElapsed() / 1e3;
+    if (on_plan)
+    {
+        cross_track = nearest.signed_distance;
+        heading = romWrapAngle(pose.yaw - nearest.heading);
+        nav2QueryUs_ = nav2QueryUs_ > 0.0 ? 0.95 * nav2QueryUs_ + 0.05 * query_us : query_us;
+    }
+
+    // velocity tracking only while the controller is publishing
+    double linear = qQNaN();
+    double angular = qQNaN();
+    const double now = QDateTime::currentMSecsSinceEpoch() / 1000.0;
+    if (nav2CmdWallSec_ > 0.0 && now - nav2CmdWallSec_ < 0.5)
+    {
+        const QJsonObject twist = msg.value("twist").toObject().value("twist").toObject();
+        linear = nav2CmdLinear_ - twist.value("linear").toObject().value("x").toDouble();
+        angular = nav2CmdAngular_ - twist.value("angular").toObject().value("z").toDouble();
+    }
+
+    nav2TrackingGraph_->setIndexStats(nav2QueryUs_, nav2PlanIndex_.segmentCount(), nav2Reinserted_);
+    nav2TrackingGraph_->append(t_sec, cross_track, heading, linear, angular);
+}
+QQuickWidget *MainWindow::createMapWidget(QWidget *tab, QBoxLayout *layout, RomMapView *&map)
+{
+    RomMapView::registerQmlType();
+
+    QQuickWidget *widget = new QQuickWidget(tab);
+    widget->setResizeMode(QQuickWidget::SizeRootObjectToView);
+    widget->setClearColor(QColor("#2e2e2e"));
+    widget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    widget->setSource(QUrl(QStringLiteral("qrc:/MapView.qml")));
+    if (widget->status() != QQuickWidget::Ready) {
+        qWarning() << "Failed to load QML for the map view :" << widget->errors();
+    }
+    layout->addWidget(widget, 1);
+
+    map = widget->rootObject() ? widget->rootObject()->findChild<RomMapView*>("mapView") : nullptr;
+    return widget;
+}
+
+bool MainWindow::poseFromMessage(const QJsonObject &msg, QPointF &position, double &yaw)
+{
+    // PoseWithCovarianceStamped nests the pose once more
+    QJsonObject pose = msg.value("pose").toObject();
+    if (pose.contains("pose")) pose = pose.value("pose").toObject();
+    if (!pose.contains("position")) return false;
+
+    const QJsonObject p = pose.value("position").toObject();
+    const QJsonObject q = pose.value("orientation").toObject();
+    const double qx = q.value("x").toDouble();
+    const double qy = q.value("y").toDouble();
+    const double qz = q.value("z").toDouble();
+    const double qw = q.value("w").toDouble(1.0);
+
+    position = QPointF(p.value("x").toDouble(), p.value("y").toDouble());
+    yaw = std::atan2(2.0 * (qw * qz + qx * qy), 1.0 - 2.0 * (qy * qy + qz * qz));
+    return true;
+}
+
+void MainWindow::pushScan(const QJsonObject &msg, const QPointF &position, double yaw, RomMapView *map)
+{
+    if (!map) return;
+    const QJsonArray ranges = msg.value("ranges").toArray();
+    if (ranges.isEmpty()) return;
+
+    // null ( inf / NaN on the robot ) becomes 0 and is dropped by the range test
+    scanRanges_.resize(ranges.size());
+    double *r = scanRanges_.data();
+    for (const QJsonValue &value : ranges) *r++ = value.toDouble();
+
+    const QVector<QPointF> &points = scanProjector_.project(scanRanges_.constData(), scanRanges_.size(),
+                                                            msg.value("angle_min").toDouble(),
+                                                            msg.value("angle_increment").toDouble(),
+                                                            msg.value("range_min").toDouble(),
+                                                            msg.value("range_max").toDouble(),
+                                                            position.x(), position.y(), yaw);
+    map->pushScan(points);
+}
+
 double MainWindow::quaternionToYawDegrees(double &qx, double &qy, double &qz, double &qw)
 {
     double siny_cosp = 2.0 * (qw * qz + qx * qy);
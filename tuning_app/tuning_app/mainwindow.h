@@ -5,15 +5,43 @@
 #include <QJsonObject>
 #include "design/rom_structures.h"
 #include "communication/ros_bridge_client.hpp"
+#include "communication/subscription_manager.hpp"
+#include "communication/latency_tracer.hpp"
+#include "communication/session_capture.hpp"
+#include "communication/session_replay.hpp"
+#include "communication/session_pool.hpp"
+#include "communication/ekf_session_state.hpp"
+#include "communication/service_caller.hpp"
+#include "communication/log_store.hpp"
 #include <QString>
 #include <QQuickWidget>
+#include <QTableWidget>
+#include <QLabel>
+#include <QTimer>
+#include <QPushButton>
+#include <QComboBox>
+#include <QSlider>
+#include <QVBoxLayout>
 
 #include "design/rom_design.hpp"
 #include "design/covarianceDisplay.hpp"
+#include "design/gaugeScheduler.hpp"
+#include "design/occupancyGrid.hpp"
+#include "design/scanLayer.hpp"
+#include "design/pathTracking.hpp"
+#include "design/trackingDisplay.hpp"
+#include "design/parameterEditor.hpp"
+#include "design/behaviorTree.hpp"
+#include "design/topicMonitor.hpp"
+#include "design/messageInspector.hpp"
+#include "design/fieldPlot.hpp"
+#include "design/logView.hpp"
 
 using namespace rom_dynamics::communication;
 using namespace rom_dynamics::data_types;
 
+namespace rom_dynamics::ui::qt { class RomMapView; }
+
 QT_BEGIN_NAMESPACE
 namespace Ui {
 class MainWindow;
@@ -29,6 +57,7 @@ public:
     ~MainWindow();
 
     void createCommunicationClient(const QString &robot_ns, const QString &host, quint16 port);
+    RosBridgeClient *communicationClient() const { return communication_; }
 
     void initRos2ControlTab();
     void activateRos2ControlTab();
@@ -68,7 +97,30 @@ public:
 
     void robotVelocityToWheelRpms(double linear_velocity, double angular_velocity, double wheel_radius, double wheel_seperation, int &left_rpm, int &right_rpm);
 
+    void installLatencyRenderHooks();
+    void refreshLatencyTable();
+
+    void initSessionCapture();
+    void toggleRecording();
+    void openReplay();
+    void closeReplay();
+
+    void initSessionPool();
+    void toggleOverlaySession();
+
+    void initChartShortcuts();
+
+    void onEkfFrame();
+    static double stampSeconds(const QJsonObject &msg);
+
     double quaternionToYawDegrees(double &qx, double &qy, double &qz, double &qw);
+
+    // map canvas ( qrc:/MapView.qml ) added to the tab's layout
+    QQuickWidget *createMapWidget(QWidget *tab, QBoxLayout *layout, rom_dynamics::ui::qt::RomMapView *&map);
+    // geometry_msgs PoseStamped or PoseWithCovarianceStamped -> x, y, yaw ( rad )
+    static bool poseFromMessage(const QJsonObject &msg, QPointF &position, double &yaw);
+    // sensor_msgs LaserScan drawn from the given robot pose onto map
+    void pushScan(const QJsonObject &msg, const QPointF &position, double yaw, rom_dynamics::ui::qt::RomMapView *map);
     double yawDegreesToQuaternion(double &yaw_degrees, double &qx, double &qy, double &qz, double &qw);
 
 signals:
@@ -87,6 +139,8 @@ private slots:
 
     // from web socket
     void onReceivedTopicMessage(const QString &topic, const QJsonObject &msg);
+    void onReceivedSessionMessage(const QString &session_key, const QString &topic, const QJsonObject &msg);
+    void onReceivedRawTopicMessage(const QString &topic, const QByteArray &frame);
 
 
 protected:
@@ -105,9 +159,14 @@ private:
 
     Mode currentMode;
     RosBridgeClient *communication_ = nullptr;
+    SubscriptionManager *subscriptions_ = nullptr;
+    ServiceCaller *services_ = nullptr;     // call_service with ids, timeouts and a concurrency limit
 
-    // QRC speed meter
-    QVector<QQuickWidget*> ros2ControlQmlView_;
+    // QRC speed meters, one view ( Gauges.qml )
+    enum Ros2ControlGauge { CmdSpeedGauge, CmdLeftRpmGauge, CmdRightRpmGauge,
+                            ActualSpeedGauge, ActualLeftRpmGauge, ActualRightRpmGauge };
+    QQuickWidget *ros2ControlGaugeView_ = nullptr;
+    rom_dynamics::ui::qt::GaugeUpdateScheduler *gaugeScheduler_ = nullptr;
     QQuickItem *qmlRoot_ = nullptr;
     QTimer *qmlUpdateTimer_ = nullptr;
     QVector<QTimer*> speedTimeoutTimers_;
@@ -121,6 +180,102 @@ private:
     rom_dynamics::ui::qt::RomPositionGraph *odomDiffOdomPositionGraphPtr_ = nullptr;
     rom_dynamics::ui::qt::RomPositionCovarianceGraph *ekfPositionCovarianceGraphPtr_ = nullptr;
     rom_dynamics::ui::qt::RomYawCovarianceGraph *ekfHeadingCovarianceGraphPtr_ = nullptr;
+    rom_dynamics::ui::qt::RomCovarianceTimeline *ekfCovarianceTimelinePtr_ = nullptr;
+    QPushButton *ekfTimelineBtn_ = nullptr;
+    EkfSessionState ekfState_;          // ekf / odom / imu samples, drawn per frame
+    QTimer *ekfFrameTimer_ = nullptr;
+
+    // carto ( /map decoded off the ui thread, tiles in the scene graph )
+    QQuickWidget *cartoMapWidget_ = nullptr;
+    rom_dynamics::ui::qt::RomMapView *cartoMap_ = nullptr;
+    rom_dynamics::ui::qt::OccupancyGridSource *cartoGrid_ = nullptr;
+    QLabel *cartoStatusLabel_ = nullptr;
+    QPointF cartoPosition_;             // /tracked_pose
+    double cartoYaw_ = 0.0;
+
+    // nav2 1 ( /map, /scan and /amcl_pose )
+    QQuickWidget *nav2MapWidget_ = nullptr;
+    rom_dynamics::ui::qt::RomMapView *nav2Map_ = nullptr;
+    rom_dynamics::ui::qt::OccupancyGridSource *nav2Grid_ = nullptr;
+    QLabel *nav2StatusLabel_ = nullptr;
+    QPointF nav2Position_;              // /amcl_pose
+    double nav2Yaw_ = 0.0;
+
+    // costmaps over the map, layer 1 global, layer 2 local; timings of the last update
+    struct CostmapStats {
+        QString name;
+        rom_dynamics::ui::qt::OccupancyGridSource *source = nullptr;
+        QLabel *label = nullptr;
+        double parse_ms = 0.0;
+        double color_ms = 0.0;
+        int colored_tiles = 0;
+        double upload_ms = 0.0;
+        int uploaded_tiles = 0;
+    };
+    CostmapStats nav2Costmaps_[2];
+    void initCostmapLayer(int index, const QString &name, int layer, QVBoxLayout *layout);
+    void showCostmapStats(const CostmapStats &stats);
+
+    // nav2 2 ( controller tuning : /plan, /local_plan and the odom trail, tracking error per odom )
+    QQuickWidget *nav2TrackingMapWidget_ = nullptr;
+    rom_dynamics::ui::qt::RomMapView *nav2TrackingMap_ = nullptr;
+    rom_dynamics::ui::qt::RomTrackingErrorGraph *nav2TrackingGraph_ = nullptr;
+    rom_dynamics::ui::qt::RomPathIndex nav2PlanIndex_;
+    rom_dynamics::ui::qt::RomMapOdomCorrection nav2MapOdom_;    // /odom -> map through /amcl_pose
+    rom_dynamics::ui::qt::RomPointRing nav2Trail_{600};
+    double nav2CmdLinear_ = 0.0;
+    double nav2CmdAngular_ = 0.0;
+    double nav2CmdWallSec_ = -1.0;      // cmd_vel has no header, freshness by receive time
+    double nav2QueryUs_ = 0.0;          // smoothed nearest segment query time
+    int nav2Reinserted_ = 0;
+    static QVector<QPointF> pathFromMessage(const QJsonObject &msg);
+    void onNav2TrackingOdom(const QJsonObject &msg);
+
+    // nav2 3 ( live parameters of the ekf / nav2 nodes )
+    rom_dynamics::ui::qt::RomParameterEditor *parameterEditor_ = nullptr;
+
+    // bt ( /behavior_tree_log )
+    rom_dynamics::ui::qt::RomBtMonitor *btMonitor_ = nullptr;
+
+    // topic ( inventory + hz / bw / jitter of the checked topics )
+    rom_dynamics::ui::qt::RomTopicMonitor *topicMonitor_ = nullptr;
+    QSet<QString> topicRawTopics_;      // switched to raw by this tab, restored on leave
+    void setTopicMonitored(const QString &topic, const QString &type, bool on);
+    rom_dynamics::ui::qt::RomMessageInspector *messageInspector_ = nullptr;
+    QString inspectedType_;
+    void setTopicInspected(const QString &topic, const QString &type);
+    rom_dynamics::ui::qt::RomFieldPlotPanel *fieldPlots_ = nullptr;
+    QHash<QString, QString> plottedTypes_;
+    void setTopicPlotted(const QString &topic, const QString &type, bool on);
+
+    // laser scans ( shared by the map tabs, only one tab is active )
+    rom_dynamics::ui::qt::RomScanProjector scanProjector_;
+    QVector<double> scanRanges_;
+
+    // log ( latency )
+    QTableWidget *latencyTable_ = nullptr;
+    QLabel *clockOffsetLabel_ = nullptr;
+    QTimer *latencyRefreshTimer_ = nullptr;
+
+    // log ( /rosout, subscribed whatever tab is open )
+    LogStore logStore_;
+    rom_dynamics::ui::qt::RomLogView *logView_ = nullptr;
+
+    // session capture ( record on the ssh tab, replay bar at the bottom )
+    SessionRecorder *recorder_ = nullptr;
+    SessionReplay *replay_ = nullptr;
+    QPushButton *recordBtn_ = nullptr;
+    QPushButton *replayBtn_ = nullptr;
+    QWidget *replayBar_ = nullptr;
+    QPushButton *replayPlayBtn_ = nullptr;
+    QComboBox *replaySpeedCombo_ = nullptr;
+    QSlider *replaySlider_ = nullptr;
+    QLabel *replayTimeLabel_ = nullptr;
+
+    // extra robots overlaid on the ekf graphs ( one decode thread each )
+    RobotSessionPool *sessionPool_ = nullptr;
+    QPushButton *overlayRobotBtn_ = nullptr;
+    QHash<QString, QColor> sessionColors_;
 
 };
 #endif // MAINWINDOW_H
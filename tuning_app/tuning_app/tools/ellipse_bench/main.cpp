@@ -0,0 +1,116 @@
+#include "design/covarianceEllipse.hpp"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QtCharts/QChart>
+#include <QtCharts/QScatterSeries>
+#include <Eigen/Dense>
+#include <random>
+
+using namespace rom_dynamics::ui::qt;
+
+namespace {
+
+// drawPositionEllipse before the closed form kernel
+void legacyEllipse(const Eigen::Matrix2d &covariance_xy, QScatterSeries *series)
+{
+    Eigen::EigenSolver<Eigen::Matrix2d> es(covariance_xy);
+    Eigen::Vector2d eigenvalues = es.eigenvalues().real();
+    Eigen::Matrix2d eigenvectors = es.eigenvectors().real();
+
+    double k = 2.4477;
+    double major_axis = k * std::sqrt(eigenvalues(0));
+    double minor_axis = k * std::sqrt(eigenvalues(1));
+    double angle = std::atan2(eigenvectors(1, 0), eigenvectors(0, 0));
+
+    series->clear();
+    const int num_points = 50;
+    for (int i = 0; i <= num_points; ++i)
+    {
+        double theta = 2.0 * M_PI * i / num_points;
+        double x_rotated = major_axis * std::cos(theta);
+        double y_rotated = minor_axis * std::sin(theta);
+        series->append(x_rotated * std::cos(angle) - y_rotated * std::sin(angle),
+                       x_rotated * std::sin(angle) + y_rotated * std::cos(angle));
+    }
+}
+
+}
+
+// Covariance ellipse micro benchmark : EigenSolver + clear / append against the
+// closed form RomCovarianceEllipse + replace. Kernel only numbers exclude the series.
+//   ellipse_bench --iterations 200000
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ellipse_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("covariance ellipse micro benchmark");
+    parser.addHelpOption();
+    QCommandLineOption iterationsOpt("iterations", "Ellipses per variant.", "n", "200000");
+    parser.addOption(iterationsOpt);
+    parser.process(app);
+
+    const int iterations = qMax(1, parser.value(iterationsOpt).toInt());
+
+    // random positive definite covariances, same set for every variant
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    QList<Eigen::Matrix2d> covariances;
+    for (int i = 0; i < 1024; ++i)
+    {
+        Eigen::Matrix2d a;
+        a << uniform(rng), uniform(rng), uniform(rng), uniform(rng);
+        covariances.append(a * a.transpose() + 1e-6 * Eigen::Matrix2d::Identity());
+    }
+
+    QChart chart;
+    QScatterSeries *series = new QScatterSeries();
+    chart.addSeries(series);
+
+    RomCovarianceEllipse ellipse;
+    double sink = 0.0;
+    QElapsedTimer clock;
+
+    auto report = [&](const char *name, qint64 ns) {
+        QTextStream(stdout) << QString("%1 %2 ns / ellipse\n").arg(name, -28).arg(double(ns) / iterations, 0, 'f', 1);
+    };
+
+    clock.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        legacyEllipse(covariances[i & 1023], series);
+    }
+    report("eigensolver + append", clock.nsecsElapsed());
+
+    clock.restart();
+    for (int i = 0; i < iterations; ++i)
+    {
+        const Eigen::Matrix2d &c = covariances[i & 1023];
+        series->replace(ellipse.points(c(0, 0), c(0, 1), c(1, 1)));
+    }
+    report("closed form + replace", clock.nsecsElapsed());
+
+    // kernels alone
+    clock.restart();
+    for (int i = 0; i < iterations; ++i)
+    {
+        Eigen::EigenSolver<Eigen::Matrix2d> es(covariances[i & 1023]);
+        sink += es.eigenvalues().real()(0);
+    }
+    report("eigensolver only", clock.nsecsElapsed());
+
+    clock.restart();
+    for (int i = 0; i < iterations; ++i)
+    {
+        const Eigen::Matrix2d &c = covariances[i & 1023];
+        sink += ellipse.points(c(0, 0), c(0, 1), c(1, 1)).last().x();
+    }
+    report("closed form points only", clock.nsecsElapsed());
+
+    QTextStream(stdout) << "checksum " << sink << "\n";
+    return 0;
+}
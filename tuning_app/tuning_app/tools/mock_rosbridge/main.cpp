@@ -0,0 +1,86 @@
+#include "mock_rosbridge_server.hpp"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QTimer>
+
+using namespace rom_dynamics::tools;
+
+// mock_rosbridge --port 9090 --rate /odom=30 --rate /joint_states=1000 --joints 12 --duration 60
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mock_rosbridge");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("rosbridge v2 mock server with synthetic tuning_app topics");
+    parser.addHelpOption();
+
+    QCommandLineOption portOpt("port", "WebSocket port.", "port", "9090");
+    QCommandLineOption nsOpt("ns", "Robot namespace prefix for every topic.", "ns", "");
+    QCommandLineOption rateOpt("rate", "Per topic rate, <topic>=<hz>. Repeatable.", "topic=hz");
+    QCommandLineOption scaleOpt("scale", "Multiply every rate ( load test ).", "factor", "1.0");
+    QCommandLineOption jointsOpt("joints", "Joints per /joint_states message ( message size ).", "count", "2");
+    QCommandLineOption padOpt("frame-pad", "Extra bytes in every frame_id ( message size ).", "bytes", "0");
+    QCommandLineOption durationOpt("duration", "Exit after N seconds ( 0 = run forever ).", "seconds", "0");
+    parser.addOptions({ portOpt, nsOpt, rateOpt, scaleOpt, jointsOpt, padOpt, durationOpt });
+    parser.process(app);
+
+    // defaults roughly match a real robot
+    QList<QPair<QString, double>> rates = {
+        { "/odom", 30.0 },
+        { "/diff_controller/odom", 50.0 },
+        { "/imu/out", 100.0 },
+        { "/joint_states", 50.0 },
+        { "/diff_controller/cmd_vel_unstamped", 20.0 },
+    };
+    for (const QString &spec : parser.values(rateOpt))
+    {
+        const QString topic = spec.section('=', 0, 0);
+        const double hz = spec.section('=', 1, 1).toDouble();
+        bool found = false;
+        for (auto &rate : rates)
+        {
+            if (rate.first == topic) { rate.second = hz; found = true; }
+        }
+        if (!found) rates.append({ topic, hz });
+    }
+
+    const double scale = parser.value(scaleOpt).toDouble();
+    const int joints = parser.value(jointsOpt).toInt();
+    const int frame_pad = parser.value(padOpt).toInt();
+
+    MockRosBridgeServer server(parser.value(nsOpt));
+    QTextStream out(stdout);
+    QObject::connect(&server, &MockRosBridgeServer::statsReport, &app, [&out](const QString &line) {
+        out << line << Qt::endl;
+    });
+
+    for (const auto &rate : rates)
+    {
+        auto generator = makeGenerator(rate.first, rate.second * scale, joints, frame_pad);
+        if (!generator)
+        {
+            out << "unknown topic " << rate.first << ", ignored" << Qt::endl;
+            continue;
+        }
+        out << rate.first << " @ " << rate.second * scale << " Hz" << Qt::endl;
+        server.addGenerator(std::move(generator));
+    }
+
+    if (!server.listen(parser.value(portOpt).toUShort())) return 1;
+    out << "listening on ws://0.0.0.0:" << parser.value(portOpt) << Qt::endl;
+
+    const int duration = parser.value(durationOpt).toInt();
+    if (duration > 0)
+    {
+        QTimer::singleShot(duration * 1000, &app, [&]() {
+            out << "sent " << server.totalMessagesSent() << " messages, "
+                << server.totalBytesSent() / 1024 << " KiB" << Qt::endl;
+            app.quit();
+        });
+    }
+
+    return app.exec();
+}
@@ -0,0 +1,229 @@
+#include "mock_rosbridge_server.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+rom_dynamics::tools::MockRosBridgeServer::MockRosBridgeServer(const QString &robot_ns, QObject *parent)
+    : QObject(parent)
+    , m_robotNamespace(robot_ns)
+    , m_server(QStringLiteral("rom mock rosbridge"), QWebSocketServer::NonSecureMode)
+{
+    connect(&m_server, &QWebSocketServer::newConnection, this, &MockRosBridgeServer::onNewConnection);
+
+    m_tickTimer.setTimerType(Qt::PreciseTimer);
+    m_tickTimer.setInterval(1);
+    connect(&m_tickTimer, &QTimer::timeout, this, &MockRosBridgeServer::onTick);
+
+    m_statsTimer.setInterval(1000);
+    connect(&m_statsTimer, &QTimer::timeout, this, &MockRosBridgeServer::onStats);
+}
+
+rom_dynamics::tools::MockRosBridgeServer::~MockRosBridgeServer()
+{
+    m_server.close();
+    qDeleteAll(m_clients.keys());
+}
+
+bool rom_dynamics::tools::MockRosBridgeServer::listen(quint16 port)
+{
+    if (!m_server.listen(QHostAddress::Any, port))
+    {
+        qWarning() << "mock rosbridge : cannot listen on" << port << ":" << m_server.errorString();
+        return false;
+    }
+
+    m_clock.start();
+    m_tickTimer.start();
+    m_statsTimer.start();
+    return true;
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::addGenerator(std::unique_ptr<TopicGenerator> generator)
+{
+    if (generator) m_generators.push_back(std::move(generator));
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::onNewConnection()
+{
+    while (m_server.hasPendingConnections())
+    {
+        QWebSocket *client = m_server.nextPendingConnection();
+        m_clients.insert(client, ClientState{});
+
+        connect(client, &QWebSocket::textMessageReceived, this, &MockRosBridgeServer::onTextMessageReceived);
+        connect(client, &QWebSocket::disconnected, this, &MockRosBridgeServer::onClientDisconnected);
+
+        emit statsReport(QString("client connected : %1").arg(client->peerAddress().toString()));
+    }
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::onClientDisconnected()
+{
+    QWebSocket *client = qobject_cast<QWebSocket*>(sender());
+    if (!client) return;
+
+    m_clients.remove(client);
+    client->deleteLater();
+    emit statsReport("client disconnected");
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::onTextMessageReceived(const QString &message)
+{
+    QWebSocket *client = qobject_cast<QWebSocket*>(sender());
+    if (!client || !m_clients.contains(client)) return;
+
+    const QJsonObject obj = QJsonDocument::fromJson(message.toUtf8()).object();
+    const QString op = obj.value("op").toString();
+
+    if (op == "subscribe")
+    {
+        m_clients[client].subscriptions.insert(obj.value("topic").toString());
+    }
+    else if (op == "unsubscribe")
+    {
+        m_clients[client].subscriptions.remove(obj.value("topic").toString());
+    }
+    else if (op == "publish")
+    {
+        handlePublish(client, obj);
+    }
+    else if (op == "call_service")
+    {
+        handleCallService(client, obj);
+    }
+    // advertise / unadvertise need no state here
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::handlePublish(QWebSocket *client, const QJsonObject &obj)
+{
+    // loop client publishes back to every other subscriber, like a real topic
+    const QString topic = obj.value("topic").toString();
+    QJsonObject frame;
+    frame["op"] = "publish";
+    frame["topic"] = topic;
+    frame["msg"] = obj.value("msg");
+
+    for (auto it = m_clients.constBegin(); it != m_clients.constEnd(); ++it)
+    {
+        if (it.key() != client && it->subscriptions.contains(topic))
+        {
+            sendJson(it.key(), frame);
+        }
+    }
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::handleCallService(QWebSocket *client, const QJsonObject &obj)
+{
+    QString service = obj.value("service").toString();
+    if (!m_robotNamespace.isEmpty() && service.startsWith(m_robotNamespace))
+    {
+        service = service.mid(m_robotNamespace.size());
+    }
+
+    QJsonObject response;
+    response["op"] = "service_response";
+    response["service"] = obj.value("service");
+    if (obj.contains("id")) response["id"] = obj.value("id");
+
+    QJsonObject values;
+    bool result = true;
+
+    if (service == "/rosapi/get_time")
+    {
+        const qint64 now_ns = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+        values["time"] = QJsonObject{ {"sec", now_ns / 1000000000LL}, {"nanosec", now_ns % 1000000000LL} };
+    }
+    else if (service == "/rosapi/topics")
+    {
+        QJsonArray topics, types;
+        for (const auto &generator : m_generators)
+        {
+            topics.append(m_robotNamespace + generator->topic());
+            types.append(generator->type());
+        }
+        values["topics"] = topics;
+        values["types"] = types;
+    }
+    else
+    {
+        result = false;
+        values["message"] = QString("mock rosbridge : service %1 not available").arg(service);
+    }
+
+    response["result"] = result;
+    response["values"] = values;
+    sendJson(client, response);
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::sendJson(QWebSocket *client, const QJsonObject &obj)
+{
+    client->sendTextMessage(QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::onTick()
+{
+    if (m_clients.isEmpty()) return;
+
+    const double t = m_clock.nsecsElapsed() / 1e9;
+
+    for (const auto &generator : m_generators)
+    {
+        const quint64 owed = generator->due(t);
+        if (owed == 0) continue;
+
+        const QString topic = m_robotNamespace + generator->topic();
+
+        // nobody listening -> still advance the generator so rates stay honest
+        QList<QWebSocket*> receivers;
+        for (auto it = m_clients.constBegin(); it != m_clients.constEnd(); ++it)
+        {
+            if (it->subscriptions.contains(topic)) receivers.append(it.key());
+        }
+        if (receivers.isEmpty()) continue;
+
+        for (quint64 n = 0; n < owed; ++n)
+        {
+            QByteArray frame = generator->next(t);
+            if (!m_robotNamespace.isEmpty())
+            {
+                frame.replace(QByteArray(R"("topic":")") + generator->topic().toUtf8(),
+                              QByteArray(R"("topic":")") + topic.toUtf8());
+            }
+            const QString text = QString::fromUtf8(frame);
+            for (QWebSocket *client : std::as_const(receivers))
+            {
+                client->sendTextMessage(text);
+            }
+
+            m_intervalMessages[generator->topic()] += receivers.size();
+            m_intervalBytes += quint64(frame.size()) * receivers.size();
+        }
+    }
+}
+
+void rom_dynamics::tools::MockRosBridgeServer::onStats()
+{
+    quint64 messages = 0;
+    QStringList parts;
+    for (auto it = m_intervalMessages.constBegin(); it != m_intervalMessages.constEnd(); ++it)
+    {
+        parts << QString("%1 %2/s").arg(it.key()).arg(it.value());
+        messages += it.value();
+    }
+
+    m_totalMessages += messages;
+    m_totalBytes += m_intervalBytes;
+
+    if (messages > 0)
+    {
+        emit statsReport(QString("%1 msg/s, %2 KiB/s | %3")
+                         .arg(messages)
+                         .arg(m_intervalBytes / 1024)
+                         .arg(parts.join(", ")));
+    }
+
+    m_intervalMessages.clear();
+    m_intervalBytes = 0;
+}
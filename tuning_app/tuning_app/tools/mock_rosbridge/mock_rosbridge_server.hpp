@@ -0,0 +1,72 @@
+#ifndef ROM_MOCK_ROSBRIDGE_SERVER_HPP
+#define ROM_MOCK_ROSBRIDGE_SERVER_HPP
+
+#pragma once
+#include <QObject>
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QJsonObject>
+#include <memory>
+#include <vector>
+
+#include "topic_generators.hpp"
+
+namespace rom_dynamics::tools {
+
+// Minimal rosbridge v2 server : subscribe / unsubscribe / advertise / publish and
+// the /rosapi services the tuning_app uses. Publishes synthetic streams from TopicGenerators.
+class MockRosBridgeServer : public QObject {
+    Q_OBJECT
+public:
+    explicit MockRosBridgeServer(const QString &robot_ns = "", QObject *parent = nullptr);
+    ~MockRosBridgeServer() override;
+
+    bool listen(quint16 port);
+    void addGenerator(std::unique_ptr<TopicGenerator> generator);
+    void setStatsInterval(int interval_ms) { m_statsTimer.setInterval(interval_ms); }
+
+    quint64 totalMessagesSent() const { return m_totalMessages; }
+    quint64 totalBytesSent() const { return m_totalBytes; }
+
+signals:
+    void statsReport(const QString &line);
+
+private slots:
+    void onNewConnection();
+    void onTextMessageReceived(const QString &message);
+    void onClientDisconnected();
+    void onTick();
+    void onStats();
+
+private:
+    struct ClientState {
+        QSet<QString> subscriptions;
+    };
+
+    void handleCallService(QWebSocket *client, const QJsonObject &obj);
+    void handlePublish(QWebSocket *client, const QJsonObject &obj);
+    void sendJson(QWebSocket *client, const QJsonObject &obj);
+
+    QString m_robotNamespace;
+    QWebSocketServer m_server;
+    QHash<QWebSocket*, ClientState> m_clients;
+
+    std::vector<std::unique_ptr<TopicGenerator>> m_generators;
+
+    // 1 ms tick; generators owe floor(t * rate) messages, higher rates go out in bursts
+    QTimer m_tickTimer;
+    QElapsedTimer m_clock;
+
+    QTimer m_statsTimer;
+    QHash<QString, quint64> m_intervalMessages;
+    quint64 m_intervalBytes{0};
+    quint64 m_totalMessages{0};
+    quint64 m_totalBytes{0};
+};
+}
+
+#endif
@@ -0,0 +1,210 @@
+#include "topic_generators.hpp"
+
+#include <cmath>
+#include <QDateTime>
+
+using namespace rom_dynamics::tools;
+
+quint64 rom_dynamics::tools::TopicGenerator::due(double t)
+{
+    if (rate_hz_ <= 0.0) return 0;
+
+    const quint64 expected = static_cast<quint64>(t * rate_hz_);
+    const quint64 owed = expected > sent_ ? expected - sent_ : 0;
+    sent_ = expected;
+    return owed;
+}
+
+QByteArray rom_dynamics::tools::TopicGenerator::beginFrame() const
+{
+    QByteArray out;
+    out.reserve(1024);
+    out += R"({"op":"publish","topic":")";
+    out += topic_.toUtf8();
+    out += R"(","msg":{)";
+    return out;
+}
+
+void rom_dynamics::tools::TopicGenerator::appendStamp(QByteArray &out, double t, const QByteArray &frame_id)
+{
+    // header.stamp uses the wall clock so the tuning_app latency tracer sees real network delay
+    Q_UNUSED(t);
+    const qint64 now_ns = QDateTime::currentMSecsSinceEpoch() * 1000000LL;
+    out += R"("header":{"stamp":{"sec":)";
+    out += QByteArray::number(now_ns / 1000000000LL);
+    out += R"(,"nanosec":)";
+    out += QByteArray::number(now_ns % 1000000000LL);
+    out += R"(},"frame_id":")";
+    out += frame_id;
+    out += R"("})";
+}
+
+//================================================================================
+// Odometry
+//================================================================================
+
+rom_dynamics::tools::OdometryGenerator::OdometryGenerator(const QString &topic, double rate_hz, double drift, const QByteArray &frame_id)
+    : TopicGenerator(topic, "nav_msgs/msg/Odometry", rate_hz), drift_(drift), frame_id_(frame_id)
+{
+}
+
+QByteArray rom_dynamics::tools::OdometryGenerator::next(double t)
+{
+    const double yaw = MockTrajectory::yaw(t) * (1.0 + drift_);
+    const double x = MockTrajectory::x(t) * (1.0 + drift_) + noise(0.002);
+    const double y = MockTrajectory::y(t) * (1.0 + drift_) + noise(0.002);
+
+    // covariance grows while driving, like an ekf without absolute corrections
+    const double var_xy  = 0.001 + 0.0005 * t * (1.0 + drift_);
+    const double var_yaw = 0.0005 + 0.0002 * t;
+
+    QByteArray out = beginFrame();
+    appendStamp(out, t, frame_id_);
+    out += R"(,"child_frame_id":"base_link","pose":{"pose":{"position":{"x":)";
+    appendNumber(out, x);
+    out += R"(,"y":)";
+    appendNumber(out, y);
+    out += R"(,"z":0.0},"orientation":{"x":0.0,"y":0.0,"z":)";
+    appendNumber(out, std::sin(yaw / 2.0));
+    out += R"(,"w":)";
+    appendNumber(out, std::cos(yaw / 2.0));
+    out += R"(}},"covariance":[)";
+    for (int i = 0; i < 36; ++i)
+    {
+        if (i) out += ',';
+        double v = 0.0;
+        if (i == 0 || i == 7) v = var_xy;
+        else if (i == 1 || i == 6) v = var_xy * 0.3;
+        else if (i == 35) v = var_yaw;
+        appendNumber(out, v);
+    }
+    out += R"(]},"twist":{"twist":{"linear":{"x":)";
+    appendNumber(out, MockTrajectory::kLinear + noise(0.01));
+    out += R"(,"y":0.0,"z":0.0},"angular":{"x":0.0,"y":0.0,"z":)";
+    appendNumber(out, MockTrajectory::angular() + noise(0.005));
+    out += R"(}},"covariance":[)";
+    for (int i = 0; i < 36; ++i)
+    {
+        if (i) out += ',';
+        out += (i % 7 == 0) ? "0.001" : "0.0";
+    }
+    out += "]}}}";
+    return out;
+}
+
+//================================================================================
+// Imu
+//================================================================================
+
+rom_dynamics::tools::ImuGenerator::ImuGenerator(const QString &topic, double rate_hz, const QByteArray &frame_id)
+    : TopicGenerator(topic, "sensor_msgs/msg/Imu", rate_hz), frame_id_(frame_id)
+{
+}
+
+QByteArray rom_dynamics::tools::ImuGenerator::next(double t)
+{
+    const double yaw = MockTrajectory::yaw(t) + noise(0.01);
+
+    QByteArray out = beginFrame();
+    appendStamp(out, t, frame_id_);
+    out += R"(,"orientation":{"x":0.0,"y":0.0,"z":)";
+    appendNumber(out, std::sin(yaw / 2.0));
+    out += R"(,"w":)";
+    appendNumber(out, std::cos(yaw / 2.0));
+    out += R"(},"orientation_covariance":[0.0001,0,0,0,0.0001,0,0,0,0.0001],"angular_velocity":{"x":0.0,"y":0.0,"z":)";
+    appendNumber(out, MockTrajectory::angular() + noise(0.02));
+    out += R"(},"angular_velocity_covariance":[0.0004,0,0,0,0.0004,0,0,0,0.0004],"linear_acceleration":{"x":)";
+    appendNumber(out, noise(0.05));
+    out += R"(,"y":)";
+    appendNumber(out, MockTrajectory::kLinear * MockTrajectory::angular() + noise(0.05));
+    out += R"(,"z":9.81},"linear_acceleration_covariance":[0.01,0,0,0,0.01,0,0,0,0.01]}})";
+    return out;
+}
+
+//================================================================================
+// JointState
+//================================================================================
+
+rom_dynamics::tools::JointStateGenerator::JointStateGenerator(const QString &topic, double rate_hz, int joint_count, const QByteArray &frame_id)
+    : TopicGenerator(topic, "sensor_msgs/msg/JointState", rate_hz), joint_count_(qMax(2, joint_count)), frame_id_(frame_id)
+{
+}
+
+QByteArray rom_dynamics::tools::JointStateGenerator::next(double t)
+{
+    // wheel_radius 0.1 m, wheel_seperation 0.4 m like MainWindow
+    const double v = MockTrajectory::kLinear;
+    const double w = MockTrajectory::angular();
+    const double left  = (v - w * 0.2) / 0.1 + noise(0.05);
+    const double right = (v + w * 0.2) / 0.1 + noise(0.05);
+
+    QByteArray out = beginFrame();
+    appendStamp(out, t, frame_id_);
+    out += R"(,"name":["left_wheel_joint","right_wheel_joint")";
+    for (int i = 2; i < joint_count_; ++i)
+    {
+        out += R"(,"joint_)";
+        out += QByteArray::number(i);
+        out += '"';
+    }
+    out += R"(],"position":[)";
+    appendNumber(out, left * t);
+    out += ',';
+    appendNumber(out, right * t);
+    for (int i = 2; i < joint_count_; ++i) out += ",0.0";
+    out += R"(],"velocity":[)";
+    appendNumber(out, left);
+    out += ',';
+    appendNumber(out, right);
+    for (int i = 2; i < joint_count_; ++i) out += ",0.0";
+    out += R"(],"effort":[]}})";
+    return out;
+}
+
+//================================================================================
+// Twist ( cmd_vel_unstamped )
+//================================================================================
+
+rom_dynamics::tools::TwistGenerator::TwistGenerator(const QString &topic, double rate_hz)
+    : TopicGenerator(topic, "geometry_msgs/msg/Twist", rate_hz)
+{
+}
+
+QByteArray rom_dynamics::tools::TwistGenerator::next(double t)
+{
+    Q_UNUSED(t);
+    QByteArray out = beginFrame();
+    out += R"("linear":{"x":)";
+    appendNumber(out, MockTrajectory::kLinear);
+    out += R"(,"y":0.0,"z":0.0},"angular":{"x":0.0,"y":0.0,"z":)";
+    appendNumber(out, MockTrajectory::angular());
+    out += "}}}";
+    return out;
+}
+
+//================================================================================
+// Factory
+//================================================================================
+
+std::unique_ptr<TopicGenerator> rom_dynamics::tools::makeGenerator(const QString &topic, double rate_hz, int joint_count, int frame_pad)
+{
+    // frame_pad inflates every stamped message by a longer frame_id
+    auto frameId = [frame_pad](const char *base) {
+        QByteArray id(base);
+        if (frame_pad > 0) id += '_' + QByteArray(frame_pad, 'x');
+        return id;
+    };
+
+    if (topic == "/odom")
+        return std::make_unique<OdometryGenerator>(topic, rate_hz, 0.0, frameId("odom"));
+    if (topic == "/diff_controller/odom")
+        return std::make_unique<OdometryGenerator>(topic, rate_hz, 0.03, frameId("odom"));
+    if (topic == "/imu/out")
+        return std::make_unique<ImuGenerator>(topic, rate_hz, frameId("imu_link"));
+    if (topic == "/joint_states")
+        return std::make_unique<JointStateGenerator>(topic, rate_hz, joint_count, frameId("base_link"));
+    if (topic == "/diff_controller/cmd_vel_unstamped")
+        return std::make_unique<TwistGenerator>(topic, rate_hz);
+
+    return nullptr;
+}
@@ -0,0 +1,94 @@
+#ifndef ROM_MOCK_TOPIC_GENERATORS_HPP
+#define ROM_MOCK_TOPIC_GENERATORS_HPP
+
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <QRandomGenerator>
+#include <memory>
+#include <cmath>
+
+namespace rom_dynamics::tools {
+
+// Synthetic ROS 2 message source. next() returns the complete rosbridge v2
+// publish frame ( {"op":"publish","topic":..,"msg":{..}} ) for time t [s].
+class TopicGenerator {
+public:
+    TopicGenerator(const QString &topic, const QString &type, double rate_hz)
+        : topic_(topic), type_(type), rate_hz_(rate_hz) {}
+    virtual ~TopicGenerator() = default;
+
+    const QString &topic() const { return topic_; }
+    const QString &type() const { return type_; }
+    double rate() const { return rate_hz_; }
+    void setRate(double rate_hz) { rate_hz_ = rate_hz; }
+
+    // messages owed at time t since start, advances the internal counter
+    quint64 due(double t);
+
+    virtual QByteArray next(double t) = 0;
+
+protected:
+    QByteArray beginFrame() const;
+    static void appendStamp(QByteArray &out, double t, const QByteArray &frame_id);
+    static void appendNumber(QByteArray &out, double v) { out += QByteArray::number(v, 'g', 9); }
+    double noise(double sigma) { return (rng_.generateDouble() * 2.0 - 1.0) * sigma; }
+
+    QString topic_;
+    QString type_;
+    double rate_hz_ = 0.0;
+    quint64 sent_ = 0;
+    QRandomGenerator rng_{42};
+};
+
+// Robot drives a circle; diff_controller odom drifts, ekf odom carries a growing covariance.
+class OdometryGenerator : public TopicGenerator {
+public:
+    OdometryGenerator(const QString &topic, double rate_hz, double drift, const QByteArray &frame_id);
+    QByteArray next(double t) override;
+
+private:
+    double drift_ = 0.0;
+    QByteArray frame_id_;
+};
+
+class ImuGenerator : public TopicGenerator {
+public:
+    ImuGenerator(const QString &topic, double rate_hz, const QByteArray &frame_id);
+    QByteArray next(double t) override;
+
+private:
+    QByteArray frame_id_;
+};
+
+// joint_count controls the message size ( two wheel joints + padding joints )
+class JointStateGenerator : public TopicGenerator {
+public:
+    JointStateGenerator(const QString &topic, double rate_hz, int joint_count, const QByteArray &frame_id);
+    QByteArray next(double t) override;
+
+private:
+    int joint_count_ = 2;
+    QByteArray frame_id_;
+};
+
+class TwistGenerator : public TopicGenerator {
+public:
+    TwistGenerator(const QString &topic, double rate_hz);
+    QByteArray next(double t) override;
+};
+
+// shared trajectory so every generator describes the same robot
+struct MockTrajectory {
+    static constexpr double kLinear  = 0.4;   // m/s
+    static constexpr double kRadius  = 2.0;   // m
+    static double yaw(double t) { return t * kLinear / kRadius; }
+    static double x(double t)   { return kRadius * std::sin(yaw(t)); }
+    static double y(double t)   { return kRadius * (1.0 - std::cos(yaw(t))); }
+    static double angular()     { return kLinear / kRadius; }
+};
+
+std::unique_ptr<TopicGenerator> makeGenerator(const QString &topic, double rate_hz, int joint_count, int frame_pad);
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "mainwindow.h"
+#include "communication/ros_bridge_client.hpp"
+#include "communication/latency_tracer.hpp"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTabWidget>
+#include <QTextStream>
+#include <QTimer>
+
+using namespace rom_dynamics::communication;
+
+// Stress / benchmark client for RosBridgeClient and MainWindow against mock_rosbridge.
+//   rosbridge_bench --port 9090 --duration 10                       ( bare client )
+//   rosbridge_bench --port 9090 --duration 10 --mainwindow --tab 2  ( full UI on the ekf tab )
+// Prints one JSON summary line; exits 1 if --min-rate is not reached.
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("rosbridge_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("tuning_app rosbridge load test client");
+    parser.addHelpOption();
+
+    QCommandLineOption hostOpt("host", "rosbridge host.", "host", "127.0.0.1");
+    QCommandLineOption portOpt("port", "rosbridge port.", "port", "9090");
+    QCommandLineOption nsOpt("ns", "Robot namespace.", "ns", "");
+    QCommandLineOption durationOpt("duration", "Measurement time in seconds.", "seconds", "10");
+    QCommandLineOption warmupOpt("warmup", "Seconds ignored before measuring.", "seconds", "1");
+    QCommandLineOption mainWindowOpt("mainwindow", "Drive the full MainWindow instead of a bare client.");
+    QCommandLineOption tabOpt("tab", "MainWindow tab index to activate ( 1 ros2_control, 2 ekf ).", "index", "2");
+    QCommandLineOption minRateOpt("min-rate", "Fail if fewer messages per second were handled.", "hz", "0");
+    parser.addOptions({ hostOpt, portOpt, nsOpt, durationOpt, warmupOpt, mainWindowOpt, tabOpt, minRateOpt });
+    parser.process(app);
+
+    const QString host = parser.value(hostOpt);
+    const quint16 port = parser.value(portOpt).toUShort();
+    const QString ns = parser.value(nsOpt);
+
+    RosBridgeClient *client = nullptr;
+    MainWindow *window = nullptr;
+
+    if (parser.isSet(mainWindowOpt))
+    {
+        window = new MainWindow();
+        window->show();
+        window->createCommunicationClient(ns, host, port);
+        client = window->communicationClient();
+
+        if (QTabWidget *tabs = window->findChild<QTabWidget*>("tabWidget"))
+        {
+            tabs->setCurrentIndex(parser.value(tabOpt).toInt());
+        }
+    }
+    else
+    {
+        client = new RosBridgeClient(ns, host, port, &app);
+        client->subscribeTopic("/odom", "nav_msgs/msg/Odometry");
+        client->subscribeTopic("/diff_controller/odom", "nav_msgs/msg/Odometry");
+        client->subscribeTopic("/imu/out", "sensor_msgs/msg/Imu");
+        client->subscribeTopic("/joint_states", "sensor_msgs/msg/JointState");
+        client->subscribeTopic("/diff_controller/cmd_vel_unstamped", "geometry_msgs/msg/Twist");
+    }
+
+    bool measuring = false;
+    quint64 messages = 0;
+    QHash<QString, quint64> perTopic;
+    QObject::connect(client, &RosBridgeClient::receivedTopicMessage, &app, [&](const QString &topic, const QJsonObject &) {
+        if (!measuring) return;
+        ++messages;
+        ++perTopic[topic];
+    });
+
+    // event loop responsiveness : how late a 10 ms timer fires
+    LatencyHistogram loopLag;
+    QElapsedTimer lagClock;
+    QTimer lagTimer;
+    lagTimer.setTimerType(Qt::PreciseTimer);
+    lagTimer.setInterval(10);
+    QObject::connect(&lagTimer, &QTimer::timeout, &app, [&]() {
+        if (measuring && lagClock.isValid())
+        {
+            loopLag.add(qMax<qint64>(0, lagClock.nsecsElapsed() / 1000 - 10000));
+        }
+        lagClock.restart();
+    });
+    lagTimer.start();
+
+    QElapsedTimer wall;
+    const int warmup_ms = parser.value(warmupOpt).toInt() * 1000;
+    const int duration_ms = parser.value(durationOpt).toInt() * 1000;
+
+    QTimer::singleShot(warmup_ms, &app, [&]() {
+        measuring = true;
+        client->latencyTracer()->reset();
+        wall.start();
+    });
+
+    int exit_code = 0;
+    QTimer::singleShot(warmup_ms + duration_ms, &app, [&]() {
+        measuring = false;
+        const double seconds = wall.nsecsElapsed() / 1e9;
+        const double rate = seconds > 0 ? messages / seconds : 0.0;
+
+        QJsonObject topics;
+        for (auto it = perTopic.constBegin(); it != perTopic.constEnd(); ++it)
+        {
+            topics[it.key()] = static_cast<double>(it.value()) / seconds;
+        }
+
+        // worst topic p99 per stage
+        QJsonObject stages;
+        const LatencyTracer *tracer = client->latencyTracer();
+        for (int stage = 0; stage < LatencyTracer::StageCount; ++stage)
+        {
+            qint64 worst = -1;
+            for (const LatencyTracer::TopicLatency &t : tracer->topics())
+            {
+                worst = qMax(worst, t.stages[stage].percentile(0.99));
+            }
+            stages[LatencyTracer::stageName(stage) + "_p99_us"] = static_cast<double>(worst);
+        }
+
+        QJsonObject summary;
+        summary["mode"] = window ? "mainwindow" : "client";
+        summary["seconds"] = seconds;
+        summary["messages"] = static_cast<double>(messages);
+        summary["rate_hz"] = rate;
+        summary["topics_hz"] = topics;
+        summary["latency"] = stages;
+        summary["loop_lag_p50_us"] = static_cast<double>(loopLag.percentile(0.50));
+        summary["loop_lag_p99_us"] = static_cast<double>(loopLag.percentile(0.99));
+
+        QTextStream(stdout) << QJsonDocument(summary).toJson(QJsonDocument::Compact) << Qt::endl;
+
+        const double min_rate = parser.value(minRateOpt).toDouble();
+        exit_code = (min_rate > 0 && rate < min_rate) ? 1 : 0;
+        app.exit(exit_code);
+    });
+
+    const int result = app.exec();
+    delete window;
+    return result;
+}